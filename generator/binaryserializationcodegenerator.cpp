@@ -11,7 +11,14 @@
 
 #include <llvm/ADT/APInt.h>
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 using namespace std;
 using namespace CppUtilities;
@@ -99,16 +106,45 @@ bool RetrieveIntegerLiteralFromDeclaratorDecl::VisitStmt(clang::Stmt *st)
     return false;
 }
 
+/// \brief The FingerprintBuilder struct computes the FNV-1a hash of the structure of a class for BinarySchemaFingerprint.
+struct FingerprintBuilder {
+    void add(const std::string &part);
+    std::uint64_t value() const;
+
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+};
+
+/// \brief Adds the specified \a part followed by a separator to the hash.
+void FingerprintBuilder::add(const std::string &part)
+{
+    for (const auto c : part) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    hash = (hash ^ 0xFFu) * 0x100000001b3ull;
+}
+
+/// \brief Returns the hash (which is never 0 as 0 denotes the absence of a fingerprint).
+std::uint64_t FingerprintBuilder::value() const
+{
+    return hash ? hash : 1;
+}
+
 /// \brief The MemberTracking struct is an internal helper for BinarySerializationCodeGenerator::generate().
 struct MemberTracking {
-    bool membersWritten = false, withinCondition = false;
-    BinaryVersion asOfVersion = BinaryVersion(), lastAsOfVersion = BinaryVersion();
-    BinaryVersion untilVersion = BinaryVersion(), lastUntilVersion = BinaryVersion();
+    /// \brief The Member struct holds a member along with the range of versions it is present in.
+    struct Member {
+        const clang::FieldDecl *field;
+        std::size_t index;
+        BinaryVersion asOfVersion, untilVersion;
+    };
+
+    BinaryVersion asOfVersion = BinaryVersion();
+    BinaryVersion untilVersion = BinaryVersion();
+    std::vector<Member> members;
 
     bool checkForVersionMarker(clang::Decl *decl);
-    void concludeCondition(std::ostream &os);
-    void writeVersionCondition(std::ostream &os);
-    void writeExtraPadding(std::ostream &os);
+    void addMember(const clang::FieldDecl *field);
+    template <typename WriteMember> void writeMembers(std::ostream &os, WriteMember &&writeMember) const;
 };
 
 /*!
@@ -144,53 +180,233 @@ bool MemberTracking::checkForVersionMarker(clang::Decl *decl)
 }
 
 /*!
- * \brief Concludes an unfinished version condition if-block.
+ * \brief Adds the specified \a field within the versions determined by the preceding version markers.
  */
-void MemberTracking::concludeCondition(std::ostream &os)
+void MemberTracking::addMember(const clang::FieldDecl *field)
 {
-    if (withinCondition) {
-        os << "    }\n";
+    members.emplace_back(Member{ field, members.size(), asOfVersion, untilVersion });
+}
+
+/*!
+ * \brief Writes code for the added members invoking \a writeMember for each member.
+ * \remarks The versions are split into ranges within which the same members are present. One straight-line sequence of
+ *          members is written for each range so the version is only compared once per object (and not once per group of
+ *          members with the same version markers).
+ */
+template <typename WriteMember> void MemberTracking::writeMembers(std::ostream &os, WriteMember &&writeMember) const
+{
+    // determine the versions where the set of present members changes
+    auto boundaries = std::vector<BinaryVersion>{ 0 };
+    for (const auto &member : members) {
+        if (member.asOfVersion) {
+            boundaries.emplace_back(member.asOfVersion);
+        }
+        if (member.untilVersion && member.untilVersion < std::numeric_limits<BinaryVersion>::max()) {
+            boundaries.emplace_back(member.untilVersion + 1);
+        }
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+    // determine the present members for each range of versions, merging adjacent ranges with the same members
+    auto ranges = std::vector<std::pair<BinaryVersion, std::vector<const Member *>>>();
+    for (const auto firstVersion : boundaries) {
+        auto presentMembers = std::vector<const Member *>();
+        for (const auto &member : members) {
+            if ((!member.asOfVersion || member.asOfVersion <= firstVersion) && (!member.untilVersion || member.untilVersion >= firstVersion)) {
+                presentMembers.emplace_back(&member);
+            }
+        }
+        if (ranges.empty() || ranges.back().second != presentMembers) {
+            ranges.emplace_back(firstVersion, std::move(presentMembers));
+        }
+    }
+
+    // write members without condition if they are present in all versions; otherwise dispatch once on the version
+    if (ranges.size() == 1) {
+        for (const Member *const member : ranges.front().second) {
+            os << "    ";
+            writeMember(*member);
+        }
+        return;
+    }
+    for (auto range = ranges.cbegin(), end = ranges.cend(); range != end; ++range) {
+        const auto next = range + 1;
+        if (range != ranges.cbegin()) {
+            os << "    } else ";
+        } else {
+            os << "    ";
+        }
+        if (next != end) {
+            os << "if (version < " << next->first << ") ";
+        }
+        os << "{\n";
+        for (const Member *const member : range->second) {
+            os << "        ";
+            writeMember(*member);
+        }
     }
+    os << "    }\n";
 }
 
 /*!
- * \brief Starts a new version condition if-block if versioning parameters have changed.
+ * \brief Invokes \a callback for the class \a type refers to and for the classes used as template arguments (recursively).
+ * \remarks Covers the element types of containers, optionals, pointers, pairs and variants.
  */
-void MemberTracking::writeVersionCondition(std::ostream &os)
+template <typename Callback> static void forEachClassWithin(clang::QualType type, Callback &&callback)
 {
-    if (asOfVersion == lastAsOfVersion && untilVersion == lastUntilVersion) {
+    const auto *const record = type.getCanonicalType()->getAsCXXRecordDecl();
+    if (!record) {
+        return;
+    }
+    callback(record);
+    if (record->getKind() != clang::Decl::Kind::ClassTemplateSpecialization) {
         return;
     }
-    concludeCondition(os);
-    lastAsOfVersion = asOfVersion;
-    lastUntilVersion = untilVersion;
-    if ((withinCondition = asOfVersion || untilVersion)) {
-        os << "    if (";
-        if (asOfVersion) {
-            os << "version >= " << asOfVersion;
-            if (untilVersion) {
-                os << " && ";
+    for (const auto &argument : static_cast<const clang::ClassTemplateSpecializationDecl *>(record)->getTemplateArgs().asArray()) {
+        if (argument.getKind() == clang::TemplateArgument::Type) {
+            forEachClassWithin(argument.getAsType(), callback);
+        } else if (argument.getKind() == clang::TemplateArgument::Pack) {
+            for (const auto &packedArgument : argument.pack_elements()) {
+                if (packedArgument.getKind() == clang::TemplateArgument::Type) {
+                    forEachClassWithin(packedArgument.getAsType(), callback);
+                }
             }
         }
-        if (untilVersion) {
-            os << "version <= " << untilVersion;
+    }
+}
+
+/*!
+ * \brief Returns whether \a record has std::string_view members or bases/members of the specified \a borrowingClasses.
+ * \remarks Members within containers, optionals, pointers and so on are considered as well.
+ */
+static bool borrowsStrings(const clang::CXXRecordDecl *record, const std::unordered_set<const clang::CXXRecordDecl *> &borrowingClasses)
+{
+    auto borrows = false;
+    const auto checkClass = [&](const clang::CXXRecordDecl *usedRecord) {
+        borrows = borrows || borrowingClasses.count(usedRecord->getCanonicalDecl())
+            || (usedRecord->isInStdNamespace() && usedRecord->getName() == "basic_string_view");
+    };
+    for (const clang::CXXBaseSpecifier &base : record->bases()) {
+        forEachClassWithin(base.getType(), checkClass);
+    }
+    for (const clang::FieldDecl *const field : record->fields()) {
+        if (!field->getType().isConstant(field->getASTContext())) {
+            forEachClassWithin(field->getType(), checkClass);
         }
-        os << ") {\n";
     }
+    return borrows;
 }
 
 /*!
- * \brief Writes extra padding (if within a version condition).
+ * \brief The SchemaFingerprints class computes the fingerprints for the BinarySchemaFingerprint specializations.
+ * \remarks The fingerprints of custom types used as base classes or members (also within containers, optionals, pointers and
+ *          so on) are folded into the fingerprint of a class. They are computed from the AST so the same value results if that
+ *          type is relevant in the current file or only included. A type which is currently being computed (recursive data
+ *          structure) contributes only its name.
  */
-void MemberTracking::writeExtraPadding(std::ostream &os)
+template <typename RelevantBaseOf> class SchemaFingerprints {
+public:
+    explicit SchemaFingerprints(RelevantBaseOf &&relevantBaseOf);
+    std::uint64_t of(const clang::CXXRecordDecl *record);
+
+private:
+    std::uint64_t compute(const clang::CXXRecordDecl *record, bool &isComplete);
+
+    RelevantBaseOf m_relevantBaseOf;
+    std::unordered_map<const clang::CXXRecordDecl *, std::uint64_t> m_fingerprints;
+    std::unordered_set<const clang::CXXRecordDecl *> m_inProgress;
+};
+
+/// \brief Constructs the fingerprints using \a relevantBaseOf to determine the name of the relevant base of a class.
+template <typename RelevantBaseOf>
+SchemaFingerprints<RelevantBaseOf>::SchemaFingerprints(RelevantBaseOf &&relevantBaseOf)
+    : m_relevantBaseOf(std::move(relevantBaseOf))
 {
-    if (withinCondition) {
-        os << "    ";
+}
+
+/// \brief Returns the fingerprint of \a record.
+template <typename RelevantBaseOf> std::uint64_t SchemaFingerprints<RelevantBaseOf>::of(const clang::CXXRecordDecl *record)
+{
+    auto isComplete = true;
+    return compute(record, isComplete);
+}
+
+/*!
+ * \brief Computes the fingerprint of \a record from its version, name, base classes and non-const members.
+ * \remarks Sets \a isComplete to false if a type which is currently being computed has been encountered. The fingerprint is only
+ *          cached otherwise because it depends on where the computation started.
+ */
+template <typename RelevantBaseOf>
+std::uint64_t SchemaFingerprints<RelevantBaseOf>::compute(const clang::CXXRecordDecl *record, bool &isComplete)
+{
+    const auto *const canonicalRecord = record->getCanonicalDecl();
+    if (const auto cached = m_fingerprints.find(canonicalRecord); cached != m_fingerprints.end()) {
+        return cached->second;
+    }
+    auto *const definition = record->getDefinition();
+    auto fingerprint = FingerprintBuilder();
+    if (!definition) {
+        fingerprint.add(record->getQualifiedNameAsString());
+        return fingerprint.value();
+    }
+    if (!m_inProgress.emplace(canonicalRecord).second) {
+        isComplete = false;
+        fingerprint.add(record->getQualifiedNameAsString());
+        return fingerprint.value();
+    }
+
+    // add version and name of the class itself
+    auto isCompleteWithNested = true;
+    const auto relevantBase = m_relevantBaseOf(definition);
+    fingerprint.add(relevantBase.empty() ? "void" : relevantBase);
+    fingerprint.add(definition->getQualifiedNameAsString());
+
+    // add the fingerprints of custom types used by base classes and members
+    // note: Standard library types contribute only via the type name of the base class/member (which covers template arguments).
+    const auto addUsedClass = [&](const clang::CXXRecordDecl *usedRecord) {
+        if (!usedRecord->isInStdNamespace()) {
+            fingerprint.add(std::to_string(compute(usedRecord, isCompleteWithNested)));
+        }
+    };
+    for (const clang::CXXBaseSpecifier &base : definition->bases()) {
+        fingerprint.add(base.getType().getCanonicalType().getAsString());
+        if (const auto *const baseRecord = base.getType()->getAsCXXRecordDecl()) {
+            addUsedClass(baseRecord);
+        }
     }
+
+    // add members
+    // note: All non-const members are considered (regardless of their accessibility) as they determine the layout.
+    auto tracking = MemberTracking();
+    for (clang::Decl *const decl : definition->decls()) {
+        if (tracking.checkForVersionMarker(decl) || decl->getKind() != clang::Decl::Kind::Field) {
+            continue;
+        }
+        const auto *const field = static_cast<const clang::FieldDecl *>(decl);
+        if (field->getType().isConstant(field->getASTContext())) {
+            continue;
+        }
+        fingerprint.add(field->getName().str());
+        fingerprint.add(field->getType().getCanonicalType().getAsString());
+        fingerprint.add(std::to_string(tracking.asOfVersion));
+        fingerprint.add(std::to_string(tracking.untilVersion));
+        forEachClassWithin(field->getType(), addUsedClass);
+    }
+
+    m_inProgress.erase(canonicalRecord);
+    if (isCompleteWithNested) {
+        m_fingerprints.emplace(canonicalRecord, fingerprint.value());
+    } else {
+        isComplete = false;
+    }
+    return fingerprint.value();
 }
 
 /*!
- * \brief Generates pull() and push() helper functions in the ReflectiveRapidJSON::BinaryReflector namespace for the relevant classes.
+ * \brief Generates readCustomType(), writeCustomType() and measureCustomType() helper functions as well as BinaryFixedSize
+ *        and BinarySchemaFingerprint specializations in the ReflectiveRapidJSON::BinaryReflector namespace for the relevant
+ *        classes.
  */
 void BinarySerializationCodeGenerator::generate(std::ostream &os) const
 {
@@ -207,6 +423,23 @@ void BinarySerializationCodeGenerator::generate(std::ostream &os) const
     os << "namespace ReflectiveRapidJSON {\n"
           "namespace BinaryReflector {\n\n";
 
+    // determine classes which can only be read via BinaryBufferDeserializer because they contain std::string_view members
+    // note: Classes containing such classes (also as base or within containers and so on) are affected as well.
+    auto borrowingClasses = std::unordered_set<const clang::CXXRecordDecl *>();
+    for (auto changed = true; changed;) {
+        changed = false;
+        for (const RelevantClass &relevantClass : relevantClasses) {
+            const auto *const record = relevantClass.record->getCanonicalDecl();
+            if (!borrowingClasses.count(record) && borrowsStrings(relevantClass.record, borrowingClasses)) {
+                borrowingClasses.emplace(record);
+                changed = true;
+            }
+        }
+    }
+
+    // prepare computing the fingerprints of the structure of the classes
+    auto fingerprints = SchemaFingerprints([this](clang::CXXRecordDecl *record) { return qualifiedNameOfRelevantBase(record); });
+
     // determine visibility attribute
     const char *visibility = m_options.visibilityArg.firstValue();
     if (!visibility) {
@@ -244,117 +477,232 @@ void BinarySerializationCodeGenerator::generate(std::ostream &os) const
         // print comment
         os << "// define code for (de)serializing " << relevantClass.qualifiedName << " objects\n";
 
-        // print writeCustomType method
-        os << "template <> " << visibility << " void writeCustomType<::" << relevantClass.qualifiedName
-           << ">(BinarySerializer &serializer, const ::" << relevantClass.qualifiedName << " &customObject, BinaryVersion version)\n{\n";
-        os << "    // write base classes\n";
+        // print writeCustomType method and measureCustomType method which mirrors it to determine the size
+        // note: Members are collected to determine whether the class has a fixed size.
+        auto hasFixedSize = !writePrivateMembers;
+        auto fixedSizeTypes = std::string();
         for (const RelevantClass *baseClass : relevantBases) {
-            os << "    serializer.write(static_cast<const ::" << baseClass->qualifiedName << " &>(customObject), version);\n";
-        }
-        if (!relevantClass.relevantBase.empty()) {
-            os << "    // write version\n"
-                  "    using V = Versioning<"
-               << relevantClass.relevantBase
-               << ">;\n"
-                  "    if constexpr (V::enabled) {\n"
-                  "        serializer.writeVariableLengthUIntBE(V::applyDefault(version));\n"
-                  "    }\n";
+            fixedSizeTypes += ", ::" + baseClass->qualifiedName;
         }
-        os << "    // write members\n";
-        auto mt = MemberTracking();
-        for (clang::Decl *const decl : relevantClass.record->decls()) {
-            // check static member variables for version markers
-            if (mt.checkForVersionMarker(decl)) {
-                continue;
+        const auto printWriteFunction = [&](const char *functionName, const char *writerType, const char *writer, bool collectMembers) {
+            os << "template <> " << visibility << " void " << functionName << "<::" << relevantClass.qualifiedName << ">(" << writerType << " &"
+               << writer << ", const ::" << relevantClass.qualifiedName << " &customObject, BinaryVersion version)\n{\n";
+            os << "    // write base classes\n";
+            for (const RelevantClass *baseClass : relevantBases) {
+                os << "    " << writer << ".write(static_cast<const ::" << baseClass->qualifiedName << " &>(customObject), version);\n";
             }
-
-            // skip all further declarations but fields
-            if (decl->getKind() != clang::Decl::Kind::Field) {
-                continue;
+            if (!relevantClass.relevantBase.empty()) {
+                os << "    // write version\n"
+                      "    using V = Versioning<"
+                   << relevantClass.relevantBase
+                   << ">;\n"
+                      "    constexpr auto skippable = V::enabled && SkippableBinaryRecord<::"
+                   << relevantClass.qualifiedName
+                   << ">::value;\n"
+                      "    if constexpr (V::enabled) {\n"
+                      "        "
+                   << writer
+                   << ".writeVersion<V>(version);\n"
+                      "    }\n"
+                      "    // begin length-prefixed record if skippable\n"
+                      "    const auto record = "
+                   << writer << ".beginRecord(skippable);\n";
             }
+            os << "    // write members\n";
+            auto mt = MemberTracking();
+            for (clang::Decl *const decl : relevantClass.record->decls()) {
+                // check static member variables for version markers
+                if (mt.checkForVersionMarker(decl)) {
+                    continue;
+                }
 
-            // skip const members
-            const auto *const field = static_cast<const clang::FieldDecl *>(decl);
-            if (field->getType().isConstant(field->getASTContext())) {
-                continue;
-            }
+                // skip all further declarations but fields
+                if (decl->getKind() != clang::Decl::Kind::Field) {
+                    continue;
+                }
 
-            // skip private members conditionally
-            if (!writePrivateMembers && field->getAccess() != clang::AS_public) {
-                continue;
-            }
+                // skip const members
+                const auto *const field = static_cast<const clang::FieldDecl *>(decl);
+                if (field->getType().isConstant(field->getASTContext())) {
+                    continue;
+                }
+
+                // skip private members conditionally
+                if (!writePrivateMembers && field->getAccess() != clang::AS_public) {
+                    continue;
+                }
 
-            // write version markers
-            mt.writeVersionCondition(os);
-            mt.writeExtraPadding(os);
+                mt.addMember(field);
+                if (!collectMembers) {
+                    continue;
+                }
+                if (mt.asOfVersion || mt.untilVersion) {
+                    hasFixedSize = false;
+                } else {
+                    fixedSizeTypes += ", decltype(::" + relevantClass.qualifiedName + "::" + field->getName().str() + ')';
+                }
+            }
 
             // write actual code for serialization
-            os << "    serializer.write(customObject." << field->getName() << ", version);\n";
-            mt.membersWritten = true;
+            mt.writeMembers(os, [&](const MemberTracking::Member &member) {
+                os << writer << ".write(customObject." << member.field->getName() << ", version);\n";
+            });
+            if (!relevantClass.relevantBase.empty()) {
+                os << "    " << writer << ".endRecord(record);\n";
+            }
+            if (relevantBases.empty() && mt.members.empty()) {
+                os << "    (void)" << writer << ";\n    (void)customObject;\n    \n(void)version;";
+            }
+            os << "}\n";
+        };
+        printWriteFunction("writeCustomType", "BinarySerializer", "serializer", true);
+        // note: Private members are only accessible from the stream-based writeCustomType() (via friend declaration) so the default
+        //       measureCustomType() and buffer-based writeCustomType() which invoke it are used in this case.
+        if (!writePrivateMembers) {
+            printWriteFunction("measureCustomType", "BinarySizeCalculator", "calculator", false);
+            printWriteFunction("writeCustomType", "BinaryBufferSerializer", "serializer", false);
         }
-        mt.concludeCondition(os);
-        if (relevantBases.empty() && !mt.membersWritten) {
-            os << "    (void)serializer;\n    (void)customObject;\n    \n(void)version;";
+
+        // print BinaryFixedSize specialization if the class might have a fixed size (which is finally determined at compile-time)
+        // note: Classes with private members are skipped because the types of private members are not accessible from the specialization.
+        if (hasFixedSize) {
+            os << "template <> struct BinaryFixedSize<::" << relevantClass.qualifiedName << "> : public BinaryFixedSizeOfCustomType<Versioning<"
+               << (relevantClass.relevantBase.empty() ? "void" : relevantClass.relevantBase) << ">" << fixedSizeTypes << "> {};\n";
         }
-        os << "}\n";
+
+        // print BinarySchemaFingerprint specialization computed from the structure of the class
+        os << "template <> struct BinarySchemaFingerprint<::" << relevantClass.qualifiedName
+           << "> : public std::integral_constant<std::uint64_t, " << fingerprints.of(relevantClass.record) << "ull> {};\n";
 
         // skip printing the readCustomType method for classes without default constructor because deserializing those is currently not supported
         if (!relevantClass.record->hasDefaultConstructor()) {
             continue;
         }
 
-        // print readCustomType method
-        mt = MemberTracking();
-        os << "template <> " << visibility << " BinaryVersion readCustomType<::" << relevantClass.qualifiedName
-           << ">(BinaryDeserializer &deserializer, ::" << relevantClass.qualifiedName << " &customObject, BinaryVersion version)\n{\n";
-        os << "    // read base classes\n";
-        for (const RelevantClass *baseClass : relevantBases) {
-            os << "    deserializer.read(static_cast<::" << baseClass->qualifiedName << " &>(customObject), version);\n";
-        }
-        if (!relevantClass.relevantBase.empty()) {
-            os << "    // read version\n"
-                  "    using V = Versioning<"
-               << relevantClass.relevantBase
-               << ">;\n"
-                  "    if constexpr (V::enabled) {\n"
-                  "        V::assertVersion(version = deserializer.readVariableLengthUIntBE(), \""
-               << relevantClass.qualifiedName
-               << "\");\n"
-                  "    }\n";
-        }
-        os << "    // read members\n";
-        for (clang::Decl *const decl : relevantClass.record->decls()) {
-            // check static member variables for version markers
-            if (mt.checkForVersionMarker(decl)) {
-                continue;
+        // print readCustomType method for BinaryDeserializer and BinaryBufferDeserializer
+        // note: The projected variant reads only the members selected via the mask and skips all other members. The first 64 members
+        //       are selectable; the BinaryFields specialization provides the bits. Without any members selected, base classes are
+        //       skipped as well and skippable records are skipped as a whole via their length.
+        const auto printReadFunction = [&](const char *deserializerType, bool projected) {
+            auto mt = MemberTracking();
+            os << "template <> " << visibility << " BinaryVersion " << (projected ? "readCustomTypeProjected" : "readCustomType") << "<::"
+               << relevantClass.qualifiedName << ">(" << deserializerType << " &deserializer, ::" << relevantClass.qualifiedName
+               << (projected ? " &customObject, BinaryFieldMask fields, BinaryVersion version)\n{\n" : " &customObject, BinaryVersion version)\n{\n");
+            os << "    // read base classes\n";
+            for (const RelevantClass *baseClass : relevantBases) {
+                if (projected) {
+                    os << "    deserializer.readOrSkip(static_cast<::" << baseClass->qualifiedName << " &>(customObject), fields, version);\n";
+                } else {
+                    os << "    deserializer.read(static_cast<::" << baseClass->qualifiedName << " &>(customObject), version);\n";
+                }
             }
-
-            // skip all further declarations but fields
-            if (decl->getKind() != clang::Decl::Kind::Field) {
-                continue;
+            if (!relevantClass.relevantBase.empty()) {
+                os << "    // read version\n"
+                      "    using V = Versioning<"
+                   << relevantClass.relevantBase
+                   << ">;\n"
+                      "    constexpr auto skippable = V::enabled && SkippableBinaryRecord<::"
+                   << relevantClass.qualifiedName
+                   << ">::value;\n"
+                      "    if constexpr (V::enabled) {\n"
+                      "        if (deserializer.readVersion(version) && !skippable) {\n"
+                      "            V::assertVersion(version, \""
+                   << relevantClass.qualifiedName
+                   << "\");\n"
+                      "        }\n"
+                      "    }\n"
+                      "    // begin length-prefixed record if skippable (members unknown to this version are skipped when ending it)\n"
+                      "    const auto record = deserializer.beginRecord(skippable);\n";
+                if (projected) {
+                    os << "    // skip record as a whole via its length if no members are selected\n"
+                          "    if (skippable && !fields) {\n"
+                          "        deserializer.endRecord(record);\n"
+                          "        return version;\n"
+                          "    }\n";
+                }
             }
+            os << "    // read members\n";
+            for (clang::Decl *const decl : relevantClass.record->decls()) {
+                // check static member variables for version markers
+                if (mt.checkForVersionMarker(decl)) {
+                    continue;
+                }
 
-            // skip const members
-            const auto *const field = static_cast<const clang::FieldDecl *>(decl);
-            if (field->getType().isConstant(field->getASTContext())) {
-                continue;
-            }
+                // skip all further declarations but fields
+                if (decl->getKind() != clang::Decl::Kind::Field) {
+                    continue;
+                }
+
+                // skip const members
+                const auto *const field = static_cast<const clang::FieldDecl *>(decl);
+                if (field->getType().isConstant(field->getASTContext())) {
+                    continue;
+                }
 
-            // write version markers
-            mt.writeVersionCondition(os);
-            mt.writeExtraPadding(os);
+                // skip private members conditionally
+                if (!readPrivateMembers && field->getAccess() != clang::AS_public) {
+                    continue;
+                }
+
+                mt.addMember(field);
+            }
 
-            if (readPrivateMembers || field->getAccess() == clang::AS_public) {
-                os << "    deserializer.read(customObject." << field->getName() << ", version);\n";
-                mt.membersWritten = true;
+            // write actual code for deserialization
+            mt.writeMembers(os, [&](const MemberTracking::Member &member) {
+                if (projected && member.index < 64) {
+                    os << "deserializer.readOrSkip(customObject." << member.field->getName() << ", fields & BinaryFields<::"
+                       << relevantClass.qualifiedName << ">::" << member.field->getName() << ", version);\n";
+                } else {
+                    os << "deserializer.read(customObject." << member.field->getName() << ", version);\n";
+                }
+            });
+            if (!relevantClass.relevantBase.empty()) {
+                os << "    deserializer.endRecord(record);\n";
+            }
+            if (relevantBases.empty() && mt.members.empty()) {
+                os << "    (void)deserializer;\n    (void)customObject;\n";
+            }
+            if (projected && relevantBases.empty() && relevantClass.relevantBase.empty() && mt.members.empty()) {
+                os << "    (void)fields;\n";
+            }
+            os << "    return version;\n";
+            os << "}\n";
+        };
+        // print BinaryFields specialization providing the bits to select members for readCustomTypeProjected()
+        const auto printFieldsStruct = [&] {
+            auto memberIndex = std::size_t();
+            os << "template <> struct BinaryFields<::" << relevantClass.qualifiedName << "> {\n";
+            for (clang::Decl *const decl : relevantClass.record->decls()) {
+                if (decl->getKind() != clang::Decl::Kind::Field) {
+                    continue;
+                }
+                const auto *const field = static_cast<const clang::FieldDecl *>(decl);
+                if (field->getType().isConstant(field->getASTContext()) || field->getAccess() != clang::AS_public) {
+                    continue;
+                }
+                if (memberIndex == 64) {
+                    break;
+                }
+                os << "    static constexpr BinaryFieldMask " << field->getName() << " = BinaryFieldMask(1) << " << memberIndex++ << ";\n";
             }
+            os << "};\n";
+        };
+
+        // print deleted readCustomType method for BinaryDeserializer if borrowed strings are not supported by it
+        if (borrowingClasses.count(relevantClass.record->getCanonicalDecl())) {
+            os << "template <> BinaryVersion readCustomType<::" << relevantClass.qualifiedName << ">(BinaryDeserializer &, ::"
+               << relevantClass.qualifiedName << " &, BinaryVersion) = delete;\n";
+        } else {
+            printReadFunction("BinaryDeserializer", false);
         }
-        mt.concludeCondition(os);
-        if (relevantBases.empty() && !mt.membersWritten) {
-            os << "    (void)deserializer;\n    (void)customObject;\n";
+        // note: Private members are only accessible from the stream-based readCustomType() (via friend declaration) so the default
+        //       buffer-based readCustomType() which invokes it is used in this case.
+        if (!readPrivateMembers) {
+            printReadFunction("BinaryBufferDeserializer", false);
+            printFieldsStruct();
+            printReadFunction("BinaryBufferDeserializer", true);
         }
-        os << "    return version;\n";
-        os << "}\n\n";
+        os << '\n';
     }
 
     // close namespace ReflectiveRapidJSON::BinaryReflector
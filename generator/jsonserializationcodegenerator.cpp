@@ -7,6 +7,8 @@
 #include <clang/AST/DeclTemplate.h>
 
 #include <iostream>
+#include <map>
+#include <string_view>
 
 using namespace std;
 using namespace CppUtilities;
@@ -57,7 +59,82 @@ void JsonSerializationCodeGenerator::computeRelevantClass(RelevantClass &possibl
 }
 
 /*!
- * \brief Generates pull() and push() helper functions in the ReflectiveRapidJSON::JsonReflector namespace for the relevant classes.
+ * \brief Determines whether private members of \a record should be pushed/pulled as well by checking whether friend declarations
+ *        for push/pull are present.
+ * \remarks The friend declarations we are looking for are expanded from the REFLECTIVE_RAPIDJSON_ENABLE_PRIVATE_MEMBERS macro.
+ */
+JsonSerializationCodeGenerator::PrivateMemberAccess JsonSerializationCodeGenerator::determinePrivateMemberAccess(const clang::CXXRecordDecl *record)
+{
+    PrivateMemberAccess access;
+    for (const clang::FriendDecl *const friendDecl : record->friends()) {
+        // get the actual declaration which must be a function
+        const clang::NamedDecl *const actualFriendDecl = friendDecl->getFriendDecl();
+        if (!actualFriendDecl || actualFriendDecl->getKind() != clang::Decl::Kind::Function) {
+            continue;
+        }
+        // check whether the friend function matches the push/pull helper function
+        const string friendName(actualFriendDecl->getQualifiedNameAsString());
+        if (friendName == "ReflectiveRapidJSON::JsonReflector::push") {
+            access.push = true;
+        }
+        if (friendName == "ReflectiveRapidJSON::JsonReflector::pull") {
+            access.pull = true;
+        }
+        if (access.push && access.pull) {
+            break;
+        }
+    }
+    return access;
+}
+
+/*!
+ * \brief Returns the contents of a C++ string literal for the specified \a name quoted and escaped as JSON string.
+ * \remarks Escapes like RapidJSON's writer so the result can be written verbatim instead of writing the name as key.
+ */
+static std::string quotedJsonKeyLiteral(std::string_view name)
+{
+    static constexpr char hexDigits[] = "0123456789ABCDEF";
+    auto literal = std::string("\\\"");
+    for (const char c : name) {
+        switch (c) {
+        case '"':
+            literal += "\\\\\\\"";
+            break;
+        case '\\':
+            literal += "\\\\\\\\";
+            break;
+        case '\b':
+            literal += "\\\\b";
+            break;
+        case '\f':
+            literal += "\\\\f";
+            break;
+        case '\n':
+            literal += "\\\\n";
+            break;
+        case '\r':
+            literal += "\\\\r";
+            break;
+        case '\t':
+            literal += "\\\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                literal += "\\\\u00";
+                literal += hexDigits[static_cast<unsigned char>(c) >> 4];
+                literal += hexDigits[static_cast<unsigned char>(c) & 0xF];
+            } else {
+                literal += c;
+            }
+        }
+    }
+    literal += "\\\"";
+    return literal;
+}
+
+/*!
+ * \brief Generates JsonMemberKeys, pull(), push(), CustomTypeWriter::writeMembers() and CustomTypeReader::readMember() helper functions as
+ *        well as HasCustomTypeWriter specializations in the ReflectiveRapidJSON::JsonReflector namespace for the relevant classes.
  */
 void JsonSerializationCodeGenerator::generate(ostream &os) const
 {
@@ -80,30 +157,42 @@ void JsonSerializationCodeGenerator::generate(ostream &os) const
         visibility = "";
     }
 
+    // define tables of precomputed keys used by the functions below so keys are neither measured nor escaped at runtime
+    for (const RelevantClass &relevantClass : relevantClasses) {
+        os << "template <> struct JsonMemberKeys<::" << relevantClass.qualifiedName << "> {\n";
+        for (const clang::FieldDecl *field : relevantClass.record->fields()) {
+            os << "    static constexpr ::ReflectiveRapidJSON::JsonMemberKey " << field->getName() << "{ \"" << field->getName() << "\", \""
+               << quotedJsonKeyLiteral(field->getName().str()) << "\" };\n";
+        }
+        os << "};\n";
+    }
+    os << '\n';
+
+    // declare CustomTypeReader specializations upfront so they are known before any readMember() function refers to them
+    // note: Classes without default constructor are skipped because deserializing those is currently not supported.
+    for (const RelevantClass &relevantClass : relevantClasses) {
+        if (!relevantClass.record->hasDefaultConstructor()) {
+            continue;
+        }
+        os << "template <> struct CustomTypeReader<::" << relevantClass.qualifiedName
+           << "> {\n"
+              "    static constexpr bool isSupported = true;\n"
+              "    static constexpr const char *record = \""
+           << relevantClass.qualifiedName
+           << "\";\n"
+              "    static bool readMember(::"
+           << relevantClass.qualifiedName
+           << " &reflectable, const char *name, ::RAPIDJSON_NAMESPACE::SizeType nameLength, JsonReaderSlot &slot);\n"
+              "};\n";
+    }
+    os << '\n';
+
     // add push and pull functions for each class, for an example of the resulting
     // output, see ../lib/tests/jsonserializable.cpp (code under comment "pretend serialization code...")
     for (const RelevantClass &relevantClass : relevantClasses) {
-        // determine whether private members should be pushed/pulled as well: check whether friend declarations for push/pull present
-        // note: the friend declarations we are looking for are expanded from the REFLECTIVE_RAPIDJSON_ENABLE_PRIVATE_MEMBERS macro
-        bool pushPrivateMembers = false, pullPrivateMembers = false;
-        for (const clang::FriendDecl *const friendDecl : relevantClass.record->friends()) {
-            // get the actual declaration which must be a function
-            const clang::NamedDecl *const actualFriendDecl = friendDecl->getFriendDecl();
-            if (!actualFriendDecl || actualFriendDecl->getKind() != clang::Decl::Kind::Function) {
-                continue;
-            }
-            // check whether the friend function matches the push/pull helper function
-            const string friendName(actualFriendDecl->getQualifiedNameAsString());
-            if (friendName == "ReflectiveRapidJSON::JsonReflector::push") {
-                pushPrivateMembers = true;
-            }
-            if (friendName == "ReflectiveRapidJSON::JsonReflector::pull") {
-                pullPrivateMembers = true;
-            }
-            if (pushPrivateMembers && pullPrivateMembers) {
-                break;
-            }
-        }
+        // determine whether private members should be pushed/pulled as well
+        const PrivateMemberAccess privateMemberAccess = determinePrivateMemberAccess(relevantClass.record);
+        const bool pushPrivateMembers = privateMemberAccess.push, pullPrivateMembers = privateMemberAccess.pull;
 
         // find relevant base classes
         const vector<const RelevantClass *> relevantBases = findRelevantBaseClasses(relevantClass, relevantClasses);
@@ -111,6 +200,9 @@ void JsonSerializationCodeGenerator::generate(ostream &os) const
         // print comment
         os << "// define code for (de)serializing " << relevantClass.qualifiedName << " objects\n";
 
+        // determine the key table for the members of the current class
+        const std::string keys = "JsonMemberKeys<::" + relevantClass.qualifiedName + ">::";
+
         // print push method
         os << "template <> " << visibility << " void push<::" << relevantClass.qualifiedName << ">(const ::" << relevantClass.qualifiedName
            << " &reflectable, ::RAPIDJSON_NAMESPACE::Value::Object &value, ::RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator)\n{\n"
@@ -122,7 +214,7 @@ void JsonSerializationCodeGenerator::generate(ostream &os) const
         auto pushWritten = false;
         for (const clang::FieldDecl *field : relevantClass.record->fields()) {
             if (pushPrivateMembers || field->getAccess() == clang::AS_public) {
-                os << "    push(reflectable." << field->getName() << ", \"" << field->getName() << "\", value, allocator);\n";
+                os << "    push(reflectable." << field->getName() << ", " << keys << field->getName() << ", value, allocator);\n";
                 pushWritten = true;
             }
         }
@@ -131,18 +223,85 @@ void JsonSerializationCodeGenerator::generate(ostream &os) const
         }
         os << "}\n";
 
+        // print writeMembers method
+        os << "template <> struct HasCustomTypeWriter<::" << relevantClass.qualifiedName << "> : public Traits::Bool<true> {};\n";
+        os << "template <> template <typename Handler> ::RAPIDJSON_NAMESPACE::SizeType CustomTypeWriter<::" << relevantClass.qualifiedName
+           << ">::writeMembers(const ::" << relevantClass.qualifiedName
+           << " &reflectable, Handler &handler)\n{\n"
+              "    ::RAPIDJSON_NAMESPACE::SizeType memberCount = 0;\n"
+              "    // write base classes\n";
+        for (const RelevantClass *baseClass : relevantBases) {
+            os << "    memberCount += CustomTypeWriter<::" << baseClass->qualifiedName << ">::writeMembers(static_cast<const ::"
+               << baseClass->qualifiedName << " &>(reflectable), handler);\n";
+        }
+        os << "    // write members\n";
+        std::size_t writtenMembers = 0;
+        for (const clang::FieldDecl *field : relevantClass.record->fields()) {
+            if (pushPrivateMembers || field->getAccess() == clang::AS_public) {
+                os << "    write(reflectable." << field->getName() << ", " << keys << field->getName() << ", handler);\n";
+                ++writtenMembers;
+            }
+        }
+        if (relevantBases.empty() && !writtenMembers) {
+            os << "    (void)reflectable;\n    (void)handler;\n";
+        }
+        if (writtenMembers) {
+            os << "    return memberCount + " << writtenMembers << ";\n";
+        } else {
+            os << "    return memberCount;\n";
+        }
+        os << "}\n";
+
         // skip printing the pull method for classes without default constructor because deserializing those is currently not supported
         if (!relevantClass.record->hasDefaultConstructor()) {
             continue;
         }
 
+        // determine members to be pulled within a single pass over the object
+        // note: Members of base classes are flattened into the same dispatch table unless the base class has private members to be pulled
+        //       because those are only accessible from the pull function of the base class itself.
+        struct PulledMember {
+            std::string name;
+            std::string accessor;
+            std::string key;
+            const std::string *record;
+        };
+        vector<PulledMember> pulledMembers;
+        vector<const RelevantClass *> nonFlattenedBases;
+        const auto addPulledMembers = [&pulledMembers](const RelevantClass &record, const std::string &accessor, bool pullPrivate, bool isBase) {
+            for (const clang::FieldDecl *field : record.record->fields()) {
+                // skip const members
+                if (field->getType().isConstant(field->getASTContext())) {
+                    continue;
+                }
+                if (pullPrivate || field->getAccess() == clang::AS_public) {
+                    pulledMembers.emplace_back(PulledMember{ field->getName().str(), accessor + field->getName().str(),
+                        "JsonMemberKeys<::" + record.qualifiedName + ">::" + field->getName().str(), isBase ? &record.qualifiedName : nullptr });
+                }
+            }
+        };
+        for (const RelevantClass *baseClass : relevantBases) {
+            if (determinePrivateMemberAccess(baseClass->record).pull) {
+                nonFlattenedBases.emplace_back(baseClass);
+            } else {
+                addPulledMembers(*baseClass, "static_cast<::" + baseClass->qualifiedName + " &>(reflectable).", false, true);
+            }
+        }
+        addPulledMembers(relevantClass, "reflectable.", pullPrivateMembers, false);
+
+        // group members by the length of their name and by their name
+        map<std::size_t, map<std::string_view, vector<const PulledMember *>>> pulledMembersByLength;
+        for (const PulledMember &member : pulledMembers) {
+            pulledMembersByLength[member.name.size()][member.name].emplace_back(&member);
+        }
+
         // print pull method
         os << "template <> " << visibility << " void pull<::" << relevantClass.qualifiedName << ">(::" << relevantClass.qualifiedName
            << " &reflectable, const ::RAPIDJSON_NAMESPACE::GenericValue<::RAPIDJSON_NAMESPACE::UTF8<char>>::ConstObject &value, "
               "JsonDeserializationErrors "
               "*errors)\n{\n"
               "    // pull base classes\n";
-        for (const RelevantClass *baseClass : relevantBases) {
+        for (const RelevantClass *baseClass : nonFlattenedBases) {
             os << "    pull(static_cast<::" << baseClass->qualifiedName << " &>(reflectable), value, errors);\n";
         }
         os << "    // set error context for current record\n"
@@ -153,26 +312,85 @@ void JsonSerializationCodeGenerator::generate(ostream &os) const
            << relevantClass.qualifiedName
            << "\";\n"
               "    }\n"
-              "    // pull members\n";
-        auto pullWritten = false;
-        for (const clang::FieldDecl *field : relevantClass.record->fields()) {
-            // skip const members
-            if (field->getType().isConstant(field->getASTContext())) {
-                continue;
+              "    // pull members (including members of base classes) within a single pass over the object\n";
+        if (!pulledMembersByLength.empty()) {
+            os << "    for (const auto &member : value) {\n"
+                  "        const char *const name = member.name.GetString();\n"
+                  "        switch (member.name.GetStringLength()) {\n";
+            for (const auto &[length, membersOfLength] : pulledMembersByLength) {
+                os << "        case " << length << ":\n";
+                auto first = true;
+                for (const auto &[name, membersWithName] : membersOfLength) {
+                    // note: Members hiding equally named members of base classes take precedence (like in readMember()).
+                    const PulledMember *const member = membersWithName.back();
+                    os << (first ? "            if" : "            } else if") << " (!std::memcmp(name, " << member->key << ".name, " << length
+                       << ")) {\n"
+                       << "                pullMember(" << member->accessor << ", ";
+                    first = false;
+                    if (member->record) {
+                        os << '\"' << *member->record << '\"';
+                    } else {
+                        os << "nullptr";
+                    }
+                    os << ", " << member->key << ".name, member.value, errors);\n";
+                }
+                os << "            }\n"
+                      "            break;\n";
             }
-            if (pullPrivateMembers || field->getAccess() == clang::AS_public) {
-                os << "    pull(reflectable." << field->getName() << ", \"" << field->getName() << "\", value, errors);\n";
-                pullWritten = true;
-            }
-        }
-        if (relevantBases.empty() && !pullWritten) {
+            os << "        default:;\n"
+                  "        }\n"
+                  "    }\n";
+        } else if (nonFlattenedBases.empty()) {
             os << "    (void)reflectable;\n    (void)value;\n";
         }
         os << "    // restore error context for previous record\n"
               "    if (errors) {\n"
               "        errors->currentRecord = previousRecord;\n"
               "    }\n";
-        os << "}\n\n";
+        os << "}\n";
+
+        // print readMember method
+        os << "inline bool CustomTypeReader<::" << relevantClass.qualifiedName << ">::readMember(::" << relevantClass.qualifiedName
+           << " &reflectable, const char *name, ::RAPIDJSON_NAMESPACE::SizeType nameLength, JsonReaderSlot &slot)\n{\n"
+              "    // determine slot for members (including members of base classes)\n";
+        if (!pulledMembersByLength.empty()) {
+            os << "    switch (nameLength) {\n";
+            for (const auto &[length, membersOfLength] : pulledMembersByLength) {
+                os << "    case " << length << ":\n";
+                for (const auto &[name, membersWithName] : membersOfLength) {
+                    // note: Members hiding equally named members of base classes take precedence.
+                    const PulledMember *const member = membersWithName.back();
+                    os << "        if (!std::memcmp(name, " << member->key << ".name, " << length << ")) {\n"
+                       << "            slot = JsonReaderSlot::of(" << member->accessor << ", " << member->key << ".name";
+                    if (member->record) {
+                        os << ", \"" << *member->record << '\"';
+                    }
+                    os << ");\n"
+                          "            return true;\n"
+                          "        }\n";
+                }
+                os << "        break;\n";
+            }
+            os << "    default:;\n"
+                  "    }\n";
+        }
+        os << "    // determine slot for members of base classes with private members\n";
+        auto delegated = false;
+        for (const RelevantClass *baseClass : nonFlattenedBases) {
+            if (!baseClass->record->hasDefaultConstructor()) {
+                continue;
+            }
+            delegated = true;
+            os << "    if (CustomTypeReader<::" << baseClass->qualifiedName << ">::readMember(static_cast<::" << baseClass->qualifiedName
+               << " &>(reflectable), name, nameLength, slot)) {\n"
+                  "        return true;\n"
+                  "    }\n";
+        }
+        if (pulledMembersByLength.empty() && !delegated) {
+            os << "    (void)reflectable;\n    (void)name;\n    (void)nameLength;\n    (void)slot;\n";
+        }
+        os << "    return false;\n"
+              "}\n\n";
     }
 
     // close namespace ReflectiveRapidJSON::JsonReflector
@@ -27,7 +27,13 @@ public:
     void generate(std::ostream &os) const override;
 
 protected:
+    struct PrivateMemberAccess {
+        bool push = false;
+        bool pull = false;
+    };
+
     void computeRelevantClass(RelevantClass &possiblyRelevantClass) const override;
+    static PrivateMemberAccess determinePrivateMemberAccess(const clang::CXXRecordDecl *record);
 
     const Options &m_options;
 };
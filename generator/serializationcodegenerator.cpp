@@ -95,19 +95,32 @@ void SerializationCodeGenerator::computeRelevantClass(RelevantClass &possiblyRel
     }
 
     // consider all classes inheriting from an instantiation of "JsonSerializable" relevant
-    if (const auto *const relevantBase = inheritsFromInstantiationOf(possiblyRelevantClass.record, m_qualifiedNameOfRecords)) {
-        auto policy = clang::PrintingPolicy(possiblyRelevantClass.record->getASTContext().getLangOpts());
-        policy.FullyQualifiedName = true;
-        policy.SuppressScope = false;
-        policy.SuppressUnwrittenScope = false;
-        policy.SplitTemplateClosers = false;
-        possiblyRelevantClass.relevantBase
-            = clang::TypeName::getFullyQualifiedName(relevantBase->getType(), possiblyRelevantClass.record->getASTContext(), policy, true);
+    if (auto relevantBase = qualifiedNameOfRelevantBase(possiblyRelevantClass.record); !relevantBase.empty()) {
+        possiblyRelevantClass.relevantBase = std::move(relevantBase);
         possiblyRelevantClass.isRelevant = IsRelevant::Yes;
         return;
     }
 }
 
+/*!
+ * rief Returns the fully qualified name of the instantiation of "JsonSerializable"  record inherits from.
+ * eturns Returns an empty string if  record does not inherit from such an instantiation.
+ * emarks The specified  record must be defined (not only forward-declared).
+ */
+std::string SerializationCodeGenerator::qualifiedNameOfRelevantBase(clang::CXXRecordDecl *record) const
+{
+    const auto *const relevantBase = inheritsFromInstantiationOf(record, m_qualifiedNameOfRecords);
+    if (!relevantBase) {
+        return std::string();
+    }
+    auto policy = clang::PrintingPolicy(record->getASTContext().getLangOpts());
+    policy.FullyQualifiedName = true;
+    policy.SuppressScope = false;
+    policy.SuppressUnwrittenScope = false;
+    policy.SplitTemplateClosers = false;
+    return clang::TypeName::getFullyQualifiedName(relevantBase->getType(), record->getASTContext(), policy, true);
+}
+
 std::vector<SerializationCodeGenerator::RelevantClass> SerializationCodeGenerator::findRelevantClasses() const
 {
     std::vector<RelevantClass> relevantClasses;
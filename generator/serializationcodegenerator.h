@@ -34,6 +34,7 @@ public:
 protected:
     virtual void computeRelevantClass(RelevantClass &possiblyRelevantClass) const;
     std::vector<RelevantClass> findRelevantClasses() const;
+    std::string qualifiedNameOfRelevantBase(clang::CXXRecordDecl *record) const;
     static std::vector<const RelevantClass *> findRelevantBaseClasses(
         const RelevantClass &relevantClass, const std::vector<RelevantClass> &relevantBases);
 
@@ -1,13 +1,43 @@
 namespace ReflectiveRapidJSON {
 namespace JsonReflector {
 
+template <> struct JsonMemberKeys<::TestNamespace1::Person> {
+    static constexpr ::ReflectiveRapidJSON::JsonMemberKey age{ "age", "\"age\"" };
+    static constexpr ::ReflectiveRapidJSON::JsonMemberKey alive{ "alive", "\"alive\"" };
+};
+template <> struct JsonMemberKeys<::TestNamespace2::ThirdPartyStruct> {
+    static constexpr ::ReflectiveRapidJSON::JsonMemberKey test1{ "test1", "\"test1\"" };
+    static constexpr ::ReflectiveRapidJSON::JsonMemberKey test2{ "test2", "\"test2\"" };
+};
+
+template <> struct CustomTypeReader<::TestNamespace1::Person> {
+    static constexpr bool isSupported = true;
+    static constexpr const char *record = "TestNamespace1::Person";
+    static bool readMember(::TestNamespace1::Person &reflectable, const char *name, ::RAPIDJSON_NAMESPACE::SizeType nameLength, JsonReaderSlot &slot);
+};
+template <> struct CustomTypeReader<::TestNamespace2::ThirdPartyStruct> {
+    static constexpr bool isSupported = true;
+    static constexpr const char *record = "TestNamespace2::ThirdPartyStruct";
+    static bool readMember(::TestNamespace2::ThirdPartyStruct &reflectable, const char *name, ::RAPIDJSON_NAMESPACE::SizeType nameLength, JsonReaderSlot &slot);
+};
+
 // define code for (de)serializing TestNamespace1::Person objects
 template <>  void push<::TestNamespace1::Person>(const ::TestNamespace1::Person &reflectable, ::RAPIDJSON_NAMESPACE::Value::Object &value, ::RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator)
 {
     // push base classes
     // push members
-    push(reflectable.age, "age", value, allocator);
-    push(reflectable.alive, "alive", value, allocator);
+    push(reflectable.age, JsonMemberKeys<::TestNamespace1::Person>::age, value, allocator);
+    push(reflectable.alive, JsonMemberKeys<::TestNamespace1::Person>::alive, value, allocator);
+}
+template <> struct HasCustomTypeWriter<::TestNamespace1::Person> : public Traits::Bool<true> {};
+template <> template <typename Handler> ::RAPIDJSON_NAMESPACE::SizeType CustomTypeWriter<::TestNamespace1::Person>::writeMembers(const ::TestNamespace1::Person &reflectable, Handler &handler)
+{
+    ::RAPIDJSON_NAMESPACE::SizeType memberCount = 0;
+    // write base classes
+    // write members
+    write(reflectable.age, JsonMemberKeys<::TestNamespace1::Person>::age, handler);
+    write(reflectable.alive, JsonMemberKeys<::TestNamespace1::Person>::alive, handler);
+    return memberCount + 2;
 }
 template <>  void pull<::TestNamespace1::Person>(::TestNamespace1::Person &reflectable, const ::RAPIDJSON_NAMESPACE::GenericValue<::RAPIDJSON_NAMESPACE::UTF8<char>>::ConstObject &value, JsonDeserializationErrors *errors)
 {
@@ -18,22 +48,67 @@ template <>  void pull<::TestNamespace1::Person>(::TestNamespace1::Person &refle
         previousRecord = errors->currentRecord;
         errors->currentRecord = "TestNamespace1::Person";
     }
-    // pull members
-    pull(reflectable.age, "age", value, errors);
-    pull(reflectable.alive, "alive", value, errors);
+    // pull members (including members of base classes) within a single pass over the object
+    for (const auto &member : value) {
+        const char *const name = member.name.GetString();
+        switch (member.name.GetStringLength()) {
+        case 3:
+            if (!std::memcmp(name, JsonMemberKeys<::TestNamespace1::Person>::age.name, 3)) {
+                pullMember(reflectable.age, nullptr, JsonMemberKeys<::TestNamespace1::Person>::age.name, member.value, errors);
+            }
+            break;
+        case 5:
+            if (!std::memcmp(name, JsonMemberKeys<::TestNamespace1::Person>::alive.name, 5)) {
+                pullMember(reflectable.alive, nullptr, JsonMemberKeys<::TestNamespace1::Person>::alive.name, member.value, errors);
+            }
+            break;
+        default:;
+        }
+    }
     // restore error context for previous record
     if (errors) {
         errors->currentRecord = previousRecord;
     }
 }
+inline bool CustomTypeReader<::TestNamespace1::Person>::readMember(::TestNamespace1::Person &reflectable, const char *name, ::RAPIDJSON_NAMESPACE::SizeType nameLength, JsonReaderSlot &slot)
+{
+    // determine slot for members (including members of base classes)
+    switch (nameLength) {
+    case 3:
+        if (!std::memcmp(name, JsonMemberKeys<::TestNamespace1::Person>::age.name, 3)) {
+            slot = JsonReaderSlot::of(reflectable.age, JsonMemberKeys<::TestNamespace1::Person>::age.name);
+            return true;
+        }
+        break;
+    case 5:
+        if (!std::memcmp(name, JsonMemberKeys<::TestNamespace1::Person>::alive.name, 5)) {
+            slot = JsonReaderSlot::of(reflectable.alive, JsonMemberKeys<::TestNamespace1::Person>::alive.name);
+            return true;
+        }
+        break;
+    default:;
+    }
+    // determine slot for members of base classes with private members
+    return false;
+}
 
 // define code for (de)serializing TestNamespace2::ThirdPartyStruct objects
 template <>  void push<::TestNamespace2::ThirdPartyStruct>(const ::TestNamespace2::ThirdPartyStruct &reflectable, ::RAPIDJSON_NAMESPACE::Value::Object &value, ::RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator)
 {
     // push base classes
     // push members
-    push(reflectable.test1, "test1", value, allocator);
-    push(reflectable.test2, "test2", value, allocator);
+    push(reflectable.test1, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test1, value, allocator);
+    push(reflectable.test2, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test2, value, allocator);
+}
+template <> struct HasCustomTypeWriter<::TestNamespace2::ThirdPartyStruct> : public Traits::Bool<true> {};
+template <> template <typename Handler> ::RAPIDJSON_NAMESPACE::SizeType CustomTypeWriter<::TestNamespace2::ThirdPartyStruct>::writeMembers(const ::TestNamespace2::ThirdPartyStruct &reflectable, Handler &handler)
+{
+    ::RAPIDJSON_NAMESPACE::SizeType memberCount = 0;
+    // write base classes
+    // write members
+    write(reflectable.test1, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test1, handler);
+    write(reflectable.test2, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test2, handler);
+    return memberCount + 2;
 }
 template <>  void pull<::TestNamespace2::ThirdPartyStruct>(::TestNamespace2::ThirdPartyStruct &reflectable, const ::RAPIDJSON_NAMESPACE::GenericValue<::RAPIDJSON_NAMESPACE::UTF8<char>>::ConstObject &value, JsonDeserializationErrors *errors)
 {
@@ -44,14 +119,44 @@ template <>  void pull<::TestNamespace2::ThirdPartyStruct>(::TestNamespace2::Thi
         previousRecord = errors->currentRecord;
         errors->currentRecord = "TestNamespace2::ThirdPartyStruct";
     }
-    // pull members
-    pull(reflectable.test1, "test1", value, errors);
-    pull(reflectable.test2, "test2", value, errors);
+    // pull members (including members of base classes) within a single pass over the object
+    for (const auto &member : value) {
+        const char *const name = member.name.GetString();
+        switch (member.name.GetStringLength()) {
+        case 5:
+            if (!std::memcmp(name, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test1.name, 5)) {
+                pullMember(reflectable.test1, nullptr, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test1.name, member.value, errors);
+            } else if (!std::memcmp(name, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test2.name, 5)) {
+                pullMember(reflectable.test2, nullptr, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test2.name, member.value, errors);
+            }
+            break;
+        default:;
+        }
+    }
     // restore error context for previous record
     if (errors) {
         errors->currentRecord = previousRecord;
     }
 }
+inline bool CustomTypeReader<::TestNamespace2::ThirdPartyStruct>::readMember(::TestNamespace2::ThirdPartyStruct &reflectable, const char *name, ::RAPIDJSON_NAMESPACE::SizeType nameLength, JsonReaderSlot &slot)
+{
+    // determine slot for members (including members of base classes)
+    switch (nameLength) {
+    case 5:
+        if (!std::memcmp(name, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test1.name, 5)) {
+            slot = JsonReaderSlot::of(reflectable.test1, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test1.name);
+            return true;
+        }
+        if (!std::memcmp(name, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test2.name, 5)) {
+            slot = JsonReaderSlot::of(reflectable.test2, JsonMemberKeys<::TestNamespace2::ThirdPartyStruct>::test2.name);
+            return true;
+        }
+        break;
+    default:;
+    }
+    // determine slot for members of base classes with private members
+    return false;
+}
 
 } // namespace JsonReflector
 } // namespace ReflectiveRapidJSON
@@ -17,6 +17,8 @@
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <type_traits>
+#include <utility>
 
 using namespace CPPUNIT_NS;
 using namespace CppUtilities;
@@ -29,16 +31,33 @@ class BinaryGeneratorTests : public TestFixture {
     CPPUNIT_TEST_SUITE(BinaryGeneratorTests);
     CPPUNIT_TEST(testSerializationAndDeserialization);
     CPPUNIT_TEST(testPointerHandling);
+    CPPUNIT_TEST(testSkippableRecords);
+    CPPUNIT_TEST(testProjection);
+    CPPUNIT_TEST(testVersionedMembers);
+    CPPUNIT_TEST(testSchemaHeader);
+    CPPUNIT_TEST(testBorrowedStrings);
     CPPUNIT_TEST_SUITE_END();
 
 public:
     BinaryGeneratorTests();
     void testSerializationAndDeserialization();
     void testPointerHandling();
+    void testSkippableRecords();
+    void testProjection();
+    void testVersionedMembers();
+    void testSchemaHeader();
+    void testBorrowedStrings();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(BinaryGeneratorTests);
 
+/// \brief The IsReadableFromStream class checks whether \tparam Type can be read via BinaryDeserializer.
+template <typename Type, typename = void> struct IsReadableFromStream : public std::false_type {};
+template <typename Type>
+struct IsReadableFromStream<Type,
+    std::void_t<decltype(BinaryReflector::readCustomType(std::declval<BinaryReflector::BinaryDeserializer &>(), std::declval<Type &>()))>>
+    : public std::true_type {};
+
 BinaryGeneratorTests::BinaryGeneratorTests()
 {
 }
@@ -64,6 +83,15 @@ void BinaryGeneratorTests::testSerializationAndDeserialization()
     CPPUNIT_ASSERT_EQUAL(obj.someSize, deserializedObj.someSize);
     CPPUNIT_ASSERT_EQUAL(obj.someString, deserializedObj.someString);
     CPPUNIT_ASSERT_EQUAL(obj.someBool, deserializedObj.someBool);
+
+    // serialize to and deserialize from a buffer via the generated functions for BinaryBufferSerializer/BinaryBufferDeserializer
+    const auto buffer = static_cast<BinarySerializable<DerivedTestStruct> &>(obj).toBinary();
+    CPPUNIT_ASSERT_EQUAL(stream.str(), buffer);
+    const auto objFromBuffer(BinarySerializable<DerivedTestStruct>::fromBinary(buffer));
+    CPPUNIT_ASSERT_EQUAL(obj.someInt, objFromBuffer.someInt);
+    CPPUNIT_ASSERT_EQUAL(obj.someSize, objFromBuffer.someSize);
+    CPPUNIT_ASSERT_EQUAL(obj.someString, objFromBuffer.someString);
+    CPPUNIT_ASSERT_EQUAL(obj.someBool, objFromBuffer.someBool);
 }
 
 /*!
@@ -109,4 +137,190 @@ void BinaryGeneratorTests::testPointerHandling()
     CPPUNIT_ASSERT_EQUAL(asHexNumber<uint32_t>(0xF1F2F3F4), asHexNumber<uint32_t>(deserializedPs.u1->n));
     CPPUNIT_ASSERT_EQUAL(asHexNumber<uint32_t>(0xDDDDDDDD), asHexNumber<uint32_t>(deserializedPs.u2->n));
     CPPUNIT_ASSERT_EQUAL(asHexNumber<uint32_t>(0xEEEEEEEE), asHexNumber<uint32_t>(deserializedPs.u3->n));
+
+    // the same is supposed to work when (de)serializing from/to a buffer
+    const auto psFromBuffer(PointerStruct::fromBinary(ps.toBinary()));
+    CPPUNIT_ASSERT_EQUAL(asHexNumber<uint32_t>(0xF1F2F3F4), asHexNumber<uint32_t>(psFromBuffer.s1->n));
+    CPPUNIT_ASSERT(psFromBuffer.s1 == psFromBuffer.s2);
+    CPPUNIT_ASSERT_EQUAL(asHexNumber<uint32_t>(0xBBBBBBBB), asHexNumber<uint32_t>(psFromBuffer.s3->n));
+    CPPUNIT_ASSERT_EQUAL(asHexNumber<uint32_t>(0xDDDDDDDD), asHexNumber<uint32_t>(psFromBuffer.u2->n));
+}
+
+/*!
+ * \brief Tests reading records written by a newer version which are enabled via REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD.
+ */
+void BinaryGeneratorTests::testSkippableRecords()
+{
+    auto newRecords = vector<SkippableRecordV2>(2);
+    newRecords[0].number = 1;
+    newRecords[0].text = "foo";
+    newRecords[0].tags = { "a", "bc" };
+    newRecords[1].number = 2;
+    newRecords[1].text = "bar";
+
+    // serialize newer records followed by a further value
+    stringstream stream(ios_base::in | ios_base::out | ios_base::binary);
+    stream.exceptions(ios_base::failbit | ios_base::badbit);
+    auto serializer = BinaryReflector::BinarySerializer(&stream);
+    serializer.write(newRecords);
+    serializer.write(uint16_t(0xF00D));
+    auto buffer = string();
+    auto bufferSerializer = BinaryReflector::BinaryBufferSerializer(buffer);
+    bufferSerializer.write(newRecords);
+    bufferSerializer.write(uint16_t(0xF00D));
+    CPPUNIT_ASSERT_EQUAL(stream.str(), buffer);
+    CPPUNIT_ASSERT_EQUAL(buffer.size(), BinaryReflector::binarySize(newRecords) + 2);
+
+    // deserialize them as older records skipping the tags
+    auto oldRecords = vector<SkippableRecord>();
+    auto furtherValue = uint16_t();
+    auto deserializer = BinaryReflector::BinaryDeserializer(&stream);
+    deserializer.read(oldRecords);
+    deserializer.read(furtherValue);
+    CPPUNIT_ASSERT_EQUAL(2_st, oldRecords.size());
+    CPPUNIT_ASSERT_EQUAL(1u, oldRecords[0].number);
+    CPPUNIT_ASSERT_EQUAL("foo"s, oldRecords[0].text);
+    CPPUNIT_ASSERT_EQUAL(2u, oldRecords[1].number);
+    CPPUNIT_ASSERT_EQUAL("bar"s, oldRecords[1].text);
+    CPPUNIT_ASSERT_EQUAL(uint16_t(0xF00D), furtherValue);
+    oldRecords.clear();
+    auto bufferDeserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    bufferDeserializer.read(oldRecords);
+    bufferDeserializer.read(furtherValue);
+    CPPUNIT_ASSERT_EQUAL(2_st, oldRecords.size());
+    CPPUNIT_ASSERT_EQUAL("bar"s, oldRecords[1].text);
+    CPPUNIT_ASSERT_EQUAL(uint16_t(0xF00D), furtherValue);
+
+    // deserialize an older record as newer record
+    const auto newRecord = SkippableRecordV2::fromBinary(oldRecords[0].toBinary());
+    CPPUNIT_ASSERT_EQUAL(1u, newRecord.number);
+    CPPUNIT_ASSERT_EQUAL("foo"s, newRecord.text);
+    CPPUNIT_ASSERT(newRecord.tags.empty());
+}
+
+/*!
+ * \brief Tests reading only selected members via the generated readCustomTypeProjected() functions.
+ */
+void BinaryGeneratorTests::testProjection()
+{
+    auto record = SkippableRecordV2();
+    record.number = 1;
+    record.text = "foo";
+    record.tags = { "a", "bc" };
+    const auto buffer = record.toBinary();
+
+    using Fields = BinaryReflector::BinaryFields<SkippableRecordV2>;
+    auto projected = SkippableRecordV2();
+    auto deserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    CPPUNIT_ASSERT_EQUAL(BinaryVersion(2), deserializer.readProjected(projected, Fields::number | Fields::tags));
+    CPPUNIT_ASSERT_EQUAL(0_st, deserializer.bytesRemaining());
+    CPPUNIT_ASSERT_EQUAL(1u, projected.number);
+    CPPUNIT_ASSERT(projected.text.empty());
+    CPPUNIT_ASSERT_EQUAL((vector<string>{ "a", "bc" }), projected.tags);
+}
+
+/*!
+ * \brief Tests (de)serializing members which are only present in certain versions.
+ */
+void BinaryGeneratorTests::testVersionedMembers()
+{
+    auto obj = SomeNamespace::VersionedStruct();
+    obj.a = 1;
+    obj.b = 2;
+    obj.c = 3;
+    obj.d = 4;
+    obj.e = 5;
+    obj.f = 6;
+    obj.g = 7;
+
+    // serialize the default version and versions before and after the members present in all versions
+    for (const auto version : { BinaryVersion(0), BinaryVersion(2), BinaryVersion(4) }) {
+        auto buffer = string();
+        auto serializer = BinaryReflector::BinaryBufferSerializer(buffer);
+        serializer.write(obj, version);
+        CPPUNIT_ASSERT_EQUAL(1_st + 4 * (version == 4 ? 5 : 4), buffer.size());
+
+        auto deserializedObj = SomeNamespace::VersionedStruct();
+        auto deserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+        if (version == 4) {
+            CPPUNIT_ASSERT_THROW(deserializer.read(deserializedObj), BinaryVersionNotSupported);
+            continue;
+        }
+        CPPUNIT_ASSERT_EQUAL(version ? version : BinaryVersion(3), deserializer.read(deserializedObj));
+        CPPUNIT_ASSERT_EQUAL(0_st, deserializer.bytesRemaining());
+        CPPUNIT_ASSERT_EQUAL(1u, deserializedObj.a);
+        CPPUNIT_ASSERT_EQUAL(2u, deserializedObj.b);
+        CPPUNIT_ASSERT_EQUAL(version == 2 ? 3u : 0u, deserializedObj.c);
+        CPPUNIT_ASSERT_EQUAL(version == 2 ? 4u : 0u, deserializedObj.d);
+        CPPUNIT_ASSERT_EQUAL(version == 2 ? 0u : 5u, deserializedObj.e);
+        CPPUNIT_ASSERT_EQUAL(version == 2 ? 0u : 6u, deserializedObj.f);
+        CPPUNIT_ASSERT_EQUAL(0u, deserializedObj.g);
+    }
+}
+
+/*!
+ * \brief Tests recording the schema via the generated BinarySchemaFingerprint specializations.
+ */
+void BinaryGeneratorTests::testSchemaHeader()
+{
+    using namespace BinaryReflector;
+    CPPUNIT_ASSERT(BinarySchemaFingerprint<SkippableRecordV2>::value != 0);
+    CPPUNIT_ASSERT(BinarySchemaFingerprint<SkippableRecordV2>::value != BinarySchemaFingerprint<SkippableRecord>::value);
+
+    auto records = vector<SkippableRecordV2>(2);
+    records[0].number = 1;
+    records[0].text = "foo";
+    records[0].tags = { "a", "bc" };
+    records[1].number = 2;
+    auto buffer = string();
+    auto serializer = BinaryBufferSerializer(buffer);
+    serializer.writeHeader<SkippableRecordV2>();
+    serializer.write(records);
+
+    // read via the same type verifying the schema
+    auto deserializer = BinaryBufferDeserializer(buffer.data(), buffer.size());
+    auto newRecords = vector<SkippableRecordV2>();
+    deserializer.readHeader<SkippableRecordV2>();
+    CPPUNIT_ASSERT(deserializer.schema().verified);
+    deserializer.read(newRecords);
+    CPPUNIT_ASSERT_EQUAL(2_st, newRecords.size());
+    CPPUNIT_ASSERT_EQUAL("foo"s, newRecords[0].text);
+    CPPUNIT_ASSERT_EQUAL((vector<string>{ "a", "bc" }), newRecords[0].tags);
+    CPPUNIT_ASSERT_EQUAL(2u, newRecords[1].number);
+
+    // read via the older version falling back to checking the version from the header
+    deserializer = BinaryBufferDeserializer(buffer.data(), buffer.size());
+    auto oldRecords = vector<SkippableRecord>();
+    deserializer.readHeader<SkippableRecord>();
+    CPPUNIT_ASSERT(!deserializer.schema().verified);
+    deserializer.read(oldRecords);
+    CPPUNIT_ASSERT_EQUAL(2_st, oldRecords.size());
+    CPPUNIT_ASSERT_EQUAL("foo"s, oldRecords[0].text);
+    CPPUNIT_ASSERT_EQUAL(0_st, deserializer.bytesRemaining());
+}
+
+/*!
+ * \brief Tests reading std::string_view members which is only possible via BinaryBufferDeserializer.
+ */
+void BinaryGeneratorTests::testBorrowedStrings()
+{
+    static_assert(IsReadableFromStream<SkippableRecordV2>::value, "structs without std::string_view can be read from streams");
+    static_assert(!IsReadableFromStream<BorrowingStruct>::value, "structs with std::string_view can not be read from streams");
+    static_assert(!IsReadableFromStream<NestedBorrowingStruct>::value, "nested std::string_view members are considered");
+
+    auto obj = NestedBorrowingStruct();
+    obj.items.resize(2);
+    obj.items[0].name = "foo";
+    obj.items[0].number = 1;
+    obj.items[1].name = "some longer name";
+    obj.items[1].number = 2;
+    const auto buffer = obj.toBinary();
+    const auto deserializedObj = NestedBorrowingStruct::fromBinary(buffer);
+    CPPUNIT_ASSERT_EQUAL(2_st, deserializedObj.items.size());
+    CPPUNIT_ASSERT_EQUAL("foo"s, std::string(deserializedObj.items[0].name));
+    CPPUNIT_ASSERT_EQUAL(1u, deserializedObj.items[0].number);
+    CPPUNIT_ASSERT_EQUAL("some longer name"s, std::string(deserializedObj.items[1].name));
+    CPPUNIT_ASSERT_EQUAL(2u, deserializedObj.items[1].number);
+    CPPUNIT_ASSERT_MESSAGE("std::string_view points into buffer",
+        deserializedObj.items[1].name.data() >= buffer.data() && deserializedObj.items[1].name.data() < buffer.data() + buffer.size());
 }
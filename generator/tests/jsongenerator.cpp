@@ -31,6 +31,7 @@ class JsonGeneratorTests : public TestFixture {
     CPPUNIT_TEST(testNesting);
     CPPUNIT_TEST(testSingleInheritence);
     CPPUNIT_TEST(testMultipleInheritence);
+    CPPUNIT_TEST(testHidingMembers);
     CPPUNIT_TEST(testCustomSerialization);
     CPPUNIT_TEST(test3rdPartyAdaption);
     CPPUNIT_TEST(testHandlingConstMembers);
@@ -44,6 +45,7 @@ public:
     void testNesting();
     void testSingleInheritence();
     void testMultipleInheritence();
+    void testHidingMembers();
     void testCustomSerialization();
     void test3rdPartyAdaption();
     void testHandlingConstMembers();
@@ -55,7 +57,7 @@ private:
 CPPUNIT_TEST_SUITE_REGISTRATION(JsonGeneratorTests);
 
 JsonGeneratorTests::JsonGeneratorTests()
-    : m_expectedCode(toArrayOfLines(readFile(testFilePath("some_structs_json_serialization.h"), 3 * 1024)))
+    : m_expectedCode(toArrayOfLines(readFile(testFilePath("some_structs_json_serialization.h"), 16 * 1024)))
 {
 }
 
@@ -221,6 +223,36 @@ void JsonGeneratorTests::testMultipleInheritence()
     CPPUNIT_ASSERT_EQUAL(test.arrayOfStrings, parsedTest.arrayOfStrings);
 }
 
+/*!
+ * \brief Tests deserializing a member which hides a member of the base class and deserializing duplicate keys.
+ * \remarks The DOM-based and the SAX-based deserialization are supposed to produce the same object.
+ */
+void JsonGeneratorTests::testHidingMembers()
+{
+    const auto check = [](const HidingTestStruct &parsedTest) {
+        CPPUNIT_ASSERT_EQUAL("second"s, parsedTest.someString);
+        CPPUNIT_ASSERT_EQUAL("foo"s, static_cast<const TestStruct &>(parsedTest).someString);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), parsedTest.someSize);
+    };
+
+    // only the hiding member is read; of duplicate keys, the last one takes precedence
+    const auto json = "{\"someString\":\"first\",\"someSize\":5,\"someString\":\"second\"}"s;
+    check(JsonSerializable<HidingTestStruct>::fromJson(json));
+    check(JsonReflector::fromJsonSax<HidingTestStruct>(json));
+
+    // the hidden member is written before the hiding member so the hiding member survives a round trip
+    auto test = HidingTestStruct();
+    test.someSize = 5;
+    test.someString = "second";
+    static_cast<TestStruct &>(test).someString = "base";
+    const auto expectedJSON
+        = "{\"someInt\":0,\"someSize\":5,\"someString\":\"base\",\"yetAnotherString\":\"bar\",\"someString\":\"second\"}"s;
+    const auto writtenJSON = string(as<HidingTestStruct>(test).toJson().GetString());
+    CPPUNIT_ASSERT_EQUAL(expectedJSON, writtenJSON);
+    check(JsonSerializable<HidingTestStruct>::fromJson(writtenJSON));
+    check(JsonReflector::fromJsonSax<HidingTestStruct>(writtenJSON));
+}
+
 /*!
  * \brief Like testIncludingGeneratedHeader() but also tests custom (de)serialization.
  */
@@ -95,4 +95,45 @@ as_of_version(4):
 
 } // namespace SomeNamespace
 
+/*!
+ * \brief The SkippableRecord struct is used to test reading records written by a newer version (see SkippableRecordV2).
+ */
+struct SkippableRecord : public BinarySerializable<SkippableRecord, 1> {
+    std::uint32_t number = 0;
+    std::string text;
+};
+
+/*!
+ * \brief The SkippableRecordV2 struct is a newer version of SkippableRecord with an additional member.
+ */
+// clang-format off
+struct SkippableRecordV2 : public BinarySerializable<SkippableRecordV2, 2> {
+    std::uint32_t number = 0;
+    std::string text;
+
+as_of_version(2):
+    std::vector<std::string> tags;
+};
+// clang-format on
+
+/*!
+ * \brief The BorrowingStruct struct is used to test std::string_view members which can only be read via BinaryBufferDeserializer.
+ */
+struct BorrowingStruct : public BinarySerializable<BorrowingStruct> {
+    std::string_view name;
+    std::uint32_t number = 0;
+};
+
+/*!
+ * \brief The NestedBorrowingStruct struct is used to test whether std::string_view members of nested structs are considered.
+ */
+struct NestedBorrowingStruct : public BinarySerializable<NestedBorrowingStruct> {
+    std::vector<BorrowingStruct> items;
+};
+
+namespace ReflectiveRapidJSON {
+REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD(SkippableRecord);
+REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD(SkippableRecordV2);
+} // namespace ReflectiveRapidJSON
+
 #endif // REFLECTIVE_RAPIDJSON_TESTS_MORE_STRUCTS_H
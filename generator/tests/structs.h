@@ -76,6 +76,14 @@ struct DerivedTestStruct : public TestStruct, public JsonSerializable<DerivedTes
     bool someBool = true;
 };
 
+/*!
+ * \brief The HidingTestStruct struct hides a member of its base class. Only the hiding member is supposed to be deserialized.
+ *        This is asserted in JsonGeneratorTests::testHidingMembers();
+ */
+struct HidingTestStruct : public TestStruct, public JsonSerializable<HidingTestStruct> {
+    string someString = "hides TestStruct::someString";
+};
+
 /*!
  * \brief The NonSerializable struct should be ignored when used as base class because it isn't serializable.
  */
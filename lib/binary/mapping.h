@@ -0,0 +1,232 @@
+#ifndef REFLECTIVE_RAPIDJSON_BINARY_MAPPING_H
+#define REFLECTIVE_RAPIDJSON_BINARY_MAPPING_H
+
+/*!
+ * \file mapping.h
+ * \brief Contains classes to deserialize objects from memory-mapped files without copying the file contents.
+ */
+
+#include "./reflector.h"
+
+#include <c++utilities/application/global.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#ifdef PLATFORM_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ReflectiveRapidJSON {
+namespace BinaryReflector {
+
+#ifdef PLATFORM_UNIX
+/*!
+ * \brief The BinaryFileMapping class maps a file read-only into memory for the lifetime of the object.
+ *
+ * The mapped data can be deserialized via BinaryBufferDeserializer which checks all reads against the size of the
+ * mapping. Objects with std::string_view members borrow from the mapping; use BinaryMappedObject to keep the mapping
+ * alive as long as such an object.
+ *
+ * \throws The constructors throw std::system_error if the file cannot be mapped.
+ */
+class BinaryFileMapping {
+public:
+    explicit BinaryFileMapping(int fileDescriptor);
+    explicit BinaryFileMapping(const std::string &path);
+    BinaryFileMapping(BinaryFileMapping &&other) noexcept;
+    BinaryFileMapping &operator=(BinaryFileMapping &&other) noexcept;
+    BinaryFileMapping(const BinaryFileMapping &) = delete;
+    BinaryFileMapping &operator=(const BinaryFileMapping &) = delete;
+    ~BinaryFileMapping();
+
+    const char *data() const;
+    std::size_t size() const;
+
+private:
+    void map(int fileDescriptor);
+
+    const char *m_data;
+    std::size_t m_size;
+};
+
+/*!
+ * \brief Maps the file referred by the specified \a fileDescriptor.
+ * \remarks The file descriptor is not closed by the mapping and may be closed right away.
+ */
+inline BinaryFileMapping::BinaryFileMapping(int fileDescriptor)
+    : m_data(nullptr)
+    , m_size(0)
+{
+    map(fileDescriptor);
+}
+
+/*!
+ * \brief Maps the file at the specified \a path.
+ */
+inline BinaryFileMapping::BinaryFileMapping(const std::string &path)
+    : m_data(nullptr)
+    , m_size(0)
+{
+    const auto fileDescriptor = ::open(path.data(), O_RDONLY | O_CLOEXEC);
+    if (fileDescriptor < 0) {
+        throw std::system_error(errno, std::generic_category(), "unable to open \"" + path + "\" for mapping");
+    }
+    try {
+        map(fileDescriptor);
+    } catch (...) {
+        ::close(fileDescriptor);
+        throw;
+    }
+    ::close(fileDescriptor);
+}
+
+inline BinaryFileMapping::BinaryFileMapping(BinaryFileMapping &&other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+{
+}
+
+inline BinaryFileMapping &BinaryFileMapping::operator=(BinaryFileMapping &&other) noexcept
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    return *this;
+}
+
+/*!
+ * \brief Unmaps the file.
+ */
+inline BinaryFileMapping::~BinaryFileMapping()
+{
+    if (m_data) {
+        ::munmap(const_cast<char *>(m_data), m_size);
+    }
+}
+
+inline void BinaryFileMapping::map(int fileDescriptor)
+{
+    struct stat fileStatus;
+    if (::fstat(fileDescriptor, &fileStatus) < 0) {
+        throw std::system_error(errno, std::generic_category(), "unable to determine size of file to map");
+    }
+    if (fileStatus.st_size <= 0) {
+        return; // mapping an empty file is not possible (and not required)
+    }
+    const auto size = static_cast<std::size_t>(fileStatus.st_size);
+    auto *const data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (data == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "unable to map file");
+    }
+    // the whole file is going to be deserialized so let the kernel read ahead (failing to do so is not an error)
+    ::madvise(data, size, MADV_WILLNEED);
+    m_data = static_cast<const char *>(data);
+    m_size = size;
+}
+
+/*!
+ * \brief Returns the mapped data or nullptr if the file is empty.
+ */
+inline const char *BinaryFileMapping::data() const
+{
+    return m_data;
+}
+
+/*!
+ * \brief Returns the size of the mapped data.
+ */
+inline std::size_t BinaryFileMapping::size() const
+{
+    return m_size;
+}
+
+/*!
+ * \brief The BinaryMappedObject class holds an object deserialized from a BinaryFileMapping along with the mapping.
+ *
+ * The mapped data must start with a header (see BinaryHeader) as written via writeHeader() or writeHeader<Type>() which
+ * determines the byte order and schema the object is read with.
+ *
+ * std::string_view members of the object (including nested ones) point into the mapping instead of being copied. The
+ * mapping is owned by the BinaryMappedObject so these members stay valid as long as the BinaryMappedObject exists (also
+ * when it is moved as the mapped memory itself is not moved).
+ */
+template <typename Type> class BinaryMappedObject {
+public:
+    explicit BinaryMappedObject(BinaryFileMapping &&mapping);
+
+    const Type &get() const;
+    const Type &operator*() const;
+    const Type *operator->() const;
+    BinaryVersion version() const;
+    const BinaryFileMapping &mapping() const;
+
+private:
+    static BinaryVersion read(const BinaryFileMapping &mapping, Type &object);
+
+    BinaryFileMapping m_mapping;
+    Type m_object;
+    BinaryVersion m_version;
+};
+
+/*!
+ * \brief Deserializes the object from the specified \a mapping taking ownership of the mapping.
+ * \throws Throws CppUtilities::ConversionException if the mapped data does not start with a supported header or does not
+ *         contain a valid object.
+ */
+template <typename Type>
+BinaryMappedObject<Type>::BinaryMappedObject(BinaryFileMapping &&mapping)
+    : m_mapping(std::move(mapping))
+    , m_object()
+    , m_version(read(m_mapping, m_object))
+{
+}
+
+/*!
+ * \brief Reads the header and the \a object following it from the specified \a mapping.
+ */
+template <typename Type> BinaryVersion BinaryMappedObject<Type>::read(const BinaryFileMapping &mapping, Type &object)
+{
+    auto deserializer = BinaryBufferDeserializer(mapping.data(), mapping.size());
+    deserializer.readHeader<Type>();
+    return deserializer.read(object, 0);
+}
+
+template <typename Type> inline const Type &BinaryMappedObject<Type>::get() const
+{
+    return m_object;
+}
+
+template <typename Type> inline const Type &BinaryMappedObject<Type>::operator*() const
+{
+    return m_object;
+}
+
+template <typename Type> inline const Type *BinaryMappedObject<Type>::operator->() const
+{
+    return &m_object;
+}
+
+/*!
+ * \brief Returns the version read from the mapped data (or 0 if \tparam Type is not versioned).
+ */
+template <typename Type> inline BinaryVersion BinaryMappedObject<Type>::version() const
+{
+    return m_version;
+}
+
+template <typename Type> inline const BinaryFileMapping &BinaryMappedObject<Type>::mapping() const
+{
+    return m_mapping;
+}
+#endif
+
+} // namespace BinaryReflector
+} // namespace ReflectiveRapidJSON
+
+#endif // REFLECTIVE_RAPIDJSON_BINARY_MAPPING_H
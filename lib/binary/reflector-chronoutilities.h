@@ -16,6 +16,9 @@
 namespace ReflectiveRapidJSON {
 namespace BinaryReflector {
 
+template <> struct BinaryFixedSize<CppUtilities::DateTime> : public std::integral_constant<std::size_t, sizeof(std::uint64_t)> {};
+template <> struct BinaryFixedSize<CppUtilities::TimeSpan> : public std::integral_constant<std::size_t, sizeof(std::int64_t)> {};
+
 template <>
 inline BinaryVersion readCustomType<CppUtilities::DateTime>(BinaryDeserializer &deserializer, CppUtilities::DateTime &dateTime, BinaryVersion version)
 {
@@ -46,6 +49,38 @@ inline void writeCustomType<CppUtilities::TimeSpan>(BinarySerializer &serializer
     serializer.write(timeSpan.totalTicks());
 }
 
+template <>
+inline BinaryVersion readCustomType<CppUtilities::DateTime>(
+    BinaryBufferDeserializer &deserializer, CppUtilities::DateTime &dateTime, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    deserializer.read(dateTime.ticks());
+    return 0;
+}
+
+template <>
+inline void writeCustomType<CppUtilities::DateTime>(BinaryBufferSerializer &serializer, const CppUtilities::DateTime &dateTime, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    serializer.write(dateTime.totalTicks());
+}
+
+template <>
+inline BinaryVersion readCustomType<CppUtilities::TimeSpan>(
+    BinaryBufferDeserializer &deserializer, CppUtilities::TimeSpan &timeSpan, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    deserializer.read(timeSpan.ticks());
+    return 0;
+}
+
+template <>
+inline void writeCustomType<CppUtilities::TimeSpan>(BinaryBufferSerializer &serializer, const CppUtilities::TimeSpan &timeSpan, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    serializer.write(timeSpan.totalTicks());
+}
+
 } // namespace BinaryReflector
 } // namespace ReflectiveRapidJSON
 
@@ -10,16 +10,33 @@
 #include "../traits.h"
 #include "../versioning.h"
 
+#include <c++utilities/conversion/binaryconversion.h>
 #include <c++utilities/conversion/conversionexception.h>
 #include <c++utilities/io/binaryreader.h>
 #include <c++utilities/io/binarywriter.h>
 
-#include <any>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <istream>
 #include <limits>
 #include <memory>
 #include <optional>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 
 /// \cond
 class BinaryReflectorTests;
@@ -35,6 +52,44 @@ template <typename T> struct AdaptedBinarySerializable : public Traits::Bool<fal
     static constexpr const char *qualifiedName = "ReflectiveRapidJSON::AdaptedBinarySerializable";
 };
 
+/*!
+ * \brief The SkippableBinaryRecord class allows serializing versioned custom types as length-prefixed records.
+ *
+ * The members of such types are prefixed with their size (following the version). So readers can skip members added by
+ * newer versions they do not know instead of throwing VersionNotSupported. Use REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD
+ * to enable this for a type.
+ *
+ * \remarks
+ * - Only has an effect for versioned types using the generated (de)serialization code.
+ * - Enabling this changes the binary format of the type so it must be enabled before newer versions are rolled out.
+ * - Newer versions may only add members at the end (using as_of_version) for older readers to skip them.
+ * - Shared pointers are only known to readers after reading their first occurrence. If it is within the skipped part of a
+ *   record, further occurrences can not be resolved and lead to a CppUtilities::ConversionException. So members added
+ *   by newer versions must not contain the first occurrence of shared pointers referenced after the record.
+ */
+template <typename T> struct SkippableBinaryRecord : public Traits::Bool<false> {};
+
+#define REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD(T)                                                                                             \
+    template <> struct SkippableBinaryRecord<T> : public Traits::Bool<true> {}
+
+/*!
+ * \brief The PackedBinaryIntegers class allows serializing containers of integers with as few bytes per element as possible.
+ *
+ * Use REFLECTIVE_RAPIDJSON_PACKED_BINARY_INTEGERS to enable this for a container type. To enable it only for certain members,
+ * declare a distinct type for them (e.g. a struct deriving from std::vector<std::uint64_t>).
+ *
+ * \remarks
+ * - Supported for contiguous containers (e.g. std::vector and std::array) of integers with 2, 4 or 8 bytes.
+ * - The number of elements is followed by one control byte per four elements and the data of the elements (see
+ *   Detail::PackedIntegers). Small values take only one byte; signed values are zigzag-encoded so small negative values
+ *   are small as well.
+ * - Enabling this changes the binary format of the type.
+ */
+template <typename T> struct PackedBinaryIntegers : public Traits::Bool<false> {};
+
+#define REFLECTIVE_RAPIDJSON_PACKED_BINARY_INTEGERS(T)                                                                                              \
+    template <> struct PackedBinaryIntegers<T> : public Traits::Bool<true> {}
+
 using BinaryVersion = std::uint64_t;
 template <typename Type, BinaryVersion v = 0> struct BinarySerializable;
 
@@ -51,8 +106,53 @@ using IsBuiltInType = Traits::Any<Traits::IsAnyOf<Type, char, std::uint8_t, bool
     IsVariant<Type>>;
 template <typename Type> using IsCustomType = Traits::Not<IsBuiltInType<Type>>;
 
+/// \brief The BinaryByteOrder enum specifies the byte order of arithmetic values in binary data.
+/// \remarks Lengths, variable-length integers, versions and pointer IDs are not affected by the byte order.
+enum class BinaryByteOrder : std::uint8_t {
+    BigEndian, /**< big-endian (the default and the only byte order supported without header) */
+    LittleEndian, /**< little-endian */
+#ifdef CONVERSION_UTILITIES_IS_BYTE_ORDER_LITTLE_ENDIAN
+    Native = LittleEndian, /**< the byte order of the host (so no conversion is required) */
+#else
+    Native = BigEndian, /**< the byte order of the host (so no conversion is required) */
+#endif
+};
+
+/// \brief The BinaryHeader struct describes the optional header which records the format of the subsequent binary data.
+/// \remarks
+/// - The header consists of the magic bytes, the format revision and the byte order (one byte each). It is written via
+///   writeHeader() and read via readHeader() which also switches the (de)serializer to the recorded byte order.
+/// - As of revision 2, the header may additionally record the schema (see BinaryStreamSchema) as fingerprint (8 bytes,
+///   big-endian) followed by the version (variable-length integer). It is written via writeHeader<Type>().
+struct BinaryHeader {
+    static constexpr char magic[4] = { 'R', 'R', 'J', 'B' };
+    static constexpr std::uint8_t revision = 2;
+    static constexpr std::uint8_t revisionWithoutSchema = 1;
+    static constexpr std::size_t size = sizeof(magic) + 2;
+};
+
+/// \brief The BinarySchemaFingerprint class provides a fingerprint of the structure of \tparam Type or 0 if there is none.
+/// \remarks The code generator provides specializations computed from the version of the class and the names, types,
+///          order and version markers of its members and base classes. The fingerprints of nested custom types (also within
+///          containers, optionals and pointers) are folded in so the fingerprint changes if any of them changes.
+template <typename Type> struct BinarySchemaFingerprint : public std::integral_constant<std::uint64_t, 0> {};
+
+/// \brief The BinaryStreamSchema struct holds the schema recorded in the header of binary data (see BinaryHeader).
+/// \remarks
+/// - If a version is recorded, all versioned objects are written in that version and without prepending it to each object.
+/// - If the fingerprint matches the type a deserializer expects (see readHeader<Type>()), the schema is verified and the
+///   versions are not checked anymore as writer and reader agree on the layout.
+struct BinaryStreamSchema {
+    std::uint64_t fingerprint = 0; /**< the fingerprint of the type the data was written for or 0 if none was recorded */
+    BinaryVersion version = 0; /**< the version of all versioned objects or 0 if the version is prepended to each object */
+    bool verified = false; /**< whether the fingerprint matches the type expected by the deserializer */
+};
+
 class BinaryDeserializer;
 class BinarySerializer;
+class BinarySizeCalculator;
+class BinaryBufferDeserializer;
+class BinaryBufferSerializer;
 
 /// \brief Reads \a customType via \a deserializer.
 /// \remarks
@@ -69,67 +169,1621 @@ BinaryVersion readCustomType(BinaryDeserializer &deserializer, Type &customType,
 template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr>
 void writeCustomType(BinarySerializer &serializer, const Type &customType, BinaryVersion version = 0);
 
-/// \brief The BinaryDeserializer class can read various data types, including custom ones, from an std::istream.
-class BinaryDeserializer : public CppUtilities::BinaryReader {
-    friend class ::BinaryReflectorTests;
+/// \brief Reads \a customType via \a deserializer from a contiguous buffer.
+/// \remarks
+/// - The code generator provides specializations mirroring the generated readCustomType() functions.
+/// - Without specialization, \a customType is read via readCustomType() from a stream over the remaining buffer.
+///   Shared pointers within \a customType are resolved via the pointers \a deserializer has read so far in this case.
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr>
+BinaryVersion readCustomType(BinaryBufferDeserializer &deserializer, Type &customType, BinaryVersion version = 0);
+
+/// \brief The BinaryFieldMask type selects members to read via readCustomTypeProjected() (one bit per member).
+using BinaryFieldMask = std::uint64_t;
+
+/// \brief The BinaryFields class provides the bits within BinaryFieldMask selecting the members of \tparam Type.
+/// \remarks The code generator provides specializations with a constant named after each of the first 64 members.
+template <typename Type> struct BinaryFields;
+
+/// \brief Reads the members of \a customType selected via \a fields from \a deserializer skipping all other members.
+/// \remarks
+/// - The code generator provides specializations mirroring the generated readCustomType() functions.
+/// - Without specialization, all members are read via readCustomType().
+/// - Members of base classes and members beyond the first 64 are always read unless \a fields selects no members at all.
+/// - Skippable records (see SkippableBinaryRecord) are skipped as a whole via their length if \a fields selects no members.
+/// - Skipped members are not decoded but bypassed via BinaryBufferDeserializer::skipValue().
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr>
+BinaryVersion readCustomTypeProjected(BinaryBufferDeserializer &deserializer, Type &customType, BinaryFieldMask fields, BinaryVersion version = 0);
+
+/// \brief Writes \a customType via \a serializer to a contiguous buffer.
+/// \remarks
+/// - The code generator provides specializations mirroring the generated writeCustomType() functions.
+/// - Without specialization, \a customType is written via writeCustomType() to a stream appending to the buffer.
+///   Shared pointers within \a customType are assigned IDs continuing the ones assigned by \a serializer in this case.
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr>
+void writeCustomType(BinaryBufferSerializer &serializer, const Type &customType, BinaryVersion version = 0);
+
+/// \brief Adds the number of bytes writeCustomType() would write for \a customType to \a calculator.
+/// \remarks
+/// - The code generator provides specializations mirroring the generated writeCustomType() functions.
+/// - Without specialization, \a customType is written via writeCustomType() to a stream which merely counts the bytes.
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr>
+void measureCustomType(BinarySizeCalculator &calculator, const Type &customType, BinaryVersion version = 0);
+
+/// \brief The BinaryFixedSize class provides the number of bytes values of \tparam Type always take or 0 if the size varies.
+/// \remarks The code generator provides specializations for custom types which only consist of members with a fixed size.
+template <typename Type, typename = void> struct BinaryFixedSize : public std::integral_constant<std::size_t, 0> {};
+
+/// \brief The BinaryFixedSizeOf class provides the sum of the fixed sizes of \tparam Types or 0 if any of them has no fixed size.
+template <typename... Types>
+struct BinaryFixedSizeOf
+    : public std::integral_constant<std::size_t, ((BinaryFixedSize<Types>::value && ...) ? (BinaryFixedSize<Types>::value + ... + 0) : 0)> {};
+
+/// \brief The BinaryFixedSizeOfCustomType class provides the fixed size of a custom type consisting of \tparam MemberTypes.
+/// \remarks Versioned custom types have no fixed size as the version is prepended as variable-length integer.
+template <typename VersioningType, typename... MemberTypes>
+struct BinaryFixedSizeOfCustomType
+    : public std::integral_constant<std::size_t, VersioningType::enabled ? 0 : BinaryFixedSizeOf<MemberTypes...>::value> {};
+
+template <typename Type>
+struct BinaryFixedSize<Type, std::enable_if_t<std::is_arithmetic_v<Type>>>
+    : public std::integral_constant<std::size_t, std::is_same_v<Type, bool> ? 1 : sizeof(Type)> {};
+template <typename Type>
+struct BinaryFixedSize<Type, std::enable_if_t<std::is_enum_v<Type>>> : public BinaryFixedSize<std::underlying_type_t<Type>> {};
+template <typename First, typename Second> struct BinaryFixedSize<std::pair<First, Second>> : public BinaryFixedSizeOf<First, Second> {};
+
+/// \cond
+namespace Detail {
+/// \brief Returns the number of bytes BinaryWriter::writeVariableLengthUIntBE() uses for the specified \a value.
+constexpr std::size_t variableLengthUIntSize(std::uint64_t value)
+{
+    auto size = std::size_t(1);
+    for (auto bound = std::uint64_t(0x80); size < 8 && value >= bound; bound <<= 7) {
+        ++size;
+    }
+    return size;
+}
+
+/// \brief The IsBulkSerializable class checks whether \tparam Type is a contiguous container of arithmetic values (except bool).
+/// \remarks The elements of such containers are (de)serialized as one block instead of one by one. The wire format is the same.
+template <typename Type> struct IsBulkSerializable : public Traits::Bool<false> {};
+template <typename Element, typename Allocator>
+struct IsBulkSerializable<std::vector<Element, Allocator>> : public Traits::Bool<std::is_arithmetic_v<Element> && !std::is_same_v<Element, bool>> {};
+template <typename Element, std::size_t size>
+struct IsBulkSerializable<std::array<Element, size>> : public Traits::Bool<std::is_arithmetic_v<Element> && !std::is_same_v<Element, bool>> {};
+
+/// \brief Reverses the byte order of \a count values of \tparam elementSize bytes at \a data in place.
+/// \remarks The loop is kept simple so the compiler can vectorize it.
+template <std::size_t elementSize> inline void swapByteOrder(char *data, std::size_t count)
+{
+    if constexpr (elementSize > 1) {
+        using UInt = std::conditional_t<elementSize == 2, std::uint16_t, std::conditional_t<elementSize == 4, std::uint32_t, std::uint64_t>>;
+        static_assert(sizeof(UInt) == elementSize, "type has unsupported size");
+        for (const auto *const end = data + count * elementSize; data != end; data += elementSize) {
+            auto value = UInt();
+            std::memcpy(&value, data, elementSize);
+            value = CppUtilities::swapOrder(value);
+            std::memcpy(data, &value, elementSize);
+        }
+    } else {
+        CPP_UTILITIES_UNUSED(data)
+        CPP_UTILITIES_UNUSED(count)
+    }
+}
+
+/// \brief Converts \a count values of \tparam elementSize bytes at \a data between host byte order and \a byteOrder in place.
+template <std::size_t elementSize> inline void convertByteOrder(char *data, std::size_t count, BinaryByteOrder byteOrder)
+{
+    if (byteOrder != BinaryByteOrder::Native) {
+        swapByteOrder<elementSize>(data, count);
+    }
+}
+
+/// \brief Returns the value of \tparam Type stored at \a data in the specified \a byteOrder.
+template <typename Type> inline Type readValue(const char *data, BinaryByteOrder byteOrder)
+{
+    char buffer[sizeof(Type)];
+    std::memcpy(buffer, data, sizeof(Type));
+    convertByteOrder<sizeof(Type)>(buffer, 1, byteOrder);
+    auto value = Type();
+    std::memcpy(&value, buffer, sizeof(Type));
+    return value;
+}
+
+/// \brief Stores the specified \a value at \a data (which must have the size of \tparam Type) in the specified \a byteOrder.
+template <typename Type> inline void writeValue(Type value, char *data, BinaryByteOrder byteOrder)
+{
+    std::memcpy(data, &value, sizeof(Type));
+    convertByteOrder<sizeof(Type)>(data, 1, byteOrder);
+}
+
+/// \brief Passes \a count \a elements as block in the specified \a byteOrder to \a writeBytes.
+/// \remarks If the byte order needs to be converted, the elements are converted chunk-wise via a buffer on the stack.
+template <typename Element, typename WriteBytes>
+void writeBlock(const Element *elements, std::size_t count, BinaryByteOrder byteOrder, WriteBytes &&writeBytes)
+{
+    if (!count) {
+        return;
+    }
+    const auto *data = reinterpret_cast<const char *>(elements);
+    if (sizeof(Element) == 1 || byteOrder == BinaryByteOrder::Native) {
+        writeBytes(data, count * sizeof(Element));
+        return;
+    }
+    constexpr auto chunkSize = std::size_t(4096) / sizeof(Element);
+    char buffer[chunkSize * sizeof(Element)];
+    while (count) {
+        const auto elementsInChunk = std::min(count, chunkSize);
+        std::memcpy(buffer, data, elementsInChunk * sizeof(Element));
+        swapByteOrder<sizeof(Element)>(buffer, elementsInChunk);
+        writeBytes(buffer, elementsInChunk * sizeof(Element));
+        data += elementsInChunk * sizeof(Element);
+        count -= elementsInChunk;
+    }
+}
+
+/// \brief Returns the number of bytes an element of \tparam elementSize bytes takes within packed integers for the specified \a code.
+template <std::size_t elementSize> constexpr std::size_t packedIntegerLength(unsigned int code)
+{
+    return elementSize == 8 ? (std::size_t(1) << code) : std::min<std::size_t>(code + 1, elementSize);
+}
+
+/// \brief Returns the number of data bytes of four elements of \tparam elementSize bytes for each control byte.
+template <std::size_t elementSize> constexpr std::array<std::uint8_t, 256> makePackedIntegerDataSizes()
+{
+    auto sizes = std::array<std::uint8_t, 256>();
+    for (auto control = std::size_t(); control != sizes.size(); ++control) {
+        for (auto i = 0u; i != 4; ++i) {
+            sizes[control] = static_cast<std::uint8_t>(sizes[control] + packedIntegerLength<elementSize>((control >> (2 * i)) & 0x3));
+        }
+    }
+    return sizes;
+}
+
+/// \brief The number of data bytes of four elements of \tparam elementSize bytes for each control byte.
+template <std::size_t elementSize> inline constexpr auto packedIntegerDataSizes = makePackedIntegerDataSizes<elementSize>();
+
+#ifdef __SSSE3__
+/// \brief Returns the masks for _mm_shuffle_epi8() to expand the data of four elements of 4 bytes for each control byte.
+constexpr std::array<std::array<char, 16>, 256> makePackedIntegerShuffleMasks()
+{
+    auto masks = std::array<std::array<char, 16>, 256>();
+    for (auto control = std::size_t(); control != masks.size(); ++control) {
+        auto offset = std::size_t();
+        for (auto i = std::size_t(); i != 4; ++i) {
+            const auto length = packedIntegerLength<4>((control >> (2 * i)) & 0x3);
+            for (auto byte = std::size_t(); byte != 4; ++byte) {
+                masks[control][i * 4 + byte] = byte < length ? static_cast<char>(offset + byte) : static_cast<char>(-1);
+            }
+            offset += length;
+        }
+    }
+    return masks;
+}
+
+/// \brief The masks for _mm_shuffle_epi8() to expand the data of four elements of 4 bytes for each control byte.
+inline constexpr auto packedIntegerShuffleMasks = makePackedIntegerShuffleMasks();
+#endif
+
+/*!
+ * \brief The PackedIntegers class implements the encoding of containers enabled via PackedBinaryIntegers.
+ *
+ * The encoding follows Stream VByte: Control bytes with 2-bit codes (starting with the least significant bits) denote the
+ * number of bytes of each element (see packedIntegerLength()). The control bytes are followed by the data of all elements
+ * which is stored little-endian without leading zero bytes (regardless of the byte order of the (de)serializer).
+ *
+ * \remarks
+ * - The size of the data is determined from the control bytes via a lookup table so four elements are processed at once.
+ * - If SSSE3 is enabled at compile-time, elements of 4 bytes are decoded four at once via _mm_shuffle_epi8().
+ */
+template <typename Integer> struct PackedIntegers {
+    static_assert(std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>
+            && (sizeof(Integer) == 2 || sizeof(Integer) == 4 || sizeof(Integer) == 8),
+        "only integers of 2, 4 or 8 bytes can be packed");
+    using UInt = std::make_unsigned_t<Integer>;
+
+    /// \brief Returns the number of control bytes for \a count elements.
+    static constexpr std::size_t controlSize(std::size_t count)
+    {
+        return count / 4 + (count % 4 ? 1 : 0);
+    }
+
+    /// \brief Maps \a value to an unsigned integer (zigzag-encoding signed values).
+    static UInt toUnsigned(Integer value)
+    {
+        if constexpr (std::is_signed_v<Integer>) {
+            return static_cast<UInt>(static_cast<UInt>(value) << 1) ^ static_cast<UInt>(value < 0 ? ~UInt() : UInt());
+        } else {
+            return value;
+        }
+    }
+
+    /// \brief Maps the unsigned \a value back to \tparam Integer (reverting toUnsigned()).
+    static Integer fromUnsigned(UInt value)
+    {
+        if constexpr (std::is_signed_v<Integer>) {
+            return static_cast<Integer>(static_cast<UInt>(value >> 1) ^ static_cast<UInt>(value & 1 ? ~UInt() : UInt()));
+        } else {
+            return value;
+        }
+    }
+
+    /// \brief Returns the code denoting the number of bytes required for the specified unsigned \a value.
+    static unsigned int code(UInt value)
+    {
+        auto code = 0u;
+        for (; packedIntegerLength<sizeof(Integer)>(code) < sizeof(Integer) && (value >> (8 * packedIntegerLength<sizeof(Integer)>(code))); ++code)
+            ;
+        return code;
+    }
+
+    /// \brief Returns the number of bytes the control bytes and data of the specified \a values take.
+    static std::size_t size(const Integer *values, std::size_t count)
+    {
+        auto size = controlSize(count);
+        for (const auto *const end = values + count; values != end; ++values) {
+            size += packedIntegerLength<sizeof(Integer)>(code(toUnsigned(*values)));
+        }
+        return size;
+    }
+
+    /// \brief Returns the number of data bytes denoted by the control bytes of \a count elements at \a control.
+    static std::size_t dataSize(const char *control, std::size_t count)
+    {
+        auto size = std::size_t();
+        for (const auto *const end = control + count / 4; control != end; ++control) {
+            size += packedIntegerDataSizes<sizeof(Integer)>[static_cast<std::uint8_t>(*control)];
+        }
+        for (auto i = 0u, remaining = static_cast<unsigned int>(count % 4); i != remaining; ++i) {
+            size += packedIntegerLength<sizeof(Integer)>((static_cast<std::uint8_t>(*control) >> (2 * i)) & 0x3);
+        }
+        return size;
+    }
+
+    /// \brief Passes the control bytes and data of the specified \a values to \a writeBytes.
+    template <typename WriteBytes> static void write(const Integer *values, std::size_t count, WriteBytes &&writeBytes)
+    {
+        if (!count) {
+            return;
+        }
+        auto buffer = std::string(controlSize(count) + count * sizeof(Integer), '\0');
+        auto *control = buffer.data();
+        auto *data = control + controlSize(count);
+        for (auto i = std::size_t(); i != count; ++i) {
+            const auto value = toUnsigned(values[i]);
+            const auto valueCode = code(value);
+            control[i / 4] = static_cast<char>(static_cast<std::uint8_t>(control[i / 4]) | (valueCode << (2 * (i % 4))));
+            for (auto byte = std::size_t(), length = packedIntegerLength<sizeof(Integer)>(valueCode); byte != length; ++byte) {
+                *data++ = static_cast<char>(static_cast<std::uint8_t>(value >> (8 * byte)));
+            }
+        }
+        writeBytes(buffer.data(), static_cast<std::size_t>(data - buffer.data()));
+    }
+
+    /// \brief Decodes \a count elements from the specified \a control bytes and \a data (of \a dataSize bytes) into \a values.
+    /// \remarks The size of \a data must match dataSize().
+    static void read(const char *control, const char *data, std::size_t dataSize, Integer *values, std::size_t count)
+    {
+        const auto *const dataEnd = data + dataSize;
+#ifdef __SSSE3__
+        if constexpr (sizeof(Integer) == 4) {
+            // decode four elements at once as long as 16 bytes can be loaded
+            for (; count >= 4 && dataEnd - data >= 16; count -= 4, values += 4, ++control) {
+                const auto controlByte = static_cast<std::uint8_t>(*control);
+                const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+                const auto mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(packedIntegerShuffleMasks[controlByte].data()));
+                auto decoded = _mm_shuffle_epi8(input, mask);
+                if constexpr (std::is_signed_v<Integer>) {
+                    const auto sign = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(decoded, _mm_set1_epi32(1)));
+                    decoded = _mm_xor_si128(_mm_srli_epi32(decoded, 1), sign);
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(values), decoded);
+                data += packedIntegerDataSizes<4>[controlByte];
+            }
+        }
+#endif
+        CPP_UTILITIES_UNUSED(dataEnd)
+        for (auto i = std::size_t(); i != count; ++i) {
+            const auto length = packedIntegerLength<sizeof(Integer)>((static_cast<std::uint8_t>(control[i / 4]) >> (2 * (i % 4))) & 0x3);
+            auto value = UInt();
+            for (auto byte = std::size_t(); byte != length; ++byte) {
+                value = static_cast<UInt>(value | static_cast<UInt>(static_cast<UInt>(static_cast<std::uint8_t>(data[byte])) << (8 * byte)));
+            }
+            values[i] = fromUnsigned(value);
+            data += length;
+        }
+    }
+};
 
+/// \brief The type tag used by SharedPointerTable to check whether a pointer is referenced via the type it has been read as.
+template <typename Type> inline constexpr char sharedPointerTypeTag = 0;
+
+/// \brief The SharedPointerTable class keeps track of the shared pointers read so far to resolve further occurrences.
+/// \remarks The serializers assign IDs sequentially (in the order pointers are encountered first) so pointers are stored in
+///          a vector indexed by ID. Other IDs (the addresses older versions used as IDs) are stored in a map.
+class SharedPointerTable {
 public:
-    explicit BinaryDeserializer(std::istream *stream);
+    template <typename Type> void add(std::uint64_t id, const std::shared_ptr<Type> &pointer);
+    template <typename Type> std::shared_ptr<Type> get(std::uint64_t id) const;
 
-    using CppUtilities::BinaryReader::read;
-    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> * = nullptr> void read(Type &pair);
-    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::unique_ptr>> * = nullptr> void read(Type &pointer);
+private:
+    struct Entry {
+        std::shared_ptr<void> pointer;
+        const void *typeTag = nullptr;
+    };
+
+    std::vector<Entry> m_entries;
+    std::unordered_map<std::uint64_t, Entry> m_otherEntries;
+};
+
+/// \brief Adds the specified \a pointer read with the specified \a id.
+/// \throws Throws CppUtilities::ConversionException if a pointer with the same \a id has already been added.
+template <typename Type> void SharedPointerTable::add(std::uint64_t id, const std::shared_ptr<Type> &pointer)
+{
+    auto entry = Entry{ pointer, &sharedPointerTypeTag<Type> };
+    if (id == m_entries.size() && (m_otherEntries.empty() || m_otherEntries.find(id) == m_otherEntries.end())) {
+        m_entries.emplace_back(std::move(entry));
+    } else if (id < m_entries.size() || !m_otherEntries.emplace(id, std::move(entry)).second) {
+        throw CppUtilities::ConversionException("Shared pointer ID has already been read");
+    }
+}
+
+/// \brief The SharedPointerIds type holds the IDs serializers have assigned to the shared pointers written so far.
+using SharedPointerIds = std::unordered_map<const void *, std::uint64_t>;
+
+/// \brief The SharedPointerLease class lends the shared pointers tracked by an outer (de)serializer to a nested one.
+/// \remarks The tables are swapped back on destruction so IDs assigned/read by the nested (de)serializer are retained.
+template <typename Table> class SharedPointerLease {
+public:
+    explicit SharedPointerLease(Table &outer, Table &nested)
+        : m_outer(outer)
+        , m_nested(nested)
+    {
+        std::swap(m_outer, m_nested);
+    }
+    ~SharedPointerLease()
+    {
+        std::swap(m_outer, m_nested);
+    }
+    SharedPointerLease(const SharedPointerLease &) = delete;
+    SharedPointerLease &operator=(const SharedPointerLease &) = delete;
+
+private:
+    Table &m_outer;
+    Table &m_nested;
+};
+
+/// \brief Returns the pointer previously added with the specified \a id.
+/// \throws Throws CppUtilities::ConversionException if there is no such pointer or it has been added with another type.
+template <typename Type> std::shared_ptr<Type> SharedPointerTable::get(std::uint64_t id) const
+{
+    const Entry *entry = nullptr;
+    if (id < m_entries.size()) {
+        entry = &m_entries[id];
+    } else if (const auto i = m_otherEntries.find(id); i != m_otherEntries.end()) {
+        entry = &i->second;
+    }
+    if (!entry || !entry->typeTag) {
+        throw CppUtilities::ConversionException("Referenced pointer has not been read before");
+    }
+    if (entry->typeTag != &sharedPointerTypeTag<Type>) {
+        throw CppUtilities::ConversionException("Referenced pointer type does not match");
+    }
+    return std::static_pointer_cast<Type>(entry->pointer);
+}
+
+/// \brief Returns the byte order recorded in the specified \a header (which must have the size of BinaryHeader).
+/// \throws Throws CppUtilities::ConversionException if \a header is not a valid header or the revision is not supported.
+inline BinaryByteOrder parseHeader(const char *header)
+{
+    if (std::memcmp(header, BinaryHeader::magic, sizeof(BinaryHeader::magic))) {
+        throw CppUtilities::ConversionException("Binary data does not start with a header");
+    }
+    if (static_cast<std::uint8_t>(header[sizeof(BinaryHeader::magic)]) > BinaryHeader::revision) {
+        throw CppUtilities::ConversionException("Revision of binary format is not supported");
+    }
+    switch (const auto byteOrder = static_cast<BinaryByteOrder>(header[sizeof(BinaryHeader::magic) + 1])) {
+    case BinaryByteOrder::BigEndian:
+    case BinaryByteOrder::LittleEndian:
+        return byteOrder;
+    default:
+        throw CppUtilities::ConversionException("Byte order of binary data is not supported");
+    }
+}
+
+/// \brief Returns whether the specified \a header (which must have the size of BinaryHeader) is followed by a schema.
+inline bool hasSchema(const char *header)
+{
+    return static_cast<std::uint8_t>(header[sizeof(BinaryHeader::magic)]) > BinaryHeader::revisionWithoutSchema;
+}
+
+/// \brief Returns the schema to record for \tparam Type (see BinaryReflector::BinarySerializer::writeHeader<Type>()).
+template <typename Type> constexpr BinaryStreamSchema schemaOf()
+{
+    auto schema = BinaryStreamSchema();
+    schema.fingerprint = BinarySchemaFingerprint<Type>::value;
+    if constexpr (Versioning<Type>::enabled) {
+        schema.version = Versioning<Type>::serializationDefault;
+    }
+    return schema;
+}
+
+/// \brief The InputBufferStreamBuffer class is a stream buffer which reads from a buffer of a fixed size.
+class InputBufferStreamBuffer : public std::streambuf {
+public:
+    explicit InputBufferStreamBuffer(const char *buffer, std::size_t size)
+    {
+        auto *const begin = const_cast<char *>(buffer);
+        setg(begin, begin, begin + size);
+    }
+    std::size_t bytesRead() const
+    {
+        return static_cast<std::size_t>(gptr() - eback());
+    }
+};
+
+/// \brief The RecordStreamBuffer class is a stream buffer which reads a record of a fixed size from another stream buffer.
+/// \remarks
+/// - The record is not copied upfront. It is read from the other stream buffer as needed without reading beyond its end.
+/// - The size is not trusted as nothing is allocated based on it.
+class RecordStreamBuffer : public std::streambuf {
+public:
+    explicit RecordStreamBuffer(std::streambuf *source, std::uint64_t size)
+        : m_source(source)
+        , m_remaining(size)
+    {
+    }
+
+    /// \brief Skips the part of the record which has not been read yet.
+    /// \returns Returns whether the other stream buffer contained the whole record.
+    bool skipRemaining()
+    {
+        setg(m_buffer, m_buffer, m_buffer);
+        while (m_remaining) {
+            const auto count = m_source->sgetn(m_buffer, static_cast<std::streamsize>(std::min<std::uint64_t>(m_remaining, sizeof(m_buffer))));
+            if (count <= 0) {
+                return false;
+            }
+            m_remaining -= static_cast<std::uint64_t>(count);
+        }
+        return true;
+    }
+
+protected:
+    int_type underflow() override
+    {
+        if (gptr() == egptr()) {
+            const auto count = readFromSource(m_buffer, static_cast<std::streamsize>(sizeof(m_buffer)));
+            setg(m_buffer, m_buffer, m_buffer + count);
+        }
+        return gptr() == egptr() ? traits_type::eof() : traits_type::to_int_type(*gptr());
+    }
+    std::streamsize xsgetn(char *chars, std::streamsize count) override
+    {
+        // take buffered characters first and read further characters directly into the destination
+        const auto buffered = std::min<std::streamsize>(egptr() - gptr(), count);
+        if (buffered) {
+            std::memcpy(chars, gptr(), static_cast<std::size_t>(buffered));
+            gbump(static_cast<int>(buffered));
+        }
+        return buffered + readFromSource(chars + buffered, count - buffered);
+    }
+
+private:
+    std::streamsize readFromSource(char *chars, std::streamsize count)
+    {
+        const auto limit = static_cast<std::streamsize>(std::min<std::uint64_t>(m_remaining, static_cast<std::uint64_t>(count)));
+        const auto read = limit ? m_source->sgetn(chars, limit) : std::streamsize();
+        m_remaining -= static_cast<std::uint64_t>(std::max<std::streamsize>(read, 0));
+        return std::max<std::streamsize>(read, 0);
+    }
+
+    std::streambuf *m_source;
+    std::uint64_t m_remaining;
+    char m_buffer[256];
+};
+
+/// \brief The InputRecord struct holds a length-prefixed record read by BinaryDeserializer::beginRecord().
+struct InputRecord {
+    explicit InputRecord(std::streambuf *source, std::uint64_t size, std::ios_base::iostate exceptions)
+        : buffer(source, size)
+        , stream(&buffer)
+    {
+        stream.exceptions(exceptions);
+    }
+
+    RecordStreamBuffer buffer;
+    std::istream stream;
+};
+} // namespace Detail
+/// \endcond
+
+namespace Detail {
+/// \brief The BinaryDeserializerBase class provides the functions BinaryDeserializer and BinaryBufferDeserializer share.
+/// \remarks \tparam Deserializer is the deriving class which must provide readByte(), readUInt64BE(), readVariableLengthUIntBE()
+///          and read().
+template <typename Deserializer> class BinaryDeserializerBase {
+public:
     template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::shared_ptr>> * = nullptr> void read(Type &pointer);
-    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::optional>> * = nullptr> void read(Type &pointer);
-    template <typename Type, Traits::EnableIf<IsArray<Type>, Traits::IsResizable<Type>> * = nullptr> void read(Type &iteratable);
-    template <typename Type, Traits::EnableIfAny<IsMapOrHash<Type>, IsMultiMapOrHash<Type>> * = nullptr> void read(Type &iteratable);
-    template <typename Type,
-        Traits::EnableIf<IsIteratableExceptString<Type>,
-            Traits::None<IsMapOrHash<Type>, IsMultiMapOrHash<Type>, Traits::All<IsArray<Type>, Traits::IsResizable<Type>>>> * = nullptr>
-    void read(Type &iteratable);
-    template <typename Type, Traits::EnableIf<std::is_enum<Type>> * = nullptr> void read(Type &enumValue);
-    template <typename Type, Traits::EnableIf<IsVariant<Type>> * = nullptr> void read(Type &variant);
-    template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> * = nullptr> BinaryVersion read(Type &builtInType, BinaryVersion version);
-    template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr> BinaryVersion read(Type &customType, BinaryVersion version = 0);
+    BinaryByteOrder readHeader();
+    template <typename Type> BinaryByteOrder readHeader();
+    BinaryByteOrder byteOrder() const;
+    void setByteOrder(BinaryByteOrder byteOrder);
+    const BinaryStreamSchema &schema() const;
+    void setSchema(const BinaryStreamSchema &schema);
+    bool readVersion(BinaryVersion &version);
+    SharedPointerTable &sharedPointers();
+
+protected:
+    explicit BinaryDeserializerBase() = default;
+    template <typename Type> static void unpack(const char *control, const char *data, std::size_t dataSize, Type &iteratable, std::uint64_t size);
+
+    SharedPointerTable m_pointer;
+    BinaryByteOrder m_byteOrder = BinaryByteOrder::BigEndian;
+    BinaryStreamSchema m_schema;
+
+private:
+    Deserializer &deserializer();
+};
+
+/// \brief The BinarySerializerBase class provides the functions BinarySerializer, BinaryBufferSerializer and BinarySizeCalculator share.
+/// \remarks \tparam Serializer is the deriving class which must provide writeByte(), writeUInt64BE(), writeVariableLengthUIntBE()
+///          and write().
+template <typename Serializer> class BinarySerializerBase {
+public:
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::shared_ptr>> * = nullptr> void write(const Type &pointer);
+    void writeHeader(BinaryByteOrder byteOrder = BinaryByteOrder::Native);
+    template <typename Type> void writeHeader(BinaryByteOrder byteOrder = BinaryByteOrder::Native);
+    BinaryByteOrder byteOrder() const;
+    void setByteOrder(BinaryByteOrder byteOrder);
+    const BinaryStreamSchema &schema() const;
+    void setSchema(const BinaryStreamSchema &schema);
+    template <typename VersioningType> void writeVersion(BinaryVersion &version);
+    SharedPointerIds &sharedPointers();
+
+protected:
+    explicit BinarySerializerBase() = default;
+
+    SharedPointerIds m_pointer;
+    BinaryByteOrder m_byteOrder = BinaryByteOrder::BigEndian;
+    BinaryStreamSchema m_schema;
 
 private:
-    std::unordered_map<std::uint64_t, std::any> m_pointer;
+    void writeHeader(std::uint8_t revision, BinaryByteOrder byteOrder);
+    Serializer &serializer();
 };
 
-/// \brief The BinarySerializer class can write various data types, including custom ones, to an std::ostream.
-class BinarySerializer : public CppUtilities::BinaryWriter {
-    friend class ::BinaryReflectorTests;
+/// \brief Returns the deriving class.
+template <typename Deserializer> inline Deserializer &BinaryDeserializerBase<Deserializer>::deserializer()
+{
+    return static_cast<Deserializer &>(*this);
+}
+
+template <typename Deserializer>
+template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::shared_ptr>> *>
+void BinaryDeserializerBase<Deserializer>::read(Type &pointer)
+{
+    auto mode = deserializer().readByte();
+    if (!mode) {
+        // pointer not set
+        pointer.reset();
+        return;
+    }
+
+    // the 3rd bit being flagged indicates a big ID
+    const auto id = (mode & 0x4) ? deserializer().readUInt64BE() : deserializer().readVariableLengthUIntBE();
+    if ((mode & 0x3) == 1) {
+        // first occurrence: make a new pointer
+        pointer = std::make_shared<typename Type::element_type>();
+        m_pointer.add(id, pointer);
+        deserializer().read(*pointer);
+        return;
+    }
+    // further occurrences: copy previous pointer
+    pointer = m_pointer.template get<typename Type::element_type>(id);
+}
+
+/// \brief Reads the header (see BinaryHeader) and switches to the byte order and schema recorded by it.
+/// \throws Throws CppUtilities::ConversionException if the data does not start with a supported header.
+template <typename Deserializer> BinaryByteOrder BinaryDeserializerBase<Deserializer>::readHeader()
+{
+    char header[BinaryHeader::size];
+    for (auto &c : header) {
+        c = static_cast<char>(deserializer().readByte());
+    }
+    m_byteOrder = parseHeader(header);
+    m_schema = BinaryStreamSchema();
+    if (hasSchema(header)) {
+        m_schema.fingerprint = deserializer().readUInt64BE();
+        m_schema.version = deserializer().readVariableLengthUIntBE();
+    }
+    return m_byteOrder;
+}
+
+/// \brief Reads the header like readHeader() and verifies whether the recorded schema matches \tparam Type.
+/// \remarks If the schema is verified (see BinaryStreamSchema), versions are not checked while reading subsequent objects.
+template <typename Deserializer> template <typename Type> BinaryByteOrder BinaryDeserializerBase<Deserializer>::readHeader()
+{
+    readHeader();
+    m_schema.verified = m_schema.fingerprint && m_schema.fingerprint == BinarySchemaFingerprint<Type>::value;
+    return m_byteOrder;
+}
+
+/// \brief Returns the byte order arithmetic values are read in.
+template <typename Deserializer> inline BinaryByteOrder BinaryDeserializerBase<Deserializer>::byteOrder() const
+{
+    return m_byteOrder;
+}
+
+/// \brief Sets the byte order arithmetic values are read in.
+/// \remarks Usually the byte order is determined via readHeader() instead.
+template <typename Deserializer> inline void BinaryDeserializerBase<Deserializer>::setByteOrder(BinaryByteOrder byteOrder)
+{
+    m_byteOrder = byteOrder;
+}
+
+/// \brief Returns the schema recorded in the header (see BinaryStreamSchema).
+template <typename Deserializer> inline const BinaryStreamSchema &BinaryDeserializerBase<Deserializer>::schema() const
+{
+    return m_schema;
+}
+
+/// \brief Sets the schema.
+/// \remarks Usually the schema is determined via readHeader() instead.
+template <typename Deserializer> inline void BinaryDeserializerBase<Deserializer>::setSchema(const BinaryStreamSchema &schema)
+{
+    m_schema = schema;
+}
+
+/// \brief Reads the version of a versioned object into \a version unless the schema recorded the version for all objects.
+/// \remarks Used by generated code.
+/// \returns Returns whether \a version still needs to be checked which is not the case if the schema has been verified.
+template <typename Deserializer> inline bool BinaryDeserializerBase<Deserializer>::readVersion(BinaryVersion &version)
+{
+    version = m_schema.version ? m_schema.version : deserializer().readVariableLengthUIntBE();
+    return !m_schema.verified;
+}
+
+/// \brief Returns the shared pointers read so far.
+/// \remarks Used to resolve further occurrences read by nested deserializers (see SharedPointerLease).
+template <typename Deserializer> inline SharedPointerTable &BinaryDeserializerBase<Deserializer>::sharedPointers()
+{
+    return m_pointer;
+}
+
+/// \brief Decodes \a size packed integers from \a control and \a data (of \a dataSize bytes) into \a iteratable (resizing it if possible).
+template <typename Deserializer>
+template <typename Type>
+void BinaryDeserializerBase<Deserializer>::unpack(const char *control, const char *data, std::size_t dataSize, Type &iteratable, std::uint64_t size)
+{
+    if constexpr (Traits::IsResizable<Type>::value) {
+        iteratable.resize(static_cast<std::size_t>(size));
+    } else if (size != iteratable.size()) {
+        throw CppUtilities::ConversionException("Number of elements does not match the size of the array");
+    }
+    PackedIntegers<typename Type::value_type>::read(control, data, dataSize, iteratable.data(), iteratable.size());
+}
+
+/// \brief Returns the deriving class.
+template <typename Serializer> inline Serializer &BinarySerializerBase<Serializer>::serializer()
+{
+    return static_cast<Serializer &>(*this);
+}
+
+template <typename Serializer>
+template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::shared_ptr>> *>
+void BinarySerializerBase<Serializer>::write(const Type &pointer)
+{
+    if (pointer == nullptr) {
+        serializer().writeByte(0);
+        return;
+    }
+    // assign IDs sequentially so they are small and the output does not depend on the memory layout
+    const auto [idOfPointer, firstOccurrence] = m_pointer.emplace(pointer.get(), m_pointer.size());
+    serializer().writeByte(firstOccurrence ? 1 : 2);
+    serializer().writeVariableLengthUIntBE(idOfPointer->second);
+    if (firstOccurrence) {
+        serializer().write(*pointer);
+    }
+}
+
+/// \brief Writes the magic bytes, the specified \a revision and the specified \a byteOrder.
+template <typename Serializer> void BinarySerializerBase<Serializer>::writeHeader(std::uint8_t revision, BinaryByteOrder byteOrder)
+{
+    for (const auto c : BinaryHeader::magic) {
+        serializer().writeByte(static_cast<std::uint8_t>(c));
+    }
+    serializer().writeByte(revision);
+    serializer().writeByte(static_cast<std::uint8_t>(byteOrder));
+    m_byteOrder = byteOrder;
+}
+
+/// \brief Writes the header (see BinaryHeader) and switches to the specified \a byteOrder.
+/// \remarks By default, arithmetic values are subsequently written in the host's byte order so no conversion is required.
+template <typename Serializer> void BinarySerializerBase<Serializer>::writeHeader(BinaryByteOrder byteOrder)
+{
+    writeHeader(BinaryHeader::revisionWithoutSchema, byteOrder);
+    m_schema = BinaryStreamSchema();
+}
+
+/// \brief Writes the header (see BinaryHeader) recording the schema of \tparam Type and switches to the specified \a byteOrder.
+/// \remarks
+/// - If the code generator provided a fingerprint for \tparam Type, the version of \tparam Type is recorded once in the
+///   header and subsequent versioned objects are written in that version without prepending it (versions specified when
+///   writing objects are ignored).
+/// - Otherwise, the same header as via writeHeader() without template argument is written.
+template <typename Serializer> template <typename Type> void BinarySerializerBase<Serializer>::writeHeader(BinaryByteOrder byteOrder)
+{
+    const auto schema = schemaOf<Type>();
+    if (!schema.fingerprint) {
+        writeHeader(byteOrder);
+        return;
+    }
+    writeHeader(BinaryHeader::revision, byteOrder);
+    serializer().writeUInt64BE(schema.fingerprint);
+    serializer().writeVariableLengthUIntBE(schema.version);
+    m_schema = schema;
+}
+
+/// \brief Returns the byte order arithmetic values are written in.
+template <typename Serializer> inline BinaryByteOrder BinarySerializerBase<Serializer>::byteOrder() const
+{
+    return m_byteOrder;
+}
+
+/// \brief Sets the byte order arithmetic values are written in.
+/// \remarks The byte order is not recorded in the data; use writeHeader() to do so.
+template <typename Serializer> inline void BinarySerializerBase<Serializer>::setByteOrder(BinaryByteOrder byteOrder)
+{
+    m_byteOrder = byteOrder;
+}
+
+/// \brief Returns the schema recorded in the header (see BinaryStreamSchema).
+template <typename Serializer> inline const BinaryStreamSchema &BinarySerializerBase<Serializer>::schema() const
+{
+    return m_schema;
+}
+
+/// \brief Sets the schema.
+/// \remarks The schema is not recorded in the data; use writeHeader<Type>() to do so.
+template <typename Serializer> inline void BinarySerializerBase<Serializer>::setSchema(const BinaryStreamSchema &schema)
+{
+    m_schema = schema;
+}
+
+/// \brief Writes \a version (or the default version of \tparam VersioningType) unless the schema recorded the version for all objects.
+/// \remarks Used by generated code. Sets \a version to the version the object is supposed to be written in.
+template <typename Serializer> template <typename VersioningType> inline void BinarySerializerBase<Serializer>::writeVersion(BinaryVersion &version)
+{
+    if (m_schema.version) {
+        version = m_schema.version;
+    } else {
+        serializer().writeVariableLengthUIntBE(VersioningType::applyDefault(version));
+    }
+}
+
+/// \brief Returns the IDs assigned to the shared pointers written so far.
+/// \remarks Used to continue the IDs within nested serializers (see SharedPointerLease).
+template <typename Serializer> inline SharedPointerIds &BinarySerializerBase<Serializer>::sharedPointers()
+{
+    return m_pointer;
+}
+} // namespace Detail
+
+template <typename Element, std::size_t size>
+struct BinaryFixedSize<std::array<Element, size>>
+    : public std::integral_constant<std::size_t,
+          !size ? 1
+                : (BinaryFixedSize<Element>::value && !PackedBinaryIntegers<std::array<Element, size>>::value
+                          ? Detail::variableLengthUIntSize(size) + size * BinaryFixedSize<Element>::value
+                          : 0)> {};
+
+/// \brief The BinaryDeserializer class can read various data types, including custom ones, from an std::istream.
+class BinaryDeserializer : public CppUtilities::BinaryReader, public Detail::BinaryDeserializerBase<BinaryDeserializer> {
+    friend class ::BinaryReflectorTests;
+
+public:
+    explicit BinaryDeserializer(std::istream *stream);
+
+    using CppUtilities::BinaryReader::read;
+    using Detail::BinaryDeserializerBase<BinaryDeserializer>::read;
+    void read(std::int16_t &value);
+    void read(std::uint16_t &value);
+    void read(std::int32_t &value);
+    void read(std::uint32_t &value);
+    void read(std::int64_t &value);
+    void read(std::uint64_t &value);
+    void read(float &value);
+    void read(double &value);
+    /// \brief Borrowed strings (std::string_view) can only be read via BinaryBufferDeserializer.
+    void read(std::string_view &borrowedString) = delete;
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> * = nullptr> void read(Type &pair);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::unique_ptr>> * = nullptr> void read(Type &pointer);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::optional>> * = nullptr> void read(Type &pointer);
+    template <typename Type, Traits::EnableIf<IsArray<Type>, Traits::IsResizable<Type>> * = nullptr> void read(Type &iteratable);
+    template <typename Type, Traits::EnableIfAny<IsMapOrHash<Type>, IsMultiMapOrHash<Type>> * = nullptr> void read(Type &iteratable);
+    template <typename Type,
+        Traits::EnableIf<IsIteratableExceptString<Type>,
+            Traits::None<IsMapOrHash<Type>, IsMultiMapOrHash<Type>, Traits::All<IsArray<Type>, Traits::IsResizable<Type>>>> * = nullptr>
+    void read(Type &iteratable);
+    template <typename Type, Traits::EnableIf<std::is_enum<Type>> * = nullptr> void read(Type &enumValue);
+    template <typename Type, Traits::EnableIf<IsVariant<Type>> * = nullptr> void read(Type &variant);
+    template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> * = nullptr> BinaryVersion read(Type &builtInType, BinaryVersion version);
+    template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr> BinaryVersion read(Type &customType, BinaryVersion version = 0);
+    std::istream *beginRecord(bool skippable);
+    void endRecord(std::istream *outerStream);
+
+private:
+    template <typename Type> void readNumber(Type &value);
+    template <typename Element> void readBlock(Element *elements, std::size_t count);
+    template <typename Type> void readPacked(Type &iteratable, std::uint64_t size);
+
+    std::vector<std::unique_ptr<Detail::InputRecord>> m_records;
+};
+
+/// \brief The BinarySerializer class can write various data types, including custom ones, to an std::ostream.
+class BinarySerializer : public CppUtilities::BinaryWriter, public Detail::BinarySerializerBase<BinarySerializer> {
+    friend class ::BinaryReflectorTests;
+
+public:
+    explicit BinarySerializer(std::ostream *stream);
+
+    using CppUtilities::BinaryWriter::write;
+    using Detail::BinarySerializerBase<BinarySerializer>::write;
+    void write(std::int16_t value);
+    void write(std::uint16_t value);
+    void write(std::int32_t value);
+    void write(std::uint32_t value);
+    void write(std::int64_t value);
+    void write(std::uint64_t value);
+    void write(float value);
+    void write(double value);
+    void write(std::string_view lengthPrefixedString);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> * = nullptr> void write(const Type &pair);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::optional>> * = nullptr>
+    void write(const Type &pointer);
+    template <typename Type, Traits::EnableIf<IsIteratableExceptString<Type>, Traits::HasSize<Type>> * = nullptr> void write(const Type &iteratable);
+    template <typename Type, Traits::EnableIf<std::is_enum<Type>> * = nullptr> void write(const Type &enumValue);
+    template <typename Type, Traits::EnableIf<IsVariant<Type>> * = nullptr> void write(const Type &variant);
+    template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> * = nullptr> void write(const Type &builtInType, BinaryVersion version);
+    template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr> void write(const Type &customType, BinaryVersion version = 0);
+    std::ostream *beginRecord(bool skippable);
+    void endRecord(std::ostream *outerStream);
+
+private:
+    template <typename Type> void writeNumber(Type value);
+
+    std::vector<std::unique_ptr<std::ostringstream>> m_records;
+};
+
+/// \brief The BinarySizeCalculator class determines the number of bytes BinarySerializer writes for various data types.
+/// \remarks
+/// - The interface mirrors BinarySerializer so it can be used by the same (generated) code.
+/// - The size of shared pointers is exact as long as a separate calculator is used for each BinarySerializer.
+class BinarySizeCalculator : public Detail::BinarySerializerBase<BinarySizeCalculator> {
+public:
+    explicit BinarySizeCalculator() = default;
+
+    using Detail::BinarySerializerBase<BinarySizeCalculator>::write;
+
+    void writeByte(std::uint8_t);
+    void writeBool(bool);
+    void writeUInt64BE(std::uint64_t);
+    void writeVariableLengthUIntBE(std::uint64_t value);
+    void write(const std::string &lengthPrefixedString);
+    template <typename Type, Traits::EnableIfAny<std::is_arithmetic<Type>, std::is_enum<Type>> * = nullptr> void write(Type value);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> * = nullptr> void write(const Type &pair);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::optional>> * = nullptr>
+    void write(const Type &pointer);
+    template <typename Type, Traits::EnableIf<IsIteratableExceptString<Type>, Traits::HasSize<Type>> * = nullptr> void write(const Type &iteratable);
+    template <typename Type, Traits::EnableIf<IsVariant<Type>> * = nullptr> void write(const Type &variant);
+    template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> * = nullptr> void write(const Type &builtInType, BinaryVersion version);
+    template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr> void write(const Type &customType, BinaryVersion version = 0);
+    std::optional<std::size_t> beginRecord(bool skippable);
+    void endRecord(std::optional<std::size_t> recordBegin);
+    void add(std::size_t size);
+    std::size_t size() const;
+
+private:
+    std::size_t m_size = 0;
+};
+
+/// \brief The BinaryBufferDeserializer class reads the same data as BinaryDeserializer from a contiguous buffer.
+/// \remarks
+/// - The buffer is accessed directly instead of going through std::istream which avoids the per-field overhead of the
+///   stream layer (virtual calls and checking the stream state).
+/// - The buffer is not copied and must outlive the deserializer.
+/// - Reading beyond the end of the buffer leads to a CppUtilities::ConversionException.
+class BinaryBufferDeserializer : public Detail::BinaryDeserializerBase<BinaryBufferDeserializer> {
+    friend class ::BinaryReflectorTests;
+
+public:
+    explicit BinaryBufferDeserializer(const char *buffer, std::size_t bufferSize);
+
+    using Detail::BinaryDeserializerBase<BinaryBufferDeserializer>::read;
+
+    std::uint8_t readByte();
+    bool readBool();
+    std::uint64_t readUInt64BE();
+    std::uint64_t readVariableLengthUIntBE();
+    void readBytes(char *buffer, std::size_t size);
+    void read(std::string &lengthPrefixedString);
+    void read(std::string_view &borrowedString);
+    template <typename Type, Traits::EnableIf<std::is_arithmetic<Type>> * = nullptr> void read(Type &value);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> * = nullptr> void read(Type &pair);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::unique_ptr>> * = nullptr> void read(Type &pointer);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::optional>> * = nullptr> void read(Type &pointer);
+    template <typename Type, Traits::EnableIf<IsArray<Type>, Traits::IsResizable<Type>> * = nullptr> void read(Type &iteratable);
+    template <typename Type, Traits::EnableIfAny<IsMapOrHash<Type>, IsMultiMapOrHash<Type>> * = nullptr> void read(Type &iteratable);
+    template <typename Type,
+        Traits::EnableIf<IsIteratableExceptString<Type>,
+            Traits::None<IsMapOrHash<Type>, IsMultiMapOrHash<Type>, Traits::All<IsArray<Type>, Traits::IsResizable<Type>>>> * = nullptr>
+    void read(Type &iteratable);
+    template <typename Type, Traits::EnableIf<std::is_enum<Type>> * = nullptr> void read(Type &enumValue);
+    template <typename Type, Traits::EnableIf<IsVariant<Type>> * = nullptr> void read(Type &variant);
+    template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> * = nullptr> BinaryVersion read(Type &builtInType, BinaryVersion version);
+    template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr> BinaryVersion read(Type &customType, BinaryVersion version = 0);
+    template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr>
+    BinaryVersion readProjected(Type &customType, BinaryFieldMask fields, BinaryVersion version = 0);
+    template <typename Type> void readOrSkip(Type &value, bool selected, BinaryVersion version);
+    template <typename Type> void skipValue(BinaryVersion version = 0);
+    const char *beginRecord(bool skippable);
+    void endRecord(const char *outerEnd);
+    void skip(std::size_t size);
+    const char *position() const;
+    std::size_t bytesRemaining() const;
+
+private:
+    const char *take(std::size_t size);
+    template <typename Element> const char *takeBlock(std::uint64_t count);
+    template <typename Element> void readBlock(const char *data, Element *elements, std::size_t count);
+    template <typename Element> const char *takePackedControl(std::uint64_t size);
+    template <typename Type> void readPacked(Type &iteratable, std::uint64_t size);
+    template <typename Variant, std::size_t compiletimeIndex = 0> void skipVariantValueByRuntimeIndex(std::size_t runtimeIndex);
+
+    const char *m_current;
+    const char *m_end;
+};
+
+/// \brief The BinaryBufferSerializer class writes the same data as BinarySerializer to a contiguous buffer.
+/// \remarks
+/// - The buffer is accessed directly instead of going through std::ostream which avoids the per-field overhead of the
+///   stream layer (virtual calls and checking the stream state).
+/// - Either appends to an std::string or writes to a buffer of fixed size. Exceeding the fixed size leads to a
+///   CppUtilities::ConversionException.
+class BinaryBufferSerializer : public Detail::BinarySerializerBase<BinaryBufferSerializer> {
+    friend class ::BinaryReflectorTests;
+
+public:
+    explicit BinaryBufferSerializer(std::string &output);
+    explicit BinaryBufferSerializer(char *buffer, std::size_t bufferSize);
+
+    using Detail::BinarySerializerBase<BinaryBufferSerializer>::write;
+
+    void writeByte(std::uint8_t value);
+    void writeBool(bool value);
+    void writeUInt64BE(std::uint64_t value);
+    void writeVariableLengthUIntBE(std::uint64_t value);
+    void writeBytes(const char *buffer, std::size_t size);
+    void write(const std::string &lengthPrefixedString);
+    void write(std::string_view lengthPrefixedString);
+    template <typename Type, Traits::EnableIf<std::is_arithmetic<Type>> * = nullptr> void write(Type value);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> * = nullptr> void write(const Type &pair);
+    template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::optional>> * = nullptr>
+    void write(const Type &pointer);
+    template <typename Type, Traits::EnableIf<IsIteratableExceptString<Type>, Traits::HasSize<Type>> * = nullptr> void write(const Type &iteratable);
+    template <typename Type, Traits::EnableIf<std::is_enum<Type>> * = nullptr> void write(const Type &enumValue);
+    template <typename Type, Traits::EnableIf<IsVariant<Type>> * = nullptr> void write(const Type &variant);
+    template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> * = nullptr> void write(const Type &builtInType, BinaryVersion version);
+    template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr> void write(const Type &customType, BinaryVersion version = 0);
+    std::optional<std::size_t> beginRecord(bool skippable);
+    void endRecord(std::optional<std::size_t> recordBegin);
+    std::size_t bytesWritten() const;
+
+private:
+    std::string *m_output;
+    char *m_begin;
+    char *m_current;
+    char *m_end;
+    std::size_t m_initialSize;
+};
+
+inline BinaryDeserializer::BinaryDeserializer(std::istream *stream)
+    : CppUtilities::BinaryReader(stream)
+{
+}
+
+/// \brief Reads a multi-byte arithmetic \a value in the byte order set via setByteOrder() or readHeader().
+template <typename Type> inline void BinaryDeserializer::readNumber(Type &value)
+{
+    if (m_byteOrder == BinaryByteOrder::BigEndian) {
+        CppUtilities::BinaryReader::read(value);
+        return;
+    }
+    char buffer[sizeof(Type)];
+    CppUtilities::BinaryReader::read(buffer, sizeof(Type));
+    value = Detail::readValue<Type>(buffer, m_byteOrder);
+}
+
+inline void BinaryDeserializer::read(std::int16_t &value)
+{
+    readNumber(value);
+}
+
+inline void BinaryDeserializer::read(std::uint16_t &value)
+{
+    readNumber(value);
+}
+
+inline void BinaryDeserializer::read(std::int32_t &value)
+{
+    readNumber(value);
+}
+
+inline void BinaryDeserializer::read(std::uint32_t &value)
+{
+    readNumber(value);
+}
+
+inline void BinaryDeserializer::read(std::int64_t &value)
+{
+    readNumber(value);
+}
+
+inline void BinaryDeserializer::read(std::uint64_t &value)
+{
+    readNumber(value);
+}
+
+inline void BinaryDeserializer::read(float &value)
+{
+    readNumber(value);
+}
+
+inline void BinaryDeserializer::read(double &value)
+{
+    readNumber(value);
+}
+
+/// \brief Reads the size of a length-prefixed record if \a skippable is set; otherwise does nothing.
+/// \remarks
+/// - Subsequent reads are limited to the record until endRecord() is called. The record is read from the current stream
+///   as needed (and not copied) so nesting records does not add overhead and the size needs not to be trusted.
+/// - Used by generated code for types enabled via REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD.
+/// \returns Returns the stream to pass to endRecord().
+inline std::istream *BinaryDeserializer::beginRecord(bool skippable)
+{
+    if (!skippable) {
+        return nullptr;
+    }
+    const auto size = readVariableLengthUIntBE();
+    auto *const outerStream = stream();
+    setStream(&m_records.emplace_back(std::make_unique<Detail::InputRecord>(outerStream->rdbuf(), size, outerStream->exceptions()))->stream);
+    return outerStream;
+}
+
+/// \brief Ends the record begun via beginRecord() skipping the part of the record which has not been read.
+/// \remarks Errors which occurred while reading the record are set on \a outerStream as well. Hence the end of the data
+///          being reached within the record leads to an exception if enabled for \a outerStream.
+inline void BinaryDeserializer::endRecord(std::istream *outerStream)
+{
+    if (!outerStream) {
+        return;
+    }
+    setStream(outerStream);
+    const auto record = std::move(m_records.back());
+    m_records.pop_back();
+    const auto state = record->stream.rdstate();
+    outerStream->setstate(record->buffer.skipRemaining() ? state : (state | std::ios_base::eofbit | std::ios_base::failbit));
+}
+
+template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> *> void BinaryDeserializer::read(Type &pair)
+{
+    read(pair.first);
+    read(pair.second);
+}
+
+template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::unique_ptr>> *> void BinaryDeserializer::read(Type &pointer)
+{
+    if (!readBool()) {
+        pointer.reset();
+        return;
+    }
+    pointer = std::make_unique<typename Type::element_type>();
+    read(*pointer);
+}
+
+template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::optional>> *> void BinaryDeserializer::read(Type &opt)
+{
+    if (readBool()) {
+        read(opt.emplace());
+    } else {
+        opt.reset();
+    }
+}
+
+template <typename Type, Traits::EnableIf<IsArray<Type>, Traits::IsResizable<Type>> *> void BinaryDeserializer::read(Type &iteratable)
+{
+    const auto size = readVariableLengthUIntBE();
+    if constexpr (PackedBinaryIntegers<Type>::value) {
+        readPacked(iteratable, size);
+    } else if constexpr (Detail::IsBulkSerializable<Type>::value) {
+        iteratable.resize(size);
+        readBlock(iteratable.data(), iteratable.size());
+    } else {
+        iteratable.resize(size);
+        for (auto &element : iteratable) {
+            read(element);
+        }
+    }
+}
+
+template <typename Type, Traits::EnableIfAny<IsMapOrHash<Type>, IsMultiMapOrHash<Type>> *> void BinaryDeserializer::read(Type &iteratable)
+{
+    const auto size = readVariableLengthUIntBE();
+    for (size_t i = 0; i != size; ++i) {
+        std::pair<typename std::remove_const<typename Type::value_type::first_type>::type, typename Type::value_type::second_type> value;
+        read(value);
+        iteratable.emplace(std::move(value));
+    }
+}
+
+template <typename Type,
+    Traits::EnableIf<IsIteratableExceptString<Type>,
+        Traits::None<IsMapOrHash<Type>, IsMultiMapOrHash<Type>, Traits::All<IsArray<Type>, Traits::IsResizable<Type>>>> *>
+void BinaryDeserializer::read(Type &iteratable)
+{
+    const auto size = readVariableLengthUIntBE();
+    if constexpr (PackedBinaryIntegers<Type>::value) {
+        readPacked(iteratable, size);
+    } else if constexpr (Detail::IsBulkSerializable<Type>::value) {
+        if (size != iteratable.size()) {
+            throw CppUtilities::ConversionException("Number of elements does not match the size of the array");
+        }
+        readBlock(iteratable.data(), iteratable.size());
+    } else {
+        for (size_t i = 0; i != size; ++i) {
+            typename Type::value_type value;
+            read(value);
+            iteratable.emplace(std::move(value));
+        }
+    }
+}
+
+/// \brief Reads \a size elements of \a iteratable enabled via PackedBinaryIntegers (resizing it if possible).
+template <typename Type> void BinaryDeserializer::readPacked(Type &iteratable, std::uint64_t size)
+{
+    using Packed = Detail::PackedIntegers<typename Type::value_type>;
+    auto control = std::string(Packed::controlSize(static_cast<std::size_t>(size)), '\0');
+    CppUtilities::BinaryReader::read(control.data(), static_cast<std::streamsize>(control.size()));
+    auto data = std::string(Packed::dataSize(control.data(), static_cast<std::size_t>(size)), '\0');
+    CppUtilities::BinaryReader::read(data.data(), static_cast<std::streamsize>(data.size()));
+    unpack(control.data(), data.data(), data.size(), iteratable, size);
+}
+
+/// \brief Reads \a count big-endian \a elements at once.
+template <typename Element> void BinaryDeserializer::readBlock(Element *elements, std::size_t count)
+{
+    auto *const data = reinterpret_cast<char *>(elements);
+    CppUtilities::BinaryReader::read(data, static_cast<std::streamsize>(count * sizeof(Element)));
+    Detail::convertByteOrder<sizeof(Element)>(data, count, m_byteOrder);
+}
+
+template <typename Type, Traits::EnableIf<std::is_enum<Type>> *> void BinaryDeserializer::read(Type &enumValue)
+{
+    typename std::underlying_type<Type>::type value;
+    read(value);
+    enumValue = static_cast<Type>(value);
+}
+
+/// \cond
+namespace Detail {
+template <typename Variant, std::size_t compiletimeIndex = 0, typename Deserializer>
+void readVariantValueByRuntimeIndex(std::size_t runtimeIndex, Variant &variant, Deserializer &deserializer)
+{
+    if constexpr (compiletimeIndex < std::variant_size_v<Variant>) {
+        if (compiletimeIndex == runtimeIndex) {
+            if constexpr (std::is_same_v<std::variant_alternative_t<compiletimeIndex, Variant>, std::monostate>) {
+                variant = std::monostate{};
+            } else {
+                deserializer.read(variant.template emplace<compiletimeIndex>());
+            }
+        } else {
+            readVariantValueByRuntimeIndex<Variant, compiletimeIndex + 1>(runtimeIndex, variant, deserializer);
+        }
+    } else {
+        throw CppUtilities::ConversionException("Variant index is out of expected range");
+    }
+}
+} // namespace Detail
+/// \endcond
+
+template <typename Type, Traits::EnableIf<IsVariant<Type>> *> void BinaryDeserializer::read(Type &variant)
+{
+    Detail::readVariantValueByRuntimeIndex(readByte(), variant, *this);
+}
+
+template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> *> BinaryVersion BinaryDeserializer::read(Type &builtInType, BinaryVersion version)
+{
+    read(builtInType);
+    return version;
+}
+
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> *> BinaryVersion BinaryDeserializer::read(Type &customType, BinaryVersion version)
+{
+    return readCustomType(*this, customType, version);
+}
+
+inline BinarySerializer::BinarySerializer(std::ostream *stream)
+    : CppUtilities::BinaryWriter(stream)
+{
+}
+
+/// \brief Writes a multi-byte arithmetic \a value in the byte order set via setByteOrder() or writeHeader().
+template <typename Type> inline void BinarySerializer::writeNumber(Type value)
+{
+    if (m_byteOrder == BinaryByteOrder::BigEndian) {
+        CppUtilities::BinaryWriter::write(value);
+        return;
+    }
+    char buffer[sizeof(Type)];
+    Detail::writeValue(value, buffer, m_byteOrder);
+    CppUtilities::BinaryWriter::write(buffer, sizeof(Type));
+}
+
+inline void BinarySerializer::write(std::int16_t value)
+{
+    writeNumber(value);
+}
+
+inline void BinarySerializer::write(std::uint16_t value)
+{
+    writeNumber(value);
+}
+
+inline void BinarySerializer::write(std::int32_t value)
+{
+    writeNumber(value);
+}
+
+inline void BinarySerializer::write(std::uint32_t value)
+{
+    writeNumber(value);
+}
+
+inline void BinarySerializer::write(std::int64_t value)
+{
+    writeNumber(value);
+}
+
+inline void BinarySerializer::write(std::uint64_t value)
+{
+    writeNumber(value);
+}
+
+inline void BinarySerializer::write(float value)
+{
+    writeNumber(value);
+}
+
+inline void BinarySerializer::write(double value)
+{
+    writeNumber(value);
+}
+
+/// \brief Begins a length-prefixed record if \a skippable is set; otherwise does nothing.
+/// \remarks
+/// - Subsequent writes go to the record until endRecord() is called which writes the size followed by the record.
+/// - Used by generated code for types enabled via REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD.
+/// \returns Returns the stream to pass to endRecord().
+inline std::ostream *BinarySerializer::beginRecord(bool skippable)
+{
+    if (!skippable) {
+        return nullptr;
+    }
+    auto *const outerStream = stream();
+    auto &record = m_records.emplace_back(std::make_unique<std::ostringstream>(std::ios_base::out | std::ios_base::binary));
+    record->exceptions(outerStream->exceptions());
+    setStream(record.get());
+    return outerStream;
+}
+
+/// \brief Ends the record begun via beginRecord() writing it prefixed with its size to \a outerStream.
+inline void BinarySerializer::endRecord(std::ostream *outerStream)
+{
+    if (!outerStream) {
+        return;
+    }
+    const auto record = m_records.back()->str();
+    m_records.pop_back();
+    setStream(outerStream);
+    write(std::string_view(record));
+}
+
+inline void BinarySerializer::write(std::string_view lengthPrefixedString)
+{
+    writeVariableLengthUIntBE(lengthPrefixedString.size());
+    CppUtilities::BinaryWriter::write(lengthPrefixedString.data(), static_cast<std::streamsize>(lengthPrefixedString.size()));
+}
+
+template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> *> void BinarySerializer::write(const Type &pair)
+{
+    write(pair.first);
+    write(pair.second);
+}
+
+template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::optional>> *>
+void BinarySerializer::write(const Type &opt)
+{
+    writeBool(static_cast<bool>(opt));
+    if (opt) {
+        write(*opt);
+    }
+}
+
+template <typename Type, Traits::EnableIf<IsIteratableExceptString<Type>, Traits::HasSize<Type>> *>
+void BinarySerializer::write(const Type &iteratable)
+{
+    writeVariableLengthUIntBE(iteratable.size());
+    if constexpr (PackedBinaryIntegers<Type>::value) {
+        Detail::PackedIntegers<typename Type::value_type>::write(iteratable.data(), iteratable.size(),
+            [this](const char *data, std::size_t size) { CppUtilities::BinaryWriter::write(data, static_cast<std::streamsize>(size)); });
+    } else if constexpr (Detail::IsBulkSerializable<Type>::value) {
+        Detail::writeBlock(iteratable.data(), iteratable.size(), m_byteOrder,
+            [this](const char *data, std::size_t size) { CppUtilities::BinaryWriter::write(data, static_cast<std::streamsize>(size)); });
+    } else {
+        for (const auto &element : iteratable) {
+            write(element);
+        }
+    }
+}
+
+template <typename Type, Traits::EnableIf<std::is_enum<Type>> *> void BinarySerializer::write(const Type &enumValue)
+{
+    write(static_cast<typename std::underlying_type<Type>::type>(enumValue));
+}
+
+template <typename Type, Traits::EnableIf<IsVariant<Type>> *> void BinarySerializer::write(const Type &variant)
+{
+    static_assert(std::variant_size_v<Type> < std::numeric_limits<std::uint8_t>::max(), "index will not exceed limit");
+    writeByte(static_cast<std::uint8_t>(variant.index()));
+    std::visit(
+        [this](const auto &valueOfActualType) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(valueOfActualType)>, std::monostate>) {
+                write(valueOfActualType);
+            } else {
+                CPP_UTILITIES_UNUSED(this)
+            }
+        },
+        variant);
+}
+
+template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> *> void BinarySerializer::write(const Type &builtInType, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    write(builtInType);
+}
+
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> *> void BinarySerializer::write(const Type &customType, BinaryVersion version)
+{
+    writeCustomType(*this, customType, version);
+}
+
+inline void BinarySizeCalculator::writeByte(std::uint8_t)
+{
+    m_size += 1;
+}
+
+inline void BinarySizeCalculator::writeBool(bool)
+{
+    m_size += 1;
+}
+
+inline void BinarySizeCalculator::writeUInt64BE(std::uint64_t)
+{
+    m_size += 8;
+}
+
+inline void BinarySizeCalculator::writeVariableLengthUIntBE(std::uint64_t value)
+{
+    m_size += Detail::variableLengthUIntSize(value);
+}
+
+inline void BinarySizeCalculator::write(const std::string &lengthPrefixedString)
+{
+    m_size += Detail::variableLengthUIntSize(lengthPrefixedString.size()) + lengthPrefixedString.size();
+}
+
+template <typename Type, Traits::EnableIfAny<std::is_arithmetic<Type>, std::is_enum<Type>> *> void BinarySizeCalculator::write(Type)
+{
+    m_size += BinaryFixedSize<Type>::value;
+}
+
+template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> *> void BinarySizeCalculator::write(const Type &pair)
+{
+    write(pair.first);
+    write(pair.second);
+}
+
+template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::optional>> *>
+void BinarySizeCalculator::write(const Type &opt)
+{
+    m_size += 1;
+    if (opt) {
+        write(*opt);
+    }
+}
+
+template <typename Type, Traits::EnableIf<IsIteratableExceptString<Type>, Traits::HasSize<Type>> *>
+void BinarySizeCalculator::write(const Type &iteratable)
+{
+    using ElementType = typename Type::value_type;
+    const auto size = static_cast<std::size_t>(iteratable.size());
+    m_size += Detail::variableLengthUIntSize(size);
+    if constexpr (PackedBinaryIntegers<Type>::value) {
+        m_size += Detail::PackedIntegers<ElementType>::size(iteratable.data(), size);
+    } else if constexpr (BinaryFixedSize<ElementType>::value) {
+        m_size += size * BinaryFixedSize<ElementType>::value;
+    } else {
+        for (const auto &element : iteratable) {
+            write(element);
+        }
+    }
+}
+
+template <typename Type, Traits::EnableIf<IsVariant<Type>> *> void BinarySizeCalculator::write(const Type &variant)
+{
+    m_size += 1;
+    std::visit(
+        [this](const auto &valueOfActualType) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(valueOfActualType)>, std::monostate>) {
+                write(valueOfActualType);
+            } else {
+                CPP_UTILITIES_UNUSED(this)
+            }
+        },
+        variant);
+}
+
+template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> *> void BinarySizeCalculator::write(const Type &builtInType, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    write(builtInType);
+}
+
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> *> void BinarySizeCalculator::write(const Type &customType, BinaryVersion version)
+{
+    if constexpr (BinaryFixedSize<Type>::value) {
+        CPP_UTILITIES_UNUSED(customType)
+        CPP_UTILITIES_UNUSED(version)
+        m_size += BinaryFixedSize<Type>::value;
+    } else {
+        measureCustomType(*this, customType, version);
+    }
+}
+
+/// \brief Adds the specified number of bytes.
+inline void BinarySizeCalculator::add(std::size_t size)
+{
+    m_size += size;
+}
+
+/// \brief Begins a length-prefixed record if \a skippable is set; otherwise does nothing.
+/// \returns Returns the value to pass to endRecord().
+inline std::optional<std::size_t> BinarySizeCalculator::beginRecord(bool skippable)
+{
+    return skippable ? std::make_optional(m_size) : std::nullopt;
+}
+
+/// \brief Adds the size of the prefix of the record begun via beginRecord().
+inline void BinarySizeCalculator::endRecord(std::optional<std::size_t> recordBegin)
+{
+    if (recordBegin) {
+        m_size += Detail::variableLengthUIntSize(m_size - *recordBegin);
+    }
+}
+
+/// \brief Returns the number of bytes determined so far.
+inline std::size_t BinarySizeCalculator::size() const
+{
+    return m_size;
+}
+
+/// \brief Constructs a deserializer reading from the specified \a buffer.
+inline BinaryBufferDeserializer::BinaryBufferDeserializer(const char *buffer, std::size_t bufferSize)
+    : m_current(buffer)
+    , m_end(buffer + bufferSize)
+{
+}
+
+/// \brief Returns the next \a size bytes and advances the position accordingly.
+inline const char *BinaryBufferDeserializer::take(std::size_t size)
+{
+    if (static_cast<std::size_t>(m_end - m_current) < size) {
+        throw CppUtilities::ConversionException("Unexpected end of binary data");
+    }
+    const auto *const data = m_current;
+    m_current += size;
+    return data;
+}
+
+inline std::uint8_t BinaryBufferDeserializer::readByte()
+{
+    return static_cast<std::uint8_t>(*take(1));
+}
+
+inline bool BinaryBufferDeserializer::readBool()
+{
+    return readByte() != 0;
+}
+
+inline std::uint64_t BinaryBufferDeserializer::readUInt64BE()
+{
+    return CppUtilities::BE::toUInt64(take(sizeof(std::uint64_t)));
+}
+
+inline std::uint64_t BinaryBufferDeserializer::readVariableLengthUIntBE()
+{
+    // determine the length from the number of leading zero bits of the first byte
+    const auto firstByte = readByte();
+    auto mask = std::uint8_t(0x80);
+    auto size = std::size_t(1);
+    for (; size <= 8 && !(firstByte & mask); ++size, mask >>= 1)
+        ;
+    if (size > 8) {
+        throw CppUtilities::ConversionException("Length denotation of variable-length unsigned integer exceeds maximum.");
+    }
+    if (size == 1) {
+        return firstByte & (mask - 1);
+    }
+    // load all bytes at once if enough bytes are remaining (including the first byte which has already been taken)
+    if (static_cast<std::size_t>(m_end - m_current) >= sizeof(std::uint64_t) - 1) {
+        const auto word = CppUtilities::BE::toUInt64(m_current - 1);
+        m_current += size - 1;
+        return (word >> (8 * (sizeof(std::uint64_t) - size))) & ((std::uint64_t(1) << (7 * size)) - 1);
+    }
+    auto value = static_cast<std::uint64_t>(firstByte & (mask - 1));
+    for (const auto *data = take(size - 1), *const end = data + size - 1; data != end; ++data) {
+        value = (value << 8) | static_cast<std::uint8_t>(*data);
+    }
+    return value;
+}
 
-public:
-    explicit BinarySerializer(std::ostream *stream);
+inline void BinaryBufferDeserializer::readBytes(char *buffer, std::size_t size)
+{
+    std::memcpy(buffer, take(size), size);
+}
 
-    using CppUtilities::BinaryWriter::write;
-    template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> * = nullptr> void write(const Type &pair);
-    template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::optional>> * = nullptr>
-    void write(const Type &pointer);
-    template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::shared_ptr>> * = nullptr> void write(const Type &pointer);
-    template <typename Type, Traits::EnableIf<IsIteratableExceptString<Type>, Traits::HasSize<Type>> * = nullptr> void write(const Type &iteratable);
-    template <typename Type, Traits::EnableIf<std::is_enum<Type>> * = nullptr> void write(const Type &enumValue);
-    template <typename Type, Traits::EnableIf<IsVariant<Type>> * = nullptr> void write(const Type &variant);
-    template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> * = nullptr> void write(const Type &builtInType, BinaryVersion version);
-    template <typename Type, Traits::EnableIf<IsCustomType<Type>> * = nullptr> void write(const Type &customType, BinaryVersion version = 0);
+inline void BinaryBufferDeserializer::read(std::string &lengthPrefixedString)
+{
+    const auto size = static_cast<std::size_t>(readVariableLengthUIntBE());
+    lengthPrefixedString.assign(take(size), size);
+}
 
-private:
-    std::unordered_map<std::uint64_t, bool> m_pointer;
-};
+/// \brief Reads a string without copying it.
+/// \remarks \a borrowedString points into the buffer and is therefore only valid as long as the buffer.
+inline void BinaryBufferDeserializer::read(std::string_view &borrowedString)
+{
+    const auto size = static_cast<std::size_t>(readVariableLengthUIntBE());
+    borrowedString = std::string_view(take(size), size);
+}
 
-inline BinaryDeserializer::BinaryDeserializer(std::istream *stream)
-    : CppUtilities::BinaryReader(stream)
+template <typename Type, Traits::EnableIf<std::is_arithmetic<Type>> *> void BinaryBufferDeserializer::read(Type &value)
 {
+    if constexpr (sizeof(Type) == 1) {
+        value = static_cast<Type>(*take(1));
+    } else {
+        value = Detail::readValue<Type>(take(sizeof(Type)), m_byteOrder);
+    }
 }
 
-template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> *> void BinaryDeserializer::read(Type &pair)
+template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> *> void BinaryBufferDeserializer::read(Type &pair)
 {
     read(pair.first);
     read(pair.second);
 }
 
-template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::unique_ptr>> *> void BinaryDeserializer::read(Type &pointer)
+template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::unique_ptr>> *>
+void BinaryBufferDeserializer::read(Type &pointer)
 {
     if (!readBool()) {
         pointer.reset();
@@ -139,31 +1793,7 @@ template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::
     read(*pointer);
 }
 
-template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::shared_ptr>> *> void BinaryDeserializer::read(Type &pointer)
-{
-    auto mode = readByte();
-    if (!mode) {
-        // pointer not set
-        pointer.reset();
-        return;
-    }
-
-    const auto id = (mode & 0x4) ? readUInt64BE() : readVariableLengthUIntBE(); // the 3rd bit being flagged indicates a big ID
-    if ((mode & 0x3) == 1) {
-        // first occurrence: make a new pointer
-        m_pointer[id] = pointer = std::make_shared<typename Type::element_type>();
-        read(*pointer);
-        return;
-    }
-    // further occurrences: copy previous pointer
-    try {
-        pointer = std::any_cast<Type>(m_pointer[id]);
-    } catch (const std::bad_any_cast &) {
-        throw CppUtilities::ConversionException("Referenced pointer type does not match");
-    }
-}
-
-template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::optional>> *> void BinaryDeserializer::read(Type &opt)
+template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::optional>> *> void BinaryBufferDeserializer::read(Type &opt)
 {
     if (readBool()) {
         read(opt.emplace());
@@ -172,16 +1802,24 @@ template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::
     }
 }
 
-template <typename Type, Traits::EnableIf<IsArray<Type>, Traits::IsResizable<Type>> *> void BinaryDeserializer::read(Type &iteratable)
+template <typename Type, Traits::EnableIf<IsArray<Type>, Traits::IsResizable<Type>> *> void BinaryBufferDeserializer::read(Type &iteratable)
 {
     const auto size = readVariableLengthUIntBE();
-    iteratable.resize(size);
-    for (auto &element : iteratable) {
-        read(element);
+    if constexpr (PackedBinaryIntegers<Type>::value) {
+        readPacked(iteratable, size);
+    } else if constexpr (Detail::IsBulkSerializable<Type>::value) {
+        const auto *const data = takeBlock<typename Type::value_type>(size);
+        iteratable.resize(size);
+        readBlock(data, iteratable.data(), iteratable.size());
+    } else {
+        iteratable.resize(size);
+        for (auto &element : iteratable) {
+            read(element);
+        }
     }
 }
 
-template <typename Type, Traits::EnableIfAny<IsMapOrHash<Type>, IsMultiMapOrHash<Type>> *> void BinaryDeserializer::read(Type &iteratable)
+template <typename Type, Traits::EnableIfAny<IsMapOrHash<Type>, IsMultiMapOrHash<Type>> *> void BinaryBufferDeserializer::read(Type &iteratable)
 {
     const auto size = readVariableLengthUIntBE();
     for (size_t i = 0; i != size; ++i) {
@@ -194,121 +1832,342 @@ template <typename Type, Traits::EnableIfAny<IsMapOrHash<Type>, IsMultiMapOrHash
 template <typename Type,
     Traits::EnableIf<IsIteratableExceptString<Type>,
         Traits::None<IsMapOrHash<Type>, IsMultiMapOrHash<Type>, Traits::All<IsArray<Type>, Traits::IsResizable<Type>>>> *>
-void BinaryDeserializer::read(Type &iteratable)
+void BinaryBufferDeserializer::read(Type &iteratable)
 {
     const auto size = readVariableLengthUIntBE();
-    for (size_t i = 0; i != size; ++i) {
-        typename Type::value_type value;
-        read(value);
-        iteratable.emplace(std::move(value));
+    if constexpr (PackedBinaryIntegers<Type>::value) {
+        readPacked(iteratable, size);
+    } else if constexpr (Detail::IsBulkSerializable<Type>::value) {
+        if (size != iteratable.size()) {
+            throw CppUtilities::ConversionException("Number of elements does not match the size of the array");
+        }
+        readBlock(takeBlock<typename Type::value_type>(size), iteratable.data(), iteratable.size());
+    } else {
+        for (size_t i = 0; i != size; ++i) {
+            typename Type::value_type value;
+            read(value);
+            iteratable.emplace(std::move(value));
+        }
     }
 }
 
-template <typename Type, Traits::EnableIf<std::is_enum<Type>> *> void BinaryDeserializer::read(Type &enumValue)
+/// \brief Returns the data of the next \a count elements of \tparam Element and advances the position accordingly.
+template <typename Element> const char *BinaryBufferDeserializer::takeBlock(std::uint64_t count)
+{
+    if (count > bytesRemaining() / sizeof(Element)) {
+        throw CppUtilities::ConversionException("Unexpected end of binary data");
+    }
+    return take(static_cast<std::size_t>(count) * sizeof(Element));
+}
+
+/// \brief Returns the control bytes of \a size elements enabled via PackedBinaryIntegers and advances the position accordingly.
+template <typename Element> const char *BinaryBufferDeserializer::takePackedControl(std::uint64_t size)
+{
+    // each element takes at least one byte of data (besides its share of a control byte)
+    if (size > bytesRemaining()) {
+        throw CppUtilities::ConversionException("Unexpected end of binary data");
+    }
+    return take(Detail::PackedIntegers<Element>::controlSize(static_cast<std::size_t>(size)));
+}
+
+/// \brief Reads \a size elements of \a iteratable enabled via PackedBinaryIntegers (resizing it if possible).
+template <typename Type> void BinaryBufferDeserializer::readPacked(Type &iteratable, std::uint64_t size)
+{
+    using Packed = Detail::PackedIntegers<typename Type::value_type>;
+    const auto *const control = takePackedControl<typename Type::value_type>(size);
+    const auto dataSize = Packed::dataSize(control, static_cast<std::size_t>(size));
+    unpack(control, take(dataSize), dataSize, iteratable, size);
+}
+
+/// \brief Copies \a count big-endian elements from \a data to \a elements at once.
+template <typename Element> void BinaryBufferDeserializer::readBlock(const char *data, Element *elements, std::size_t count)
+{
+    if (!count) {
+        return;
+    }
+    std::memcpy(elements, data, count * sizeof(Element));
+    Detail::convertByteOrder<sizeof(Element)>(reinterpret_cast<char *>(elements), count, m_byteOrder);
+}
+
+template <typename Type, Traits::EnableIf<std::is_enum<Type>> *> void BinaryBufferDeserializer::read(Type &enumValue)
 {
     typename std::underlying_type<Type>::type value;
     read(value);
     enumValue = static_cast<Type>(value);
 }
 
-/// \cond
-namespace Detail {
-template <typename Variant, std::size_t compiletimeIndex = 0>
-void readVariantValueByRuntimeIndex(std::size_t runtimeIndex, Variant &variant, BinaryDeserializer &deserializer)
+template <typename Type, Traits::EnableIf<IsVariant<Type>> *> void BinaryBufferDeserializer::read(Type &variant)
+{
+    Detail::readVariantValueByRuntimeIndex(readByte(), variant, *this);
+}
+
+template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> *>
+BinaryVersion BinaryBufferDeserializer::read(Type &builtInType, BinaryVersion version)
+{
+    read(builtInType);
+    return version;
+}
+
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> *>
+BinaryVersion BinaryBufferDeserializer::read(Type &customType, BinaryVersion version)
+{
+    return readCustomType(*this, customType, version);
+}
+
+/// \brief Reads the members of \a customType selected via \a fields skipping all other members (see readCustomTypeProjected()).
+/// \remarks Use BinaryFields to compose \a fields, e.g. `BinaryFields<Example>::a | BinaryFields<Example>::b`.
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> *>
+BinaryVersion BinaryBufferDeserializer::readProjected(Type &customType, BinaryFieldMask fields, BinaryVersion version)
+{
+    return readCustomTypeProjected(*this, customType, fields, version);
+}
+
+/// \brief Reads \a value if \a selected is set; otherwise skips it.
+/// \remarks Used by generated readCustomTypeProjected() functions.
+template <typename Type> inline void BinaryBufferDeserializer::readOrSkip(Type &value, bool selected, BinaryVersion version)
+{
+    if (selected) {
+        read(value, version);
+    } else {
+        skipValue<Type>(version);
+    }
+}
+
+/// \brief Skips a value of \tparam Type without decoding it if possible.
+/// \remarks
+/// - Values with a fixed size, strings and containers of values with a fixed size are skipped without looking at the data.
+/// - Elements of other containers are skipped one by one.
+/// - Custom types are skipped via readCustomTypeProjected() without selecting any members. The generated specializations skip
+///   skippable records (see SkippableBinaryRecord) as a whole via their length then; only their base classes are skipped
+///   member by member as those precede the length. Custom types without such specialization are read entirely.
+/// - Shared pointers are read as further occurrences might refer to them.
+template <typename Type> void BinaryBufferDeserializer::skipValue(BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version) // only passed to custom types like read() does
+    if constexpr (BinaryFixedSize<Type>::value) {
+        skip(BinaryFixedSize<Type>::value);
+    } else if constexpr (Traits::IsAnyOf<Type, std::string, std::string_view>::value) {
+        skip(static_cast<std::size_t>(readVariableLengthUIntBE()));
+    } else if constexpr (std::is_same_v<Type, std::monostate>) {
+        return;
+    } else if constexpr (Traits::IsSpecializationOf<Type, std::pair>::value) {
+        skipValue<std::remove_const_t<typename Type::first_type>>();
+        skipValue<std::remove_const_t<typename Type::second_type>>();
+    } else if constexpr (Traits::IsSpecializationOf<Type, std::unique_ptr>::value) {
+        if (readBool()) {
+            skipValue<typename Type::element_type>();
+        }
+    } else if constexpr (Traits::IsSpecializationOf<Type, std::optional>::value) {
+        if (readBool()) {
+            skipValue<typename Type::value_type>();
+        }
+    } else if constexpr (Traits::IsSpecializationOf<Type, std::shared_ptr>::value) {
+        auto pointer = Type();
+        read(pointer);
+    } else if constexpr (IsVariant<Type>::value) {
+        skipVariantValueByRuntimeIndex<Type>(readByte());
+    } else if constexpr (IsIteratableExceptString<Type>::value) {
+        using ElementType = std::remove_const_t<typename Type::value_type>;
+        const auto size = readVariableLengthUIntBE();
+        if constexpr (PackedBinaryIntegers<Type>::value) {
+            skip(Detail::PackedIntegers<ElementType>::dataSize(takePackedControl<ElementType>(size), static_cast<std::size_t>(size)));
+        } else if constexpr (BinaryFixedSize<ElementType>::value) {
+            if (size > bytesRemaining() / BinaryFixedSize<ElementType>::value) {
+                throw CppUtilities::ConversionException("Unexpected end of binary data");
+            }
+            skip(static_cast<std::size_t>(size) * BinaryFixedSize<ElementType>::value);
+        } else {
+            for (auto i = std::uint64_t(); i != size; ++i) {
+                skipValue<ElementType>();
+            }
+        }
+    } else {
+        auto customType = Type();
+        readCustomTypeProjected(*this, customType, BinaryFieldMask(), version);
+    }
+}
+
+/// \brief Skips the alternative of \tparam Variant with the specified \a runtimeIndex.
+template <typename Variant, std::size_t compiletimeIndex> void BinaryBufferDeserializer::skipVariantValueByRuntimeIndex(std::size_t runtimeIndex)
 {
     if constexpr (compiletimeIndex < std::variant_size_v<Variant>) {
         if (compiletimeIndex == runtimeIndex) {
-            if constexpr (std::is_same_v<std::variant_alternative_t<compiletimeIndex, Variant>, std::monostate>) {
-                variant = std::monostate{};
-            } else {
-                deserializer.read(variant.template emplace<compiletimeIndex>());
-            }
+            skipValue<std::variant_alternative_t<compiletimeIndex, Variant>>();
         } else {
-            readVariantValueByRuntimeIndex<Variant, compiletimeIndex + 1>(runtimeIndex, variant, deserializer);
+            skipVariantValueByRuntimeIndex<Variant, compiletimeIndex + 1>(runtimeIndex);
         }
     } else {
         throw CppUtilities::ConversionException("Variant index is out of expected range");
     }
 }
-} // namespace Detail
-/// \endcond
 
-template <typename Type, Traits::EnableIf<IsVariant<Type>> *> void BinaryDeserializer::read(Type &variant)
+/// \brief Reads the size of a length-prefixed record if \a skippable is set; otherwise does nothing.
+/// \remarks
+/// - Subsequent reads are limited to the record until endRecord() is called.
+/// - Used by generated code for types enabled via REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD.
+/// \returns Returns the value to pass to endRecord().
+/// \throws Throws CppUtilities::ConversionException if the record exceeds the buffer.
+inline const char *BinaryBufferDeserializer::beginRecord(bool skippable)
 {
-    Detail::readVariantValueByRuntimeIndex(readByte(), variant, *this);
+    if (!skippable) {
+        return nullptr;
+    }
+    const auto size = readVariableLengthUIntBE();
+    if (size > bytesRemaining()) {
+        throw CppUtilities::ConversionException("Unexpected end of binary data");
+    }
+    return std::exchange(m_end, m_current + size);
 }
 
-template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> *> BinaryVersion BinaryDeserializer::read(Type &builtInType, BinaryVersion version)
+/// \brief Ends the record begun via beginRecord() skipping the part of the record which has not been read.
+inline void BinaryBufferDeserializer::endRecord(const char *outerEnd)
 {
-    read(builtInType);
-    return version;
+    if (outerEnd) {
+        m_current = std::exchange(m_end, outerEnd);
+    }
 }
 
-template <typename Type, Traits::EnableIf<IsCustomType<Type>> *> BinaryVersion BinaryDeserializer::read(Type &customType, BinaryVersion version)
+/// \brief Skips the specified number of bytes.
+inline void BinaryBufferDeserializer::skip(std::size_t size)
 {
-    return readCustomType(*this, customType, version);
+    take(size);
 }
 
-inline BinarySerializer::BinarySerializer(std::ostream *stream)
-    : CppUtilities::BinaryWriter(stream)
+/// \brief Returns the current position within the buffer.
+inline const char *BinaryBufferDeserializer::position() const
 {
+    return m_current;
 }
 
-template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> *> void BinarySerializer::write(const Type &pair)
+/// \brief Returns the number of bytes which have not been read yet.
+inline std::size_t BinaryBufferDeserializer::bytesRemaining() const
 {
-    write(pair.first);
-    write(pair.second);
+    return static_cast<std::size_t>(m_end - m_current);
 }
 
-template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::optional>> *>
-void BinarySerializer::write(const Type &opt)
+/// \brief Constructs a serializer appending to the specified \a output.
+inline BinaryBufferSerializer::BinaryBufferSerializer(std::string &output)
+    : m_output(&output)
+    , m_begin(nullptr)
+    , m_current(nullptr)
+    , m_end(nullptr)
+    , m_initialSize(output.size())
 {
-    writeBool(static_cast<bool>(opt));
-    if (opt) {
-        write(*opt);
-    }
 }
 
-template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::shared_ptr>> *> void BinarySerializer::write(const Type &pointer)
+/// \brief Constructs a serializer writing to the specified \a buffer.
+inline BinaryBufferSerializer::BinaryBufferSerializer(char *buffer, std::size_t bufferSize)
+    : m_output(nullptr)
+    , m_begin(buffer)
+    , m_current(buffer)
+    , m_end(buffer + bufferSize)
+    , m_initialSize(0)
 {
-    if (pointer == nullptr) {
-        writeByte(0);
+}
+
+inline void BinaryBufferSerializer::writeBytes(const char *buffer, std::size_t size)
+{
+    if (m_output) {
+        m_output->append(buffer, size);
         return;
     }
-    const auto id = reinterpret_cast<std::uintptr_t>(pointer.get());
-    const auto bigId = id >= 0x80000000000000;
-    auto &alreadyWritten = m_pointer[id];
-    std::uint8_t mode = alreadyWritten ? 2 : 1;
-    if (bigId) {
-        mode = mode | 0x4; // "flag" 3rd bit to indicate big ID
+    if (static_cast<std::size_t>(m_end - m_current) < size) {
+        throw CppUtilities::ConversionException("Binary data exceeds the size of the buffer");
+    }
+    std::memcpy(m_current, buffer, size);
+    m_current += size;
+}
+
+inline void BinaryBufferSerializer::writeByte(std::uint8_t value)
+{
+    const auto c = static_cast<char>(value);
+    writeBytes(&c, 1);
+}
+
+inline void BinaryBufferSerializer::writeBool(bool value)
+{
+    writeByte(value ? 1 : 0);
+}
+
+inline void BinaryBufferSerializer::writeUInt64BE(std::uint64_t value)
+{
+    char buffer[sizeof(std::uint64_t)];
+    CppUtilities::BE::getBytes(value, buffer);
+    writeBytes(buffer, sizeof(buffer));
+}
+
+inline void BinaryBufferSerializer::writeVariableLengthUIntBE(std::uint64_t value)
+{
+    if (value >= (std::uint64_t(1) << 56)) {
+        throw CppUtilities::ConversionException("The variable-length integer to be written exceeds the maximum.");
     }
-    writeByte(mode);
-    if (bigId) {
-        writeUInt64BE(id);
+    // prefix the value with a 1-bit after as many 0-bits as additional bytes are required
+    const auto size = Detail::variableLengthUIntSize(value);
+    char buffer[sizeof(std::uint64_t)];
+    CppUtilities::BE::getBytes(value | (std::uint64_t(0x80) << (7 * (size - 1))), buffer);
+    writeBytes(buffer + sizeof(buffer) - size, size);
+}
+
+inline void BinaryBufferSerializer::write(const std::string &lengthPrefixedString)
+{
+    writeVariableLengthUIntBE(lengthPrefixedString.size());
+    writeBytes(lengthPrefixedString.data(), lengthPrefixedString.size());
+}
+
+inline void BinaryBufferSerializer::write(std::string_view lengthPrefixedString)
+{
+    writeVariableLengthUIntBE(lengthPrefixedString.size());
+    writeBytes(lengthPrefixedString.data(), lengthPrefixedString.size());
+}
+
+template <typename Type, Traits::EnableIf<std::is_arithmetic<Type>> *> void BinaryBufferSerializer::write(Type value)
+{
+    if constexpr (sizeof(Type) == 1) {
+        writeByte(static_cast<std::uint8_t>(value));
     } else {
-        writeVariableLengthUIntBE(id);
+        char buffer[sizeof(Type)];
+        Detail::writeValue(value, buffer, m_byteOrder);
+        writeBytes(buffer, sizeof(buffer));
     }
-    if (!alreadyWritten) {
-        alreadyWritten = true;
-        write(*pointer);
+}
+
+template <typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> *> void BinaryBufferSerializer::write(const Type &pair)
+{
+    write(pair.first);
+    write(pair.second);
+}
+
+template <typename Type, Traits::EnableIf<Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::optional>> *>
+void BinaryBufferSerializer::write(const Type &opt)
+{
+    writeBool(static_cast<bool>(opt));
+    if (opt) {
+        write(*opt);
     }
 }
 
 template <typename Type, Traits::EnableIf<IsIteratableExceptString<Type>, Traits::HasSize<Type>> *>
-void BinarySerializer::write(const Type &iteratable)
+void BinaryBufferSerializer::write(const Type &iteratable)
 {
     writeVariableLengthUIntBE(iteratable.size());
-    for (const auto &element : iteratable) {
-        write(element);
+    if constexpr (PackedBinaryIntegers<Type>::value) {
+        Detail::PackedIntegers<typename Type::value_type>::write(
+            iteratable.data(), iteratable.size(), [this](const char *data, std::size_t size) { writeBytes(data, size); });
+    } else if constexpr (Detail::IsBulkSerializable<Type>::value) {
+        Detail::writeBlock(iteratable.data(), iteratable.size(), m_byteOrder, [this](const char *data, std::size_t size) { writeBytes(data, size); });
+    } else {
+        for (const auto &element : iteratable) {
+            write(element);
+        }
     }
 }
 
-template <typename Type, Traits::EnableIf<std::is_enum<Type>> *> void BinarySerializer::write(const Type &enumValue)
+template <typename Type, Traits::EnableIf<std::is_enum<Type>> *> void BinaryBufferSerializer::write(const Type &enumValue)
 {
     write(static_cast<typename std::underlying_type<Type>::type>(enumValue));
 }
 
-template <typename Type, Traits::EnableIf<IsVariant<Type>> *> void BinarySerializer::write(const Type &variant)
+template <typename Type, Traits::EnableIf<IsVariant<Type>> *> void BinaryBufferSerializer::write(const Type &variant)
 {
     static_assert(std::variant_size_v<Type> < std::numeric_limits<std::uint8_t>::max(), "index will not exceed limit");
     writeByte(static_cast<std::uint8_t>(variant.index()));
@@ -323,17 +2182,204 @@ template <typename Type, Traits::EnableIf<IsVariant<Type>> *> void BinarySeriali
         variant);
 }
 
-template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> *> void BinarySerializer::write(const Type &builtInType, BinaryVersion version)
+template <typename Type, Traits::EnableIf<IsBuiltInType<Type>> *>
+void BinaryBufferSerializer::write(const Type &builtInType, BinaryVersion version)
 {
     CPP_UTILITIES_UNUSED(version)
     write(builtInType);
 }
 
-template <typename Type, Traits::EnableIf<IsCustomType<Type>> *> void BinarySerializer::write(const Type &customType, BinaryVersion version)
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> *> void BinaryBufferSerializer::write(const Type &customType, BinaryVersion version)
 {
     writeCustomType(*this, customType, version);
 }
 
+/// \brief Begins a length-prefixed record if \a skippable is set; otherwise does nothing.
+/// \remarks Used by generated code for types enabled via REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD.
+/// \returns Returns the value to pass to endRecord().
+inline std::optional<std::size_t> BinaryBufferSerializer::beginRecord(bool skippable)
+{
+    return skippable ? std::make_optional(bytesWritten()) : std::nullopt;
+}
+
+/// \brief Prefixes the record begun via beginRecord() with its size.
+/// \remarks The size is not known in advance so the record is moved by the size of the prefix.
+inline void BinaryBufferSerializer::endRecord(std::optional<std::size_t> recordBegin)
+{
+    if (!recordBegin) {
+        return;
+    }
+    // append the prefix first to ensure there is enough space for it
+    const auto recordSize = bytesWritten() - *recordBegin;
+    const auto prefixSize = Detail::variableLengthUIntSize(recordSize);
+    writeVariableLengthUIntBE(recordSize);
+    auto *const record = (m_output ? m_output->data() + m_initialSize : m_begin) + *recordBegin;
+    char prefix[sizeof(std::uint64_t)];
+    std::memcpy(prefix, record + recordSize, prefixSize);
+    std::memmove(record + prefixSize, record, recordSize);
+    std::memcpy(record, prefix, prefixSize);
+}
+
+/// \brief Returns the number of bytes written by the serializer so far.
+inline std::size_t BinaryBufferSerializer::bytesWritten() const
+{
+    return m_output ? m_output->size() - m_initialSize : static_cast<std::size_t>(m_current - m_begin);
+}
+
+/// \cond
+namespace Detail {
+/// \brief The CountingStreamBuffer class is a stream buffer which merely counts the characters written to it.
+class CountingStreamBuffer : public std::streambuf {
+public:
+    std::size_t count() const
+    {
+        return m_count;
+    }
+
+protected:
+    std::streamsize xsputn(const char *, std::streamsize count) override
+    {
+        m_count += static_cast<std::size_t>(count);
+        return count;
+    }
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            ++m_count;
+        }
+        return traits_type::not_eof(c);
+    }
+
+private:
+    std::size_t m_count = 0;
+};
+
+/// \brief The BufferSerializerStreamBuffer class is a stream buffer which passes the characters written to it to a BinaryBufferSerializer.
+class BufferSerializerStreamBuffer : public std::streambuf {
+public:
+    explicit BufferSerializerStreamBuffer(BinaryBufferSerializer &serializer)
+        : m_serializer(serializer)
+    {
+    }
+
+protected:
+    std::streamsize xsputn(const char *chars, std::streamsize count) override
+    {
+        m_serializer.writeBytes(chars, static_cast<std::size_t>(count));
+        return count;
+    }
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            m_serializer.writeByte(static_cast<std::uint8_t>(traits_type::to_char_type(c)));
+        }
+        return traits_type::not_eof(c);
+    }
+
+private:
+    BinaryBufferSerializer &m_serializer;
+};
+} // namespace Detail
+/// \endcond
+
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> *>
+void measureCustomType(BinarySizeCalculator &calculator, const Type &customType, BinaryVersion version)
+{
+    auto buffer = Detail::CountingStreamBuffer();
+    auto stream = std::ostream(&buffer);
+    auto serializer = BinarySerializer(&stream);
+    serializer.setSchema(calculator.schema());
+    const auto pointers = Detail::SharedPointerLease(calculator.sharedPointers(), serializer.sharedPointers());
+    writeCustomType(serializer, customType, version);
+    calculator.add(buffer.count());
+}
+
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> *>
+BinaryVersion readCustomType(BinaryBufferDeserializer &deserializer, Type &customType, BinaryVersion version)
+{
+    auto buffer = Detail::InputBufferStreamBuffer(deserializer.position(), deserializer.bytesRemaining());
+    auto stream = std::istream(&buffer);
+    stream.exceptions(std::ios_base::badbit | std::ios_base::failbit);
+    auto streamDeserializer = BinaryDeserializer(&stream);
+    streamDeserializer.setByteOrder(deserializer.byteOrder());
+    streamDeserializer.setSchema(deserializer.schema());
+    const auto pointers = Detail::SharedPointerLease(deserializer.sharedPointers(), streamDeserializer.sharedPointers());
+    version = readCustomType(streamDeserializer, customType, version);
+    deserializer.skip(buffer.bytesRead());
+    return version;
+}
+
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> *>
+BinaryVersion readCustomTypeProjected(BinaryBufferDeserializer &deserializer, Type &customType, BinaryFieldMask fields, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(fields)
+    return readCustomType(deserializer, customType, version);
+}
+
+template <typename Type, Traits::EnableIf<IsCustomType<Type>> *>
+void writeCustomType(BinaryBufferSerializer &serializer, const Type &customType, BinaryVersion version)
+{
+    auto buffer = Detail::BufferSerializerStreamBuffer(serializer);
+    auto stream = std::ostream(&buffer);
+    stream.exceptions(std::ios_base::badbit | std::ios_base::failbit);
+    auto streamSerializer = BinarySerializer(&stream);
+    streamSerializer.setByteOrder(serializer.byteOrder());
+    streamSerializer.setSchema(serializer.schema());
+    const auto pointers = Detail::SharedPointerLease(serializer.sharedPointers(), streamSerializer.sharedPointers());
+    writeCustomType(streamSerializer, customType, version);
+}
+
+/// \brief Returns the number of bytes BinarySerializer writes for the specified \a reflectable.
+template <typename Type> std::size_t binarySize(const Type &reflectable, BinaryVersion version = 0)
+{
+    if constexpr (BinaryFixedSize<Type>::value) {
+        CPP_UTILITIES_UNUSED(reflectable)
+        CPP_UTILITIES_UNUSED(version)
+        return BinaryFixedSize<Type>::value;
+    } else {
+        auto calculator = BinarySizeCalculator();
+        calculator.write(reflectable, version);
+        return calculator.size();
+    }
+}
+
+/// \brief Serializes the specified \a reflectable into the specified \a buffer.
+/// \returns Returns the number of bytes written.
+/// \throws Throws CppUtilities::ConversionException if \a buffer is too small.
+template <typename Type> std::size_t toBinary(const Type &reflectable, char *buffer, std::size_t bufferSize, BinaryVersion version = 0)
+{
+    auto serializer = BinaryBufferSerializer(buffer, bufferSize);
+    serializer.write(reflectable, version);
+    return serializer.bytesWritten();
+}
+
+/// \brief Serializes the specified \a reflectable into a string allocated once according to binarySize().
+template <typename Type> std::string toBinary(const Type &reflectable, BinaryVersion version = 0)
+{
+    auto output = std::string();
+    output.reserve(binarySize(reflectable, version));
+    BinaryBufferSerializer(output).write(reflectable, version);
+    return output;
+}
+
+/// \brief Deserializes an object of \tparam Type from the specified \a buffer.
+/// \throws Throws CppUtilities::ConversionException if \a buffer does not contain a valid object.
+template <typename Type> Type fromBinary(const char *buffer, std::size_t bufferSize)
+{
+    auto reflectable = Type();
+    BinaryBufferDeserializer(buffer, bufferSize).read(reflectable);
+    return reflectable;
+}
+
+/// \brief Serializes the specified \a reflectable which has a fixed size into an array (e.g. on the stack).
+template <typename Type, Traits::EnableIf<Traits::Bool<(BinaryFixedSize<Type>::value > 0)>> * = nullptr>
+std::array<char, BinaryFixedSize<Type>::value> toFixedSizeBinary(const Type &reflectable)
+{
+    auto output = std::array<char, BinaryFixedSize<Type>::value>();
+    toBinary(reflectable, output.data(), output.size());
+    return output;
+}
+
 } // namespace BinaryReflector
 } // namespace ReflectiveRapidJSON
 
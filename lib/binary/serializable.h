@@ -9,6 +9,7 @@
 
 #include "./reflector.h"
 
+#include <cstddef>
 #include <iosfwd>
 #include <string>
 
@@ -22,8 +23,12 @@ using BinaryVersionNotSupported = VersionNotSupported<BinaryVersion>;
 template <typename Type, BinaryVersion v> struct BinarySerializable {
     using VersionNotSupported = BinaryVersionNotSupported;
     void toBinary(std::ostream &outputStream, BinaryVersion version = 0) const;
+    std::string toBinary(BinaryVersion version = 0) const;
     BinaryVersion restoreFromBinary(std::istream &inputStream);
+    BinaryVersion restoreFromBinary(const char *buffer, std::size_t bufferSize);
     static Type fromBinary(std::istream &inputStream);
+    static Type fromBinary(const char *buffer, std::size_t bufferSize);
+    static Type fromBinary(const std::string &buffer);
 
     static constexpr const char *qualifiedName = "ReflectiveRapidJSON::BinarySerializable";
     static constexpr auto version = v;
@@ -38,18 +43,57 @@ template <typename Type, BinaryVersion v> inline void BinarySerializable<Type, v
     BinaryReflector::BinarySerializer(&outputStream).write(static_cast<const Type &>(*this), version);
 }
 
+/*!
+ * \brief Serializes the object into a string which is allocated once according to BinaryReflector::binarySize().
+ * \remarks The string is written directly (via BinaryReflector::BinaryBufferSerializer) without going through std::ostream.
+ */
+template <typename Type, BinaryVersion v> inline std::string BinarySerializable<Type, v>::toBinary(BinaryVersion version) const
+{
+    return BinaryReflector::toBinary(static_cast<const Type &>(*this), version);
+}
+
 template <typename Type, BinaryVersion v> inline BinaryVersion BinarySerializable<Type, v>::restoreFromBinary(std::istream &inputStream)
 {
     return BinaryReflector::BinaryDeserializer(&inputStream).read(static_cast<Type &>(*this));
 }
 
+/*!
+ * \brief Restores the object from the specified \a buffer without going through std::istream.
+ * \throws Throws CppUtilities::ConversionException if \a buffer does not contain a valid object.
+ */
+template <typename Type, BinaryVersion v>
+inline BinaryVersion BinarySerializable<Type, v>::restoreFromBinary(const char *buffer, std::size_t bufferSize)
+{
+    return BinaryReflector::BinaryBufferDeserializer(buffer, bufferSize).read(static_cast<Type &>(*this));
+}
+
 template <typename Type, BinaryVersion v> Type BinarySerializable<Type, v>::fromBinary(std::istream &inputStream)
 {
     Type object;
-    static_cast<BinarySerializable<Type> &>(object).restoreFromBinary(inputStream);
+    static_cast<BinarySerializable<Type, v> &>(object).restoreFromBinary(inputStream);
+    return object;
+}
+
+/*!
+ * \brief Deserializes an object from the specified \a buffer without going through std::istream.
+ * \throws Throws CppUtilities::ConversionException if \a buffer does not contain a valid object.
+ */
+template <typename Type, BinaryVersion v> Type BinarySerializable<Type, v>::fromBinary(const char *buffer, std::size_t bufferSize)
+{
+    Type object;
+    static_cast<BinarySerializable<Type, v> &>(object).restoreFromBinary(buffer, bufferSize);
     return object;
 }
 
+/*!
+ * \brief Deserializes an object from the specified \a buffer without going through std::istream.
+ * \throws Throws CppUtilities::ConversionException if \a buffer does not contain a valid object.
+ */
+template <typename Type, BinaryVersion v> inline Type BinarySerializable<Type, v>::fromBinary(const std::string &buffer)
+{
+    return fromBinary(buffer.data(), buffer.size());
+}
+
 /*!
  * \def The REFLECTIVE_RAPIDJSON_MAKE_BINARY_SERIALIZABLE macro allows to adapt (de)serialization for types defined in 3rd party header files.
  * \remarks The struct will not have the toBinary() and fromBinary() methods available. Use the corresponding functions in the namespace
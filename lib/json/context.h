@@ -0,0 +1,159 @@
+#ifndef REFLECTIVE_RAPIDJSON_JSON_CONTEXT_H
+#define REFLECTIVE_RAPIDJSON_JSON_CONTEXT_H
+
+/*!
+ * \file context.h
+ * \brief Contains the JsonSerializationContext class which allows reusing memory across multiple (de)serializations.
+ */
+
+#include "./policy.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+
+namespace ReflectiveRapidJSON {
+
+/*!
+ * \brief The JsonSerializationContext class owns the resources required to (de)serialize JSON so they can be reused.
+ *
+ * Creating a RapidJSON document, its memory pool, its parse stack and an output buffer for each message causes a lot
+ * of allocations. A context keeps these resources alive between messages. Resetting it only rewinds the memory pool
+ * and clears the output buffer without freeing any memory. If a message did not fit into the pre-allocated buffer the
+ * buffer is enlarged on the next reset so subsequent messages of a similar size do not cause any allocations.
+ *
+ * \remarks
+ * - The context is not thread-safe. Use one context per thread or connection.
+ * - The document and output buffer are only valid until the context is used again.
+ */
+class JsonSerializationContext {
+public:
+    using Allocator = RAPIDJSON_NAMESPACE::MemoryPoolAllocator<>;
+    using Document = RAPIDJSON_NAMESPACE::GenericDocument<RAPIDJSON_NAMESPACE::UTF8<>, Allocator, Allocator>;
+    using Writer = JsonWriter<RAPIDJSON_NAMESPACE::StringBuffer>;
+
+    static constexpr std::size_t defaultCapacity = 16 * 1024;
+
+    explicit JsonSerializationContext(std::size_t capacity = defaultCapacity);
+    JsonSerializationContext(const JsonSerializationContext &) = delete;
+    JsonSerializationContext &operator=(const JsonSerializationContext &) = delete;
+
+    Document &document();
+    Document &startParsing();
+    RAPIDJSON_NAMESPACE::StringBuffer &output();
+    Writer &startWriting();
+    std::size_t capacity() const;
+    void reset();
+
+private:
+    void allocate(std::size_t capacity);
+
+    std::unique_ptr<char[]> m_buffer;
+    std::size_t m_capacity;
+    std::optional<Allocator> m_valueAllocator;
+    std::optional<Allocator> m_stackAllocator;
+    std::optional<Document> m_document;
+    RAPIDJSON_NAMESPACE::StringBuffer m_output;
+    Writer m_writer;
+};
+
+/*!
+ * \brief Constructs a new context pre-allocating \a capacity bytes for the values and the same amount for the parse stack.
+ */
+inline JsonSerializationContext::JsonSerializationContext(std::size_t capacity)
+    : m_capacity(0)
+    , m_writer(m_output)
+{
+    allocate(capacity);
+}
+
+/*!
+ * \brief (Re-)allocates the buffer backing the memory pools and re-creates the document.
+ * \remarks The document is destroyed before the allocators it refers to.
+ */
+inline void JsonSerializationContext::allocate(std::size_t capacity)
+{
+    m_document.reset();
+    m_stackAllocator.reset();
+    m_valueAllocator.reset();
+    capacity = std::max<std::size_t>(capacity, 1024);
+    if (capacity != m_capacity) {
+        m_buffer = std::make_unique<char[]>(capacity * 2);
+        m_capacity = capacity;
+    }
+    m_valueAllocator.emplace(m_buffer.get(), m_capacity, m_capacity);
+    m_stackAllocator.emplace(m_buffer.get() + m_capacity, m_capacity, m_capacity);
+    m_document.emplace(&*m_valueAllocator, Document::kDefaultStackCapacity, &*m_stackAllocator);
+}
+
+/*!
+ * \brief Returns the document most recently populated via startParsing().
+ */
+inline JsonSerializationContext::Document &JsonSerializationContext::document()
+{
+    return *m_document;
+}
+
+/*!
+ * \brief Releases the values of the previous document and returns the empty document.
+ * \remarks If the previous document required additional chunks, the capacity is increased.
+ */
+inline JsonSerializationContext::Document &JsonSerializationContext::startParsing()
+{
+    if (m_valueAllocator->Capacity() > m_capacity || m_stackAllocator->Capacity() > m_capacity) {
+        const auto required = std::max(m_valueAllocator->Size(), m_stackAllocator->Size());
+        auto capacity = m_capacity * 2;
+        while (capacity < required) {
+            capacity *= 2;
+        }
+        allocate(capacity);
+        return *m_document;
+    }
+    m_document->SetNull();
+    m_valueAllocator->Clear();
+    m_stackAllocator->Clear();
+    return *m_document;
+}
+
+/*!
+ * \brief Returns the output buffer most recently populated via the writer returned by startWriting().
+ */
+inline RAPIDJSON_NAMESPACE::StringBuffer &JsonSerializationContext::output()
+{
+    return m_output;
+}
+
+/*!
+ * \brief Clears the output buffer (keeping its capacity) and returns a writer for populating it.
+ */
+inline JsonSerializationContext::Writer &JsonSerializationContext::startWriting()
+{
+    m_output.Clear();
+    m_writer.Reset(m_output);
+    return m_writer;
+}
+
+/*!
+ * \brief Returns the number of bytes pre-allocated for the values (and for the parse stack).
+ */
+inline std::size_t JsonSerializationContext::capacity() const
+{
+    return m_capacity;
+}
+
+/*!
+ * \brief Releases the document and clears the output buffer without freeing any memory.
+ */
+inline void JsonSerializationContext::reset()
+{
+    startParsing();
+    startWriting();
+}
+
+} // namespace ReflectiveRapidJSON
+
+#endif // REFLECTIVE_RAPIDJSON_JSON_CONTEXT_H
@@ -62,6 +62,9 @@ inline std::string formatJsonDeserializationError(const JsonDeserializationError
     default:
         errorKind = "semantic error";
     }
+    if (error.line != JsonDeserializationError::noIndex) {
+        additionalInfo = argsToString(" (in line ", error.line, ')') + additionalInfo;
+    }
     if (error.record && error.member) {
         return errorKind % " within record \"" % error.record % "\" and member \"" % error.member % '\"' + additionalInfo;
     } else if (error.record && error.index != JsonDeserializationError::noIndex) {
@@ -108,7 +108,7 @@ constexpr JsonType jsonType(RAPIDJSON_NAMESPACE::Type type)
  */
 struct JsonDeserializationError {
     JsonDeserializationError(JsonDeserializationErrorKind kind, JsonType expectedType, JsonType actualType, const char *record,
-        const char *member = nullptr, std::size_t index = noIndex);
+        const char *member = nullptr, std::size_t index = noIndex, std::size_t line = noIndex);
 
     /// \brief Which kind of error occurred.
     JsonDeserializationErrorKind kind;
@@ -122,6 +122,8 @@ struct JsonDeserializationError {
     const char *member;
     /// \brief The index in the array which was being processed when the error was ascertained.
     std::size_t index;
+    /// \brief The line number (within JSON Lines) which was being processed when the error was ascertained.
+    std::size_t line;
 
     /// \brief Indicates no array was being processed when the error occurred.
     static constexpr std::size_t noIndex = std::numeric_limits<std::size_t>::max();
@@ -132,13 +134,15 @@ struct JsonDeserializationError {
  * \remarks Supposed to be called by JsonDeserializationErrors::reportTypeMismatch() and similar methods of JsonDeserializationErrors.
  */
 inline JsonDeserializationError::JsonDeserializationError(
-    JsonDeserializationErrorKind kind, JsonType expectedType, JsonType actualType, const char *record, const char *member, std::size_t index)
+    JsonDeserializationErrorKind kind, JsonType expectedType, JsonType actualType, const char *record, const char *member, std::size_t index,
+    std::size_t line)
     : kind(kind)
     , expectedType(expectedType)
     , actualType(actualType)
     , record(record)
     , member(member)
     , index(index)
+    , line(line)
 {
 }
 
@@ -166,6 +170,8 @@ struct JsonDeserializationErrors : public std::vector<JsonDeserializationError>
     const char *currentMember;
     /// \brief The index in the array which is currently processed.
     std::size_t currentIndex;
+    /// \brief The line number (within JSON Lines) which is currently processed.
+    std::size_t currentLine;
     /// \brief The list of fatal error types in form of flags.
     enum class ThrowOn : std::uint8_t {
         None = 0,
@@ -187,6 +193,7 @@ inline JsonDeserializationErrors::JsonDeserializationErrors()
     : currentRecord("[document]")
     , currentMember(nullptr)
     , currentIndex(JsonDeserializationError::noIndex)
+    , currentLine(JsonDeserializationError::noIndex)
     , throwOn(ThrowOn::None)
 {
 }
@@ -216,8 +223,8 @@ inline void JsonDeserializationErrors::throwMaybe(ThrowOn on) const
  */
 template <typename ExpectedType> inline void JsonDeserializationErrors::reportTypeMismatch(RAPIDJSON_NAMESPACE::Type presentType)
 {
-    emplace_back(
-        JsonDeserializationErrorKind::TypeMismatch, jsonType<ExpectedType>(), jsonType(presentType), currentRecord, currentMember, currentIndex);
+    emplace_back(JsonDeserializationErrorKind::TypeMismatch, jsonType<ExpectedType>(), jsonType(presentType), currentRecord, currentMember,
+        currentIndex, currentLine);
     throwMaybe(ThrowOn::TypeMismatch);
 }
 
@@ -226,8 +233,8 @@ template <typename ExpectedType> inline void JsonDeserializationErrors::reportTy
  */
 template <RAPIDJSON_NAMESPACE::Type expectedType> inline void JsonDeserializationErrors::reportTypeMismatch(RAPIDJSON_NAMESPACE::Type presentType)
 {
-    emplace_back(
-        JsonDeserializationErrorKind::TypeMismatch, jsonType(expectedType), jsonType(presentType), currentRecord, currentMember, currentIndex);
+    emplace_back(JsonDeserializationErrorKind::TypeMismatch, jsonType(expectedType), jsonType(presentType), currentRecord, currentMember,
+        currentIndex, currentLine);
     throwMaybe(ThrowOn::TypeMismatch);
 }
 
@@ -238,7 +245,8 @@ template <RAPIDJSON_NAMESPACE::Type expectedType> inline void JsonDeserializatio
  */
 inline void JsonDeserializationErrors::reportArraySizeMismatch()
 {
-    emplace_back(JsonDeserializationErrorKind::ArraySizeMismatch, JsonType::Array, JsonType::Array, currentRecord, currentMember, currentIndex);
+    emplace_back(
+        JsonDeserializationErrorKind::ArraySizeMismatch, JsonType::Array, JsonType::Array, currentRecord, currentMember, currentIndex, currentLine);
     throwMaybe(ThrowOn::ArraySizeMismatch);
 }
 
@@ -249,7 +257,7 @@ inline void JsonDeserializationErrors::reportArraySizeMismatch()
  */
 inline void JsonDeserializationErrors::reportConversionError(JsonType jsonType)
 {
-    emplace_back(JsonDeserializationErrorKind::ConversionError, jsonType, jsonType, currentRecord, currentMember, currentIndex);
+    emplace_back(JsonDeserializationErrorKind::ConversionError, jsonType, jsonType, currentRecord, currentMember, currentIndex, currentLine);
     throwMaybe(ThrowOn::ConversionError);
 }
 
@@ -260,7 +268,7 @@ inline void JsonDeserializationErrors::reportConversionError(JsonType jsonType)
  */
 inline void JsonDeserializationErrors::reportUnexpectedDuplicate(JsonType jsonType)
 {
-    emplace_back(JsonDeserializationErrorKind::UnexpectedDuplicate, jsonType, jsonType, currentRecord, currentMember, currentIndex);
+    emplace_back(JsonDeserializationErrorKind::UnexpectedDuplicate, jsonType, jsonType, currentRecord, currentMember, currentIndex, currentLine);
     throwMaybe(ThrowOn::UnexpectedDuplicate);
 }
 
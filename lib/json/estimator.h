@@ -0,0 +1,128 @@
+#ifndef REFLECTIVE_RAPIDJSON_JSON_ESTIMATOR_H
+#define REFLECTIVE_RAPIDJSON_JSON_ESTIMATOR_H
+
+/*!
+ * \file estimator.h
+ * \brief Contains a RapidJSON handler which estimates the size of the JSON a writer would produce.
+ */
+
+#include "./writer.h"
+
+#include <rapidjson/rapidjson.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ReflectiveRapidJSON {
+
+/*!
+ * \brief The JsonSizeEstimator class is a RapidJSON handler which sums up the size of the JSON a writer would produce.
+ *
+ * It is supposed to be passed to JsonReflector::write() (see JsonReflector::estimateJsonSize()) so the output buffer can
+ * be reserved once instead of growing it while writing.
+ *
+ * \remarks
+ * - The sizes of integers, booleans, null and keys (JsonMemberKey) are exact.
+ * - Floating point numbers are assumed to take the maximum size RapidJSON's writer needs for a double.
+ * - Strings are assumed to need no escaping so the estimation is too low for strings containing characters to escape.
+ * - Each value is assumed to be followed by a separator so the estimation is slightly too high (about one byte per array
+ *   or object).
+ */
+class JsonSizeEstimator {
+public:
+    using Ch = char;
+
+    /// \brief An upper bound for the number of characters RapidJSON's writer produces for a double.
+    static constexpr std::size_t maxDoubleSize = 25;
+
+    bool Null()
+    {
+        return add(4);
+    }
+    bool Bool(bool b)
+    {
+        return add(b ? 4 : 5);
+    }
+    bool Int(int i)
+    {
+        return Int64(i);
+    }
+    bool Uint(unsigned int i)
+    {
+        return Uint64(i);
+    }
+    bool Int64(std::int64_t i)
+    {
+        return i < 0 ? add(1 + digits(static_cast<std::uint64_t>(0) - static_cast<std::uint64_t>(i))) : Uint64(static_cast<std::uint64_t>(i));
+    }
+    bool Uint64(std::uint64_t i)
+    {
+        return add(digits(i));
+    }
+    bool Double(double)
+    {
+        return add(maxDoubleSize);
+    }
+    bool RawNumber(const Ch *, RAPIDJSON_NAMESPACE::SizeType length, bool = false)
+    {
+        return add(length);
+    }
+    bool String(const Ch *, RAPIDJSON_NAMESPACE::SizeType length, bool = false)
+    {
+        return add(length + 2);
+    }
+    bool StartObject()
+    {
+        return add(1);
+    }
+    bool Key(const Ch *, RAPIDJSON_NAMESPACE::SizeType length, bool = false)
+    {
+        return add(length + 2);
+    }
+    bool Key(const JsonMemberKey &key)
+    {
+        return add(key.quotedLength);
+    }
+    bool EndObject(RAPIDJSON_NAMESPACE::SizeType = 0)
+    {
+        m_size += 1;
+        return true;
+    }
+    bool StartArray()
+    {
+        return add(1);
+    }
+    bool EndArray(RAPIDJSON_NAMESPACE::SizeType = 0)
+    {
+        m_size += 1;
+        return true;
+    }
+
+    /// \brief Returns the estimated size of the JSON so far.
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    /// \brief Adds the specified \a size of a value plus one separator (',' or ':').
+    bool add(std::size_t size)
+    {
+        m_size += size + 1;
+        return true;
+    }
+    static std::size_t digits(std::uint64_t i)
+    {
+        auto count = std::size_t(1);
+        for (; i >= 10; i /= 10) {
+            ++count;
+        }
+        return count;
+    }
+
+    std::size_t m_size = 0;
+};
+
+} // namespace ReflectiveRapidJSON
+
+#endif // REFLECTIVE_RAPIDJSON_JSON_ESTIMATOR_H
@@ -0,0 +1,340 @@
+#ifndef REFLECTIVE_RAPIDJSON_JSON_LINES_H
+#define REFLECTIVE_RAPIDJSON_JSON_LINES_H
+
+/*!
+ * \file jsonlines.h
+ * \brief Contains classes to read and write streams of records in the JSON Lines format (newline-delimited JSON).
+ */
+
+#include "./reflector.h"
+
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace ReflectiveRapidJSON {
+
+/*!
+ * \brief The JsonLinesReader class reads records of \tparam Type from JSON Lines provided via an std::istream or a buffer.
+ *
+ * Each non-empty line is parsed as one record. The document, its memory pool and the line buffer are reused across
+ * records. Lines read from an std::istream are parsed in-situ.
+ *
+ * Errors found when populating a record are added to the JsonDeserializationErrors passed to the constructor. They
+ * are annotated with the line number (starting at 1). Invalid JSON leads to a RAPIDJSON_NAMESPACE::ParseResult being
+ * thrown as usual. Reading can be continued with the next line afterwards; lineNumber() returns the line which could
+ * not be parsed.
+ *
+ * \remarks The reader can be used as range, e.g. `for (const auto &record : JsonLinesReader<Record>(stream)) { ... }`.
+ */
+template <typename Type> class JsonLinesReader {
+public:
+    class Iterator;
+
+    explicit JsonLinesReader(std::istream &stream, JsonDeserializationErrors *errors = nullptr);
+    explicit JsonLinesReader(const char *buffer, std::size_t bufferSize, JsonDeserializationErrors *errors = nullptr);
+
+    bool read(Type &record);
+    std::size_t lineNumber() const;
+    std::size_t recordsRead() const;
+    JsonSerializationContext &context();
+    Iterator begin();
+    Iterator end();
+
+private:
+    bool nextLine(char *&line, std::size_t &lineSize);
+
+    std::istream *m_stream;
+    const char *m_pos;
+    const char *m_end;
+    JsonDeserializationErrors *m_errors;
+    std::string m_line;
+    JsonSerializationContext m_context;
+    std::size_t m_lineNumber;
+    std::size_t m_recordsRead;
+    Type m_current;
+};
+
+/*!
+ * \brief The JsonLinesReader::Iterator class is an input iterator over the records of a JsonLinesReader.
+ */
+template <typename Type> class JsonLinesReader<Type>::Iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Type *;
+    using reference = Type &;
+
+    explicit Iterator(JsonLinesReader<Type> *reader = nullptr)
+        : m_reader(reader)
+    {
+        ++*this;
+    }
+    reference operator*() const
+    {
+        return m_reader->m_current;
+    }
+    pointer operator->() const
+    {
+        return &m_reader->m_current;
+    }
+    Iterator &operator++()
+    {
+        if (m_reader && !m_reader->read(m_reader->m_current)) {
+            m_reader = nullptr;
+        }
+        return *this;
+    }
+    bool operator==(const Iterator &other) const
+    {
+        return m_reader == other.m_reader;
+    }
+    bool operator!=(const Iterator &other) const
+    {
+        return m_reader != other.m_reader;
+    }
+
+private:
+    JsonLinesReader<Type> *m_reader;
+};
+
+/*!
+ * \brief Constructs a reader for the JSON Lines read from the specified \a stream.
+ */
+template <typename Type>
+JsonLinesReader<Type>::JsonLinesReader(std::istream &stream, JsonDeserializationErrors *errors)
+    : m_stream(&stream)
+    , m_pos(nullptr)
+    , m_end(nullptr)
+    , m_errors(errors)
+    , m_lineNumber(0)
+    , m_recordsRead(0)
+    , m_current()
+{
+}
+
+/*!
+ * \brief Constructs a reader for the JSON Lines contained by the specified \a buffer.
+ * \remarks The \a buffer is not copied and must outlive the reader.
+ */
+template <typename Type>
+JsonLinesReader<Type>::JsonLinesReader(const char *buffer, std::size_t bufferSize, JsonDeserializationErrors *errors)
+    : m_stream(nullptr)
+    , m_pos(buffer)
+    , m_end(buffer + bufferSize)
+    , m_errors(errors)
+    , m_lineNumber(0)
+    , m_recordsRead(0)
+    , m_current()
+{
+}
+
+/*!
+ * \brief Determines the next line which is not empty.
+ * \returns Returns whether a line could be found; if not the end has been reached.
+ */
+template <typename Type> bool JsonLinesReader<Type>::nextLine(char *&line, std::size_t &lineSize)
+{
+    const auto isBlank = [](const char *begin, const char *end) {
+        for (; begin != end; ++begin) {
+            if (*begin != ' ' && *begin != '\t' && *begin != '\r') {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (m_stream) {
+        while (std::getline(*m_stream, m_line)) {
+            ++m_lineNumber;
+            if (!isBlank(m_line.data(), m_line.data() + m_line.size())) {
+                line = m_line.data();
+                lineSize = m_line.size();
+                return true;
+            }
+        }
+        return false;
+    }
+    while (m_pos != m_end) {
+        const auto *const newline = static_cast<const char *>(std::memchr(m_pos, '\n', static_cast<std::size_t>(m_end - m_pos)));
+        const auto *const lineEnd = newline ? newline : m_end;
+        const auto *const lineBegin = m_pos;
+        m_pos = newline ? newline + 1 : m_end;
+        ++m_lineNumber;
+        if (!isBlank(lineBegin, lineEnd)) {
+            m_line.assign(lineBegin, lineEnd);
+            line = m_line.data();
+            lineSize = m_line.size();
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * \brief Reads the next record into the specified \a record.
+ * \returns Returns whether a record could be read; if not the end has been reached and \a record is unchanged.
+ * \throws Throws RAPIDJSON_NAMESPACE::ParseResult if the line is not valid JSON.
+ */
+template <typename Type> bool JsonLinesReader<Type>::read(Type &record)
+{
+    char *line;
+    std::size_t lineSize;
+    if (!nextLine(line, lineSize)) {
+        return false;
+    }
+    auto &doc = m_context.startParsing();
+    InsituMemoryStream stream(line, lineSize);
+    const RAPIDJSON_NAMESPACE::ParseResult parseRes = parseJsonStream<RAPIDJSON_NAMESPACE::kParseInsituFlag>(doc, stream);
+    if (parseRes.IsError()) {
+        throw parseRes;
+    }
+    if (m_errors) {
+        m_errors->currentLine = m_lineNumber;
+    }
+    try {
+        record = JsonReflector::fromJsonDocument<Type>(doc, m_errors);
+    } catch (...) {
+        // clear the line number also if m_errors is configured to throw
+        if (m_errors) {
+            m_errors->currentLine = JsonDeserializationError::noIndex;
+        }
+        throw;
+    }
+    if (m_errors) {
+        m_errors->currentLine = JsonDeserializationError::noIndex;
+    }
+    ++m_recordsRead;
+    return true;
+}
+
+/*!
+ * \brief Returns the number of the line read most recently (starting at 1).
+ */
+template <typename Type> inline std::size_t JsonLinesReader<Type>::lineNumber() const
+{
+    return m_lineNumber;
+}
+
+/*!
+ * \brief Returns the number of records read so far.
+ */
+template <typename Type> inline std::size_t JsonLinesReader<Type>::recordsRead() const
+{
+    return m_recordsRead;
+}
+
+/*!
+ * \brief Returns the context used to parse the lines.
+ */
+template <typename Type> inline JsonSerializationContext &JsonLinesReader<Type>::context()
+{
+    return m_context;
+}
+
+/*!
+ * \brief Returns an iterator to the first record reading it.
+ */
+template <typename Type> inline typename JsonLinesReader<Type>::Iterator JsonLinesReader<Type>::begin()
+{
+    return Iterator(this);
+}
+
+/*!
+ * \brief Returns the end iterator.
+ */
+template <typename Type> inline typename JsonLinesReader<Type>::Iterator JsonLinesReader<Type>::end()
+{
+    return Iterator();
+}
+
+/*!
+ * \brief The JsonLinesWriter class writes records of \tparam Type as JSON Lines to a JsonSink or an std::ostream.
+ * \remarks The writer state is reused across records. Records are written directly (without intermediate document).
+ */
+template <typename Type> class JsonLinesWriter {
+public:
+    explicit JsonLinesWriter(JsonSink &sink);
+    explicit JsonLinesWriter(std::ostream &stream, std::size_t bufferSize = JsonSink::defaultBufferSize);
+    JsonLinesWriter(const JsonLinesWriter &) = delete;
+    JsonLinesWriter &operator=(const JsonLinesWriter &) = delete;
+    ~JsonLinesWriter();
+
+    void write(const Type &record);
+    void flush();
+    std::size_t recordsWritten() const;
+
+private:
+    std::optional<JsonOStreamSink> m_streamSink;
+    JsonSink &m_sink;
+    JsonWriter<JsonSink> m_writer;
+    std::size_t m_recordsWritten;
+};
+
+/*!
+ * \brief Constructs a writer writing to the specified \a sink.
+ */
+template <typename Type>
+JsonLinesWriter<Type>::JsonLinesWriter(JsonSink &sink)
+    : m_sink(sink)
+    , m_writer(m_sink)
+    , m_recordsWritten(0)
+{
+}
+
+/*!
+ * \brief Constructs a writer writing to the specified \a stream via a buffer of the specified \a bufferSize.
+ */
+template <typename Type>
+JsonLinesWriter<Type>::JsonLinesWriter(std::ostream &stream, std::size_t bufferSize)
+    : m_streamSink(std::in_place, stream, bufferSize)
+    , m_sink(*m_streamSink)
+    , m_writer(m_sink)
+    , m_recordsWritten(0)
+{
+}
+
+/*!
+ * \brief Flushes the remaining output.
+ */
+template <typename Type> JsonLinesWriter<Type>::~JsonLinesWriter()
+{
+    try {
+        flush();
+    } catch (...) {
+    }
+}
+
+/*!
+ * \brief Writes the specified \a record followed by a newline.
+ */
+template <typename Type> void JsonLinesWriter<Type>::write(const Type &record)
+{
+    m_writer.Reset(m_sink);
+    JsonReflector::write(record, m_writer);
+    m_sink.Put('\n');
+    ++m_recordsWritten;
+}
+
+/*!
+ * \brief Passes all buffered output to the sink's destination.
+ */
+template <typename Type> inline void JsonLinesWriter<Type>::flush()
+{
+    m_sink.flush();
+}
+
+/*!
+ * \brief Returns the number of records written so far.
+ */
+template <typename Type> inline std::size_t JsonLinesWriter<Type>::recordsWritten() const
+{
+    return m_recordsWritten;
+}
+
+} // namespace ReflectiveRapidJSON
+
+#endif // REFLECTIVE_RAPIDJSON_JSON_LINES_H
@@ -0,0 +1,349 @@
+#ifndef REFLECTIVE_RAPIDJSON_JSON_NUMBERS_H
+#define REFLECTIVE_RAPIDJSON_JSON_NUMBERS_H
+
+/*!
+ * \file numbers.h
+ * \brief Contains the numeric backend which allows formatting and parsing numbers via std::to_chars/std::from_chars.
+ */
+
+#include <c++utilities/application/global.h>
+#include <c++utilities/misc/traits.h>
+
+#include <rapidjson/document.h>
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace ReflectiveRapidJSON {
+
+/*!
+ * \brief The JsonNumberBackend enum specifies how numbers are formatted and parsed.
+ */
+enum class JsonNumberBackend {
+    RapidJson, /**< RapidJSON's own number formatting and parsing is used */
+    CharConv, /**< std::to_chars/std::from_chars is used (shortest round-trip representation, exact parsing) */
+};
+
+/*!
+ * \brief The backend used when not specified otherwise.
+ * \remarks Defining REFLECTIVE_RAPIDJSON_JSON_CHARCONV_NUMBERS (CMake option JSON_CHARCONV_NUMBERS) changes the default
+ *          to JsonNumberBackend::CharConv. This affects serializing and parsing documents as well as floating point
+ *          numbers written/pushed via JsonReflector.
+ */
+#ifdef REFLECTIVE_RAPIDJSON_JSON_CHARCONV_NUMBERS
+constexpr auto defaultJsonNumberBackend = JsonNumberBackend::CharConv;
+#else
+constexpr auto defaultJsonNumberBackend = JsonNumberBackend::RapidJson;
+#endif
+
+/*!
+ * \brief The JsonNumberFormat class specifies how floating point numbers of \tparam Type are formatted.
+ * \remarks
+ * - Specialize it via REFLECTIVE_RAPIDJSON_JSON_NUMBER_FORMAT() to opt in/out of the std::to_chars backend for a
+ *   particular type or to format numbers of that type with a fixed number of decimal places.
+ * - A negative number of decimal places means the shortest representation which round-trips is used.
+ * - Decimal places are only taken into account by the std::to_chars backend.
+ */
+template <typename Type> struct JsonNumberFormat {
+    static constexpr JsonNumberBackend backend = defaultJsonNumberBackend;
+    static constexpr int decimalPlaces = -1;
+};
+
+/*!
+ * \def The REFLECTIVE_RAPIDJSON_JSON_NUMBER_FORMAT macro specifies how floating point numbers of the specified type are formatted.
+ * \remarks For example, `REFLECTIVE_RAPIDJSON_JSON_NUMBER_FORMAT(float, ReflectiveRapidJSON::JsonNumberBackend::CharConv, 3);`
+ *          formats all float values with 3 decimal places.
+ */
+#define REFLECTIVE_RAPIDJSON_JSON_NUMBER_FORMAT(T, numberBackend, numberDecimalPlaces)                                                               \
+    template <> struct ReflectiveRapidJSON::JsonNumberFormat<T> {                                                                                    \
+        static constexpr ReflectiveRapidJSON::JsonNumberBackend backend = numberBackend;                                                             \
+        static constexpr int decimalPlaces = numberDecimalPlaces;                                                                                    \
+    }
+
+namespace Detail {
+
+/// \brief The size of the buffer required to format any double with a reasonable number of fixed decimal places.
+constexpr std::size_t jsonNumberBufferSize = 384;
+
+/*!
+ * \brief Formats the specified floating point \a number according to JsonNumberFormat<Type> via std::to_chars.
+ * \returns Returns a pointer past the last character written to \a buffer.
+ * \remarks
+ * - Like RapidJSON, ".0" is appended to integral numbers so they are still read as floating point numbers.
+ * - Falls back to the shortest representation if the number does not fit into the buffer using fixed decimal places.
+ */
+template <typename Type> char *formatJsonNumber(Type number, char (&buffer)[jsonNumberBufferSize])
+{
+    constexpr auto decimalPlaces = JsonNumberFormat<Type>::decimalPlaces;
+    auto *const end = buffer + jsonNumberBufferSize - 2;
+    auto res = std::to_chars_result{ end, std::errc::value_too_large };
+    if constexpr (decimalPlaces >= 0) {
+        res = std::to_chars(buffer, end, number, std::chars_format::fixed, decimalPlaces);
+    }
+    if (res.ec != std::errc()) {
+        res = std::to_chars(buffer, end, number);
+    }
+    if (std::all_of(buffer, res.ptr, [](char c) { return c == '-' || (c >= '0' && c <= '9'); })) {
+        *res.ptr++ = '.';
+        *res.ptr++ = '0';
+    }
+    return res.ptr;
+}
+
+/*!
+ * \brief Returns the value of the specified floating point \a number which ends up in a JSON document.
+ * \remarks If the std::to_chars backend is used, floats and numbers with fixed decimal places are converted via their
+ *          textual representation so the document contains the value which would have been written directly (e.g.
+ *          0.1 instead of 0.100000001490116 for 0.1f).
+ */
+template <typename Type> inline double jsonDouble(Type number)
+{
+    using Format = JsonNumberFormat<Type>;
+    if constexpr (Format::backend == JsonNumberBackend::CharConv && (!std::is_same_v<Type, double> || Format::decimalPlaces >= 0)) {
+        if (std::isfinite(number)) {
+            char buffer[jsonNumberBufferSize];
+            auto *const end = formatJsonNumber(number, buffer);
+            auto value = 0.0;
+            if (std::from_chars(buffer, end, value).ec == std::errc()) {
+                return value;
+            }
+        }
+    }
+    return static_cast<double>(number);
+}
+
+/*!
+ * \brief The SupportsRawValue class checks whether \tparam Handler is able to write raw values (like RapidJSON's writer).
+ */
+template <typename Handler, typename = void> struct SupportsRawValue : public Traits::Bool<false> {};
+template <typename Handler>
+struct SupportsRawValue<Handler,
+    std::void_t<decltype(std::declval<Handler &>().RawValue(nullptr, std::size_t(), RAPIDJSON_NAMESPACE::kNumberType))>>
+    : public Traits::Bool<true> {};
+
+/*!
+ * \brief Writes the specified floating point \a number via the specified \a handler according to JsonNumberFormat<Type>.
+ * \remarks Handlers which don't support raw values (which are not writers) are always passed a double.
+ */
+template <typename Type, typename Handler> inline void writeJsonNumber(Type number, Handler &handler)
+{
+    if constexpr (JsonNumberFormat<Type>::backend == JsonNumberBackend::CharConv) {
+        if constexpr (SupportsRawValue<Handler>::value) {
+            if (std::isfinite(number)) {
+                char buffer[jsonNumberBufferSize];
+                handler.RawValue(buffer, static_cast<std::size_t>(formatJsonNumber(number, buffer) - buffer), RAPIDJSON_NAMESPACE::kNumberType);
+                return;
+            }
+        }
+    }
+    handler.Double(static_cast<double>(number));
+}
+
+/*!
+ * \brief Returns whether the specified number which is out of range for a double is too big (rather than too close to zero).
+ * \remarks The number is supposed to be valid JSON.
+ */
+template <typename Ch> bool isJsonNumberTooBig(const Ch *str, const Ch *end)
+{
+    // determine the decimal exponent of the first significant digit which is positive if the number is too big
+    const auto *const exponentBegin = std::find_if(str, end, [](Ch c) { return c == 'e' || c == 'E'; });
+    auto exponent = std::int64_t();
+    if (exponentBegin != end) {
+        const auto *const exponentDigits = exponentBegin + (exponentBegin[1] == '+' ? 2 : 1);
+        if (std::from_chars(exponentDigits, end, exponent).ec != std::errc()) {
+            return *exponentDigits != '-';
+        }
+    }
+    auto integerDigits = std::int64_t(), leadingZeros = std::int64_t();
+    auto isFraction = false, isSignificant = false;
+    for (const auto *i = str; i != exponentBegin; ++i) {
+        if (*i == '.') {
+            isFraction = true;
+        } else if (*i >= '0' && *i <= '9') {
+            isSignificant = isSignificant || *i != '0';
+            if (!isFraction && isSignificant) {
+                ++integerDigits;
+            } else if (isFraction && !isSignificant) {
+                ++leadingZeros;
+            }
+        }
+    }
+    return (integerDigits ? exponent + integerDigits : exponent - leadingZeros) > 0;
+}
+
+/*!
+ * \brief The CharConvNumberHandler class passes SAX events to a document parsing numbers via std::from_chars.
+ * \remarks Supposed to be used with RAPIDJSON_NAMESPACE::kParseNumbersAsStringsFlag so numbers are passed as raw strings.
+ *          Numbers are added to the document with the same type RapidJSON's reader would use.
+ */
+template <typename Document> struct CharConvNumberHandler {
+    using Ch = typename Document::Ch;
+
+    bool Null()
+    {
+        return document.Null();
+    }
+    bool Bool(bool b)
+    {
+        return document.Bool(b);
+    }
+    bool Int(int i)
+    {
+        return document.Int(i);
+    }
+    bool Uint(unsigned int i)
+    {
+        return document.Uint(i);
+    }
+    bool Int64(std::int64_t i)
+    {
+        return document.Int64(i);
+    }
+    bool Uint64(std::uint64_t i)
+    {
+        return document.Uint64(i);
+    }
+    bool Double(double d)
+    {
+        return document.Double(d);
+    }
+    bool RawNumber(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy)
+    {
+        CPP_UTILITIES_UNUSED(copy)
+        const auto *const end = str + length;
+        if (std::none_of(str, end, [](Ch c) { return c == '.' || c == 'e' || c == 'E'; })) {
+            if (*str == '-') {
+                auto i = std::int64_t();
+                if (const auto res = std::from_chars(str, end, i); res.ec == std::errc() && res.ptr == end) {
+                    return i >= std::numeric_limits<int>::min() ? document.Int(static_cast<int>(i)) : document.Int64(i);
+                }
+            } else {
+                auto i = std::uint64_t();
+                if (const auto res = std::from_chars(str, end, i); res.ec == std::errc() && res.ptr == end) {
+                    return i <= std::numeric_limits<unsigned int>::max() ? document.Uint(static_cast<unsigned int>(i)) : document.Uint64(i);
+                }
+            }
+        }
+        auto d = 0.0;
+        const auto res = std::from_chars(str, end, d);
+        if (res.ptr != end) {
+            return false;
+        }
+        if (res.ec == std::errc::result_out_of_range) {
+            // fail like RapidJSON's reader if the number is too big; otherwise it is rounded to zero like RapidJSON's reader does
+            if (isJsonNumberTooBig(str, end)) {
+                error = RAPIDJSON_NAMESPACE::kParseErrorNumberTooBig;
+                return false;
+            }
+            d = *str == '-' ? -0.0 : 0.0;
+        } else if (res.ec != std::errc()) {
+            return false;
+        }
+        return document.Double(d);
+    }
+    bool String(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy)
+    {
+        return document.String(str, length, copy);
+    }
+    bool StartObject()
+    {
+        return document.StartObject();
+    }
+    bool Key(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy)
+    {
+        return document.Key(str, length, copy);
+    }
+    bool EndObject(RAPIDJSON_NAMESPACE::SizeType memberCount)
+    {
+        return document.EndObject(memberCount);
+    }
+    bool StartArray()
+    {
+        return document.StartArray();
+    }
+    bool EndArray(RAPIDJSON_NAMESPACE::SizeType elementCount)
+    {
+        return document.EndArray(elementCount);
+    }
+
+    Document &document;
+    /// \brief The error which made the handler stop the parsing (if not just the document stopped it).
+    RAPIDJSON_NAMESPACE::ParseErrorCode error = RAPIDJSON_NAMESPACE::kParseErrorNone;
+};
+
+} // namespace Detail
+
+/*!
+ * \brief The CharConvWriter class is a RapidJSON writer which formats doubles via std::to_chars.
+ * \remarks Doubles are formatted using the shortest representation which round-trips. Infinite numbers and NaN are
+ *          handled by RapidJSON's writer.
+ */
+template <typename OutputStream, unsigned int writeFlags = RAPIDJSON_NAMESPACE::kWriteDefaultFlags>
+class CharConvWriter : public RAPIDJSON_NAMESPACE::Writer<OutputStream, RAPIDJSON_NAMESPACE::UTF8<>, RAPIDJSON_NAMESPACE::UTF8<>,
+                           RAPIDJSON_NAMESPACE::CrtAllocator, writeFlags> {
+public:
+    using Base = RAPIDJSON_NAMESPACE::Writer<OutputStream, RAPIDJSON_NAMESPACE::UTF8<>, RAPIDJSON_NAMESPACE::UTF8<>,
+        RAPIDJSON_NAMESPACE::CrtAllocator, writeFlags>;
+    using Base::Base;
+
+    bool Double(double d)
+    {
+        if (!std::isfinite(d)) {
+            return Base::Double(d);
+        }
+        char buffer[Detail::jsonNumberBufferSize];
+        return Base::RawValue(buffer, static_cast<std::size_t>(Detail::formatJsonNumber(d, buffer) - buffer), RAPIDJSON_NAMESPACE::kNumberType);
+    }
+};
+
+/*!
+ * \brief Parses the JSON from the specified \a stream into the specified \a document using the specified \tparam backend.
+ * \returns Returns the result of the parsing; the document is only populated if no error occurred.
+ */
+template <unsigned int parseFlags, JsonNumberBackend backend = defaultJsonNumberBackend, typename Document, typename InputStream>
+RAPIDJSON_NAMESPACE::ParseResult parseJsonStream(Document &document, InputStream &stream)
+{
+    if constexpr (backend == JsonNumberBackend::CharConv) {
+        auto parseRes = RAPIDJSON_NAMESPACE::ParseResult();
+        auto generator = [&stream, &parseRes](Document &doc) {
+            RAPIDJSON_NAMESPACE::GenericReader<typename Document::EncodingType, typename Document::EncodingType> reader;
+            auto handler = Detail::CharConvNumberHandler<Document>{ doc };
+            parseRes = reader.template Parse<parseFlags | RAPIDJSON_NAMESPACE::kParseNumbersAsStringsFlag>(stream, handler);
+            if (parseRes.Code() == RAPIDJSON_NAMESPACE::kParseErrorTermination && handler.error != RAPIDJSON_NAMESPACE::kParseErrorNone) {
+                // report the actual error like RapidJSON's reader would do (the offset is the start of the number in both cases)
+                parseRes.Set(handler.error, parseRes.Offset());
+            }
+            return !parseRes.IsError();
+        };
+        document.Populate(generator);
+        return parseRes;
+    } else {
+        return document.template ParseStream<parseFlags>(stream);
+    }
+}
+
+/*!
+ * \brief Parses the specified \a json into the specified \a document using the specified \tparam backend.
+ */
+template <unsigned int parseFlags = RAPIDJSON_NAMESPACE::kParseDefaultFlags, JsonNumberBackend backend = defaultJsonNumberBackend,
+    typename Document>
+RAPIDJSON_NAMESPACE::ParseResult parseJson(Document &document, const char *json, std::size_t jsonSize)
+{
+    auto memoryStream = RAPIDJSON_NAMESPACE::MemoryStream(json, jsonSize);
+    auto stream = RAPIDJSON_NAMESPACE::EncodedInputStream<RAPIDJSON_NAMESPACE::UTF8<>, RAPIDJSON_NAMESPACE::MemoryStream>(memoryStream);
+    return parseJsonStream<parseFlags, backend>(document, stream);
+}
+
+} // namespace ReflectiveRapidJSON
+
+#endif // REFLECTIVE_RAPIDJSON_JSON_NUMBERS_H
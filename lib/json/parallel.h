@@ -0,0 +1,313 @@
+#ifndef REFLECTIVE_RAPIDJSON_JSON_PARALLEL_H
+#define REFLECTIVE_RAPIDJSON_JSON_PARALLEL_H
+
+/*!
+ * \file parallel.h
+ * \brief Contains functions to deserialize JSON Lines and JSON arrays using multiple threads.
+ */
+
+#include "./reflector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ReflectiveRapidJSON {
+namespace JsonReflector {
+
+namespace Detail {
+
+/*!
+ * \brief The JsonRecordSpan struct refers to a single record (a line or an array element) within a JSON buffer.
+ */
+struct JsonRecordSpan {
+    /// \brief The offset of the record within the buffer.
+    std::size_t offset;
+    /// \brief The size of the record.
+    std::size_t size;
+    /// \brief The line number (starting at 1) or the array index of the record.
+    std::size_t number;
+};
+
+/*!
+ * \brief Returns whether the specified character is JSON whitespace.
+ */
+constexpr bool isJsonWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/*!
+ * \brief Determines the non-blank lines within the specified \a json.
+ */
+inline std::vector<JsonRecordSpan> findJsonLines(const char *json, std::size_t jsonSize)
+{
+    auto spans = std::vector<JsonRecordSpan>();
+    auto lineNumber = std::size_t();
+    for (const char *pos = json, *end = json + jsonSize; pos != end;) {
+        const auto *const newline = static_cast<const char *>(std::memchr(pos, '\n', static_cast<std::size_t>(end - pos)));
+        const auto *const lineEnd = newline ? newline : end;
+        ++lineNumber;
+        if (std::any_of(pos, lineEnd, [](char c) { return !isJsonWhitespace(c); })) {
+            spans.emplace_back(JsonRecordSpan{ static_cast<std::size_t>(pos - json), static_cast<std::size_t>(lineEnd - pos), lineNumber });
+        }
+        pos = newline ? newline + 1 : end;
+    }
+    return spans;
+}
+
+/*!
+ * \brief Determines the elements of the top-level array within the specified \a json via a quick structural scan.
+ * \returns Returns the elements or std::nullopt if \a json does not contain an array.
+ * \throws Throws RAPIDJSON_NAMESPACE::ParseResult if the structure of the array is invalid (e.g. brackets do not match).
+ *         The elements themselves are not validated.
+ */
+inline std::optional<std::vector<JsonRecordSpan>> findJsonArrayElements(const char *json, std::size_t jsonSize)
+{
+    const char *pos = json, *const end = json + jsonSize;
+    const auto offset = [json](const char *p) { return static_cast<std::size_t>(p - json); };
+    for (; pos != end && isJsonWhitespace(*pos); ++pos)
+        ;
+    if (pos == end || *pos != '[') {
+        return std::nullopt;
+    }
+
+    auto spans = std::vector<JsonRecordSpan>();
+    auto openBrackets = std::string(1, '[');
+    const char *elementBegin = nullptr, *elementEnd = nullptr;
+    const auto addElement = [&] {
+        if (!elementBegin) {
+            throw RAPIDJSON_NAMESPACE::ParseResult(RAPIDJSON_NAMESPACE::kParseErrorValueInvalid, offset(pos));
+        }
+        spans.emplace_back(JsonRecordSpan{ offset(elementBegin), static_cast<std::size_t>(elementEnd - elementBegin), spans.size() });
+        elementBegin = elementEnd = nullptr;
+    };
+    for (++pos; pos != end; ++pos) {
+        const auto c = *pos;
+        if (isJsonWhitespace(c)) {
+            continue;
+        }
+        if (openBrackets.size() == 1) {
+            if (c == ',') {
+                addElement();
+                continue;
+            } else if (c == ']') {
+                if (elementBegin || !spans.empty()) {
+                    addElement();
+                }
+                openBrackets.clear();
+                break;
+            } else if (!elementBegin) {
+                elementBegin = pos;
+            }
+        }
+        switch (c) {
+        case '"':
+            for (++pos; pos != end && *pos != '"'; ++pos) {
+                if (*pos == '\\' && pos + 1 != end) {
+                    ++pos;
+                }
+            }
+            if (pos == end) {
+                throw RAPIDJSON_NAMESPACE::ParseResult(RAPIDJSON_NAMESPACE::kParseErrorStringMissQuotationMark, offset(pos));
+            }
+            break;
+        case '[':
+        case '{':
+            openBrackets += c;
+            break;
+        case ']':
+            if (openBrackets.back() != '[') {
+                throw RAPIDJSON_NAMESPACE::ParseResult(RAPIDJSON_NAMESPACE::kParseErrorObjectMissCommaOrCurlyBracket, offset(pos));
+            }
+            openBrackets.pop_back();
+            break;
+        case '}':
+            if (openBrackets.back() != '{') {
+                throw RAPIDJSON_NAMESPACE::ParseResult(RAPIDJSON_NAMESPACE::kParseErrorArrayMissCommaOrSquareBracket, offset(pos));
+            }
+            openBrackets.pop_back();
+            break;
+        default:;
+        }
+        elementEnd = pos + 1;
+    }
+    if (pos == end) {
+        throw RAPIDJSON_NAMESPACE::ParseResult(RAPIDJSON_NAMESPACE::kParseErrorArrayMissCommaOrSquareBracket, offset(pos));
+    }
+    while (++pos != end) {
+        if (!isJsonWhitespace(*pos)) {
+            throw RAPIDJSON_NAMESPACE::ParseResult(RAPIDJSON_NAMESPACE::kParseErrorDocumentRootNotSingular, offset(pos));
+        }
+    }
+    return spans;
+}
+
+/*!
+ * \brief Deserializes the specified records of \a json to \tparam Type using the specified number of threads.
+ *
+ * The records are partitioned into chunks which are processed by a pool of threads. Each thread picks the next
+ * unprocessed chunk once it is done with its current one so the load is balanced dynamically. Each thread uses its own
+ * JsonSerializationContext. The results and errors of the chunks are merged in input order.
+ *
+ * \remarks
+ * - If \a numberIsLine is set, errors are annotated with the line number; otherwise with the index of the element.
+ * - The offsets of parse errors are relative to \a json.
+ */
+template <typename Type>
+std::vector<Type> fromJsonRecordsParallel(const char *json, const std::vector<JsonRecordSpan> &spans, bool numberIsLine, std::size_t threadCount,
+    JsonDeserializationErrors *errors)
+{
+    struct Chunk {
+        std::vector<Type> values;
+        JsonDeserializationErrors errors;
+        std::exception_ptr exception;
+    };
+
+    if (!threadCount) {
+        threadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    const auto chunkSize = std::max<std::size_t>(spans.size() / (threadCount * 8), 1);
+    const auto chunkCount = (spans.size() + chunkSize - 1) / chunkSize;
+    threadCount = std::min(threadCount, chunkCount);
+    auto chunks = std::vector<Chunk>(chunkCount);
+    auto nextChunk = std::atomic<std::size_t>(0);
+    auto firstFailedChunk = std::atomic<std::size_t>(chunkCount);
+
+    const auto processChunks = [&] {
+        JsonSerializationContext context;
+        for (;;) {
+            // skip chunks after a failed chunk; preceding chunks have already been picked and are completed
+            const auto chunkIndex = nextChunk.fetch_add(1);
+            if (chunkIndex >= firstFailedChunk.load()) {
+                break;
+            }
+            auto &chunk = chunks[chunkIndex];
+            auto *const chunkErrors = errors ? &chunk.errors : nullptr;
+            if (chunkErrors) {
+                chunkErrors->throwOn = errors->throwOn;
+            }
+            const auto begin = chunkIndex * chunkSize, end = std::min(begin + chunkSize, spans.size());
+            chunk.values.reserve(end - begin);
+            try {
+                for (auto i = begin; i != end; ++i) {
+                    const auto &span = spans[i];
+                    auto &doc = context.startParsing();
+                    const RAPIDJSON_NAMESPACE::ParseResult parseRes = parseJson(doc, json + span.offset, span.size);
+                    if (parseRes.IsError()) {
+                        throw RAPIDJSON_NAMESPACE::ParseResult(parseRes.Code(), span.offset + parseRes.Offset());
+                    }
+                    if (chunkErrors) {
+                        (numberIsLine ? chunkErrors->currentLine : chunkErrors->currentIndex) = span.number;
+                    }
+                    chunk.values.emplace_back(fromJsonDocument<Type>(doc, chunkErrors));
+                }
+            } catch (...) {
+                chunk.exception = std::current_exception();
+                for (auto failedChunk = firstFailedChunk.load(); chunkIndex < failedChunk;) {
+                    firstFailedChunk.compare_exchange_weak(failedChunk, chunkIndex);
+                }
+            }
+        }
+    };
+    if (threadCount > 1) {
+        auto threads = std::vector<std::thread>();
+        threads.reserve(threadCount - 1);
+        for (auto i = std::size_t(1); i != threadCount; ++i) {
+            threads.emplace_back(processChunks);
+        }
+        processChunks();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    } else {
+        processChunks();
+    }
+
+    auto values = std::vector<Type>();
+    values.reserve(spans.size());
+    for (auto &chunk : chunks) {
+        if (errors) {
+            errors->insert(errors->end(), chunk.errors.begin(), chunk.errors.end());
+        }
+        if (chunk.exception) {
+            std::rethrow_exception(chunk.exception);
+        }
+        std::move(chunk.values.begin(), chunk.values.end(), std::back_inserter(values));
+    }
+    return values;
+}
+
+} // namespace Detail
+
+/*!
+ * \brief Deserializes the records of \tparam Type contained by the specified JSON Lines using multiple threads.
+ * \param threadCount Specifies the number of threads to use; 0 means one thread per CPU core.
+ * \remarks
+ * - Blank lines are skipped.
+ * - Errors are annotated with the line number (starting at 1) and ordered as if the lines were processed sequentially.
+ * \throws Throws RAPIDJSON_NAMESPACE::ParseResult if a line is not valid JSON. The offset is relative to \a json.
+ */
+template <typename Type>
+std::vector<Type> fromJsonLinesParallel(
+    const char *json, std::size_t jsonSize, std::size_t threadCount = 0, JsonDeserializationErrors *errors = nullptr)
+{
+    return Detail::fromJsonRecordsParallel<Type>(json, Detail::findJsonLines(json, jsonSize), true, threadCount, errors);
+}
+
+/*!
+ * \brief Deserializes the records of \tparam Type contained by the specified JSON Lines using multiple threads.
+ */
+template <typename Type>
+std::vector<Type> fromJsonLinesParallel(const std::string &json, std::size_t threadCount = 0, JsonDeserializationErrors *errors = nullptr)
+{
+    return fromJsonLinesParallel<Type>(json.data(), json.size(), threadCount, errors);
+}
+
+/*!
+ * \brief Deserializes the specified JSON array to \tparam Type (e.g. std::vector<Record>) using multiple threads.
+ * \param threadCount Specifies the number of threads to use; 0 means one thread per CPU core.
+ * \remarks
+ * - The elements of the array are determined by a quick structural scan first. Then they are deserialized in parallel.
+ * - Errors are annotated with the index of the element and ordered as if the elements were processed sequentially.
+ * - If \a json does not contain an array, this function behaves like fromJson().
+ * \throws Throws RAPIDJSON_NAMESPACE::ParseResult if the JSON is invalid. The offset is relative to \a json.
+ */
+template <typename Type, Traits::EnableIf<IsArray<Type>> * = nullptr>
+Type fromJsonArrayParallel(const char *json, std::size_t jsonSize, std::size_t threadCount = 0, JsonDeserializationErrors *errors = nullptr)
+{
+    const auto spans = Detail::findJsonArrayElements(json, jsonSize);
+    if (!spans.has_value()) {
+        return fromJson<Type>(json, jsonSize, errors);
+    }
+    auto values = Detail::fromJsonRecordsParallel<typename Type::value_type>(json, *spans, false, threadCount, errors);
+    if (errors) {
+        errors->currentIndex = JsonDeserializationError::noIndex;
+    }
+    if constexpr (std::is_same_v<Type, std::vector<typename Type::value_type>>) {
+        return values;
+    } else {
+        return Type(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+    }
+}
+
+/*!
+ * \brief Deserializes the specified JSON array to \tparam Type (e.g. std::vector<Record>) using multiple threads.
+ */
+template <typename Type, Traits::EnableIf<IsArray<Type>> * = nullptr>
+Type fromJsonArrayParallel(const std::string &json, std::size_t threadCount = 0, JsonDeserializationErrors *errors = nullptr)
+{
+    return fromJsonArrayParallel<Type>(json.data(), json.size(), threadCount, errors);
+}
+
+} // namespace JsonReflector
+} // namespace ReflectiveRapidJSON
+
+#endif // REFLECTIVE_RAPIDJSON_JSON_PARALLEL_H
@@ -0,0 +1,68 @@
+#ifndef REFLECTIVE_RAPIDJSON_JSON_POLICY_H
+#define REFLECTIVE_RAPIDJSON_JSON_POLICY_H
+
+/*!
+ * \file policy.h
+ * \brief Contains the JsonPolicy class which allows specifying at compile-time how JSON is parsed and written.
+ */
+
+#include "./numbers.h"
+#include "./writer.h"
+
+#include <rapidjson/reader.h>
+#include <rapidjson/writer.h>
+
+#include <type_traits>
+
+namespace ReflectiveRapidJSON {
+
+/*!
+ * \brief The JsonPolicy class specifies how JSON is parsed and written by JsonReflector::fromJson() and JsonReflector::toJson().
+ *
+ * The policy is passed as template argument, e.g. `JsonReflector::fromJson<Foo, JsonPolicy<kParseStopWhenDoneFlag>>(json)`
+ * or `Foo::fromJson<JsonPolicy<kParseStopWhenDoneFlag>>(json)`. So the flags are known at compile-time and RapidJSON can
+ * eliminate the code paths which are not required.
+ *
+ * \tparam parseFlagsValue Specifies RapidJSON's parse flags, e.g. kParseStopWhenDoneFlag, kParseFullPrecisionFlag or
+ *         kParseValidateEncodingFlag.
+ * \tparam writeFlagsValue Specifies RapidJSON's write flags, e.g. kWriteValidateEncodingFlag or kWriteNanAndInfFlag.
+ * \tparam numberBackendValue Specifies whether RapidJSON or std::to_chars/std::from_chars is used for numbers.
+ * \tparam reserveOutputValue Specifies whether JsonReflector::toJson() reserves the output buffer according to
+ *         JsonReflector::estimateJsonSize() before writing. That takes an additional pass over \a reflectable (doing most of
+ *         the work of writing except producing the output) so it only pays off if growing the buffer is expensive.
+ * \remarks
+ * - kParseInsituFlag is added by the fromJsonInsitu() functions and must not be specified here.
+ * - kParseNumbersAsStringsFlag is used internally by JsonNumberBackend::CharConv. Specifying it otherwise leads to
+ *   numbers being stored as strings in the document and therefore to type mismatches when deserializing.
+ * - The number backend is not taken into account by JsonReflector::fromJsonSax().
+ */
+template <unsigned int parseFlagsValue = RAPIDJSON_NAMESPACE::kParseDefaultFlags,
+    unsigned int writeFlagsValue = RAPIDJSON_NAMESPACE::kWriteDefaultFlags, JsonNumberBackend numberBackendValue = defaultJsonNumberBackend,
+    bool reserveOutputValue = false>
+struct JsonPolicy {
+    static_assert(!(parseFlagsValue & RAPIDJSON_NAMESPACE::kParseInsituFlag), "in-situ parsing is only possible via fromJsonInsitu()");
+
+    static constexpr unsigned int parseFlags = parseFlagsValue;
+    static constexpr unsigned int writeFlags = writeFlagsValue;
+    static constexpr JsonNumberBackend numberBackend = numberBackendValue;
+    static constexpr bool reserveOutput = reserveOutputValue;
+};
+
+/*!
+ * \brief The policy used when none is specified.
+ */
+using DefaultJsonPolicy = JsonPolicy<>;
+
+/*!
+ * \brief The writer used to write JSON according to \tparam Policy.
+ */
+template <typename OutputStream, typename Policy = DefaultJsonPolicy>
+using JsonWriter = FastStringWriter<
+    std::conditional_t<Policy::numberBackend == JsonNumberBackend::CharConv, CharConvWriter<OutputStream, Policy::writeFlags>,
+        RAPIDJSON_NAMESPACE::Writer<OutputStream, RAPIDJSON_NAMESPACE::UTF8<>, RAPIDJSON_NAMESPACE::UTF8<>, RAPIDJSON_NAMESPACE::CrtAllocator,
+            Policy::writeFlags>>,
+    Policy::writeFlags>;
+
+} // namespace ReflectiveRapidJSON
+
+#endif // REFLECTIVE_RAPIDJSON_JSON_POLICY_H
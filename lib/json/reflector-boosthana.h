@@ -16,6 +16,7 @@
 
 #include <boost/hana/adapt_struct.hpp>
 #include <boost/hana/at_key.hpp>
+#include <boost/hana/concept/struct.hpp>
 #include <boost/hana/define_struct.hpp>
 #include <boost/hana/for_each.hpp>
 #include <boost/hana/intersection.hpp>
@@ -34,6 +35,22 @@ void push(const Type &reflectable, RAPIDJSON_NAMESPACE::Value::Object &value, RA
     });
 }
 
+// define function to "write" values directly to a RapidJSON handler
+
+template <typename Type> struct HasCustomTypeWriter<Type, std::enable_if_t<boost::hana::Struct<Type>::value>> : public Traits::Bool<true> {};
+
+template <typename Type>
+template <typename Handler>
+RAPIDJSON_NAMESPACE::SizeType CustomTypeWriter<Type>::writeMembers(const Type &reflectable, Handler &handler)
+{
+    RAPIDJSON_NAMESPACE::SizeType memberCount = 0;
+    boost::hana::for_each(boost::hana::keys(reflectable), [&reflectable, &handler, &memberCount](auto key) {
+        write(boost::hana::at_key(reflectable, key), boost::hana::to<char const *>(key), handler);
+        ++memberCount;
+    });
+    return memberCount;
+}
+
 // define function to "pull" values from a RapidJSON array or object
 
 template <typename Type, Traits::DisableIf<IsBuiltInType<Type>> *>
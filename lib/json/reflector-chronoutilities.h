@@ -35,6 +35,24 @@ inline void push<CppUtilities::TimeSpan>(
     value.SetString(str.data(), rapidJsonSize(str.size()), allocator);
 }
 
+// define functions to "write" values directly to a RapidJSON handler
+
+template <>
+template <typename Handler>
+inline void CustomTypeWriter<CppUtilities::DateTime>::writeValue(const CppUtilities::DateTime &reflectable, Handler &handler)
+{
+    const std::string str(reflectable.toIsoString());
+    handler.String(str.data(), rapidJsonSize(str.size()), true);
+}
+
+template <>
+template <typename Handler>
+inline void CustomTypeWriter<CppUtilities::TimeSpan>::writeValue(const CppUtilities::TimeSpan &reflectable, Handler &handler)
+{
+    const std::string str(reflectable.toString());
+    handler.String(str.data(), rapidJsonSize(str.size()), true);
+}
+
 // define functions to "pull" values from a RapidJSON array or object
 
 template <>
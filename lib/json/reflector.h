@@ -16,19 +16,27 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <cstring>
 #include <limits>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <variant>
+#include <vector>
 
+#include "./context.h"
 #include "./errorhandling.h"
+#include "./estimator.h"
+#include "./numbers.h"
+#include "./policy.h"
+#include "./sink.h"
 
 namespace ReflectiveRapidJSON {
 
@@ -57,29 +65,203 @@ constexpr RAPIDJSON_NAMESPACE::SizeType rapidJsonSize(std::size_t size)
 }
 
 /*!
- * \brief Serializes the specified JSON \a document.
+ * \brief Serializes the specified JSON \a document according to the specified \tparam Policy.
  */
+template <typename Policy = DefaultJsonPolicy>
 inline RAPIDJSON_NAMESPACE::StringBuffer serializeJsonDocToString(RAPIDJSON_NAMESPACE::Document &document)
 {
     RAPIDJSON_NAMESPACE::StringBuffer buffer;
-    RAPIDJSON_NAMESPACE::Writer<RAPIDJSON_NAMESPACE::StringBuffer> writer(buffer);
+    JsonWriter<RAPIDJSON_NAMESPACE::StringBuffer, Policy> writer(buffer);
     document.Accept(writer);
     return buffer;
 }
 
 /*!
- * \brief Parses the specified JSON string.
+ * \brief Parses the specified JSON string according to the specified \tparam Policy.
  */
+template <typename Policy = DefaultJsonPolicy>
 inline RAPIDJSON_NAMESPACE::Document parseJsonDocFromString(const char *json, std::size_t jsonSize)
 {
     RAPIDJSON_NAMESPACE::Document document(RAPIDJSON_NAMESPACE::kObjectType);
-    const RAPIDJSON_NAMESPACE::ParseResult parseRes = document.Parse(json, jsonSize);
+    const RAPIDJSON_NAMESPACE::ParseResult parseRes = parseJson<Policy::parseFlags, Policy::numberBackend>(document, json, jsonSize);
     if (parseRes.IsError()) {
         throw parseRes;
     }
     return document;
 }
 
+/*!
+ * \brief The StringOutputStream struct allows RapidJSON's writer to append directly to an std::string.
+ */
+struct StringOutputStream {
+    using Ch = char;
+
+    explicit StringOutputStream(std::string &str)
+        : str(str)
+    {
+    }
+    void Put(char c)
+    {
+        str.push_back(c);
+    }
+    void put(const char *chars, std::size_t size)
+    {
+        str.append(chars, size);
+    }
+    void Flush()
+    {
+    }
+
+    std::string &str;
+};
+
+/*!
+ * \brief The InsituMemoryStream struct allows RapidJSON's parser to parse a mutable buffer of known size in-situ.
+ * \remarks Unlike RAPIDJSON_NAMESPACE::InsituStringStream the buffer does not need to be null-terminated.
+ */
+struct InsituMemoryStream {
+    using Ch = char;
+
+    InsituMemoryStream(char *buffer, std::size_t size)
+        : src(buffer)
+        , dst(nullptr)
+        , begin(buffer)
+        , end(buffer + size)
+    {
+    }
+    char Peek() const
+    {
+        return src != end ? *src : '\0';
+    }
+    char Take()
+    {
+        return src != end ? *src++ : '\0';
+    }
+    std::size_t Tell() const
+    {
+        return static_cast<std::size_t>(src - begin);
+    }
+    char *PutBegin()
+    {
+        return dst = src;
+    }
+    void Put(char c)
+    {
+        *dst++ = c;
+    }
+    std::size_t PutEnd(char *putBegin)
+    {
+        return static_cast<std::size_t>(dst - putBegin);
+    }
+    void Flush()
+    {
+    }
+
+    char *src;
+    char *dst;
+    char *begin;
+    char *end;
+};
+
+/*!
+ * \brief Parses the specified mutable JSON \a buffer in-situ so strings of the returned document point into \a buffer.
+ * \remarks The \a buffer is modified and must outlive the returned document.
+ */
+template <typename Policy = DefaultJsonPolicy>
+inline RAPIDJSON_NAMESPACE::Document parseJsonDocInsitu(char *buffer, std::size_t bufferSize)
+{
+    RAPIDJSON_NAMESPACE::Document document(RAPIDJSON_NAMESPACE::kObjectType);
+    InsituMemoryStream stream(buffer, bufferSize);
+    const RAPIDJSON_NAMESPACE::ParseResult parseRes
+        = parseJsonStream<Policy::parseFlags | RAPIDJSON_NAMESPACE::kParseInsituFlag, Policy::numberBackend>(document, stream);
+    if (parseRes.IsError()) {
+        throw parseRes;
+    }
+    return document;
+}
+
+namespace Detail {
+
+/*!
+ * \brief Constructs a key of \tparam Key from the specified JSON string taking its \a length into account if possible.
+ */
+template <typename Key> inline Key makeKey(const char *str, RAPIDJSON_NAMESPACE::SizeType length)
+{
+    if constexpr (std::is_constructible_v<Key, const char *, std::size_t>) {
+        return Key(str, length);
+    } else {
+        CPP_UTILITIES_UNUSED(length)
+        return Key(str);
+    }
+}
+
+/*!
+ * \brief Reserves space for the specified number of members if supported by the present RapidJSON version.
+ */
+template <typename Value, typename Allocator>
+inline auto reserveMembers(Value &value, RAPIDJSON_NAMESPACE::SizeType memberCount, Allocator &allocator)
+    -> decltype(value.MemberReserve(memberCount, allocator), void())
+{
+    value.MemberReserve(memberCount, allocator);
+}
+
+/*!
+ * \brief Does nothing because reserving space for members is not supported by the present RapidJSON version.
+ */
+template <typename... Args> inline void reserveMembers(Args &&...)
+{
+}
+
+/*!
+ * \brief The IsArithmeticVector class checks whether \tparam Type is an std::vector of numbers.
+ * \remarks Such vectors are (de)serialized via a fast path which avoids the per-element overhead of the generic path.
+ */
+template <typename Type> struct IsArithmeticVector : public Traits::Bool<false> {};
+template <typename ValueType, typename Allocator>
+struct IsArithmeticVector<std::vector<ValueType, Allocator>>
+    : public Traits::Bool<Traits::Any<std::is_floating_point<ValueType>,
+          Traits::All<std::is_integral<ValueType>, Traits::Not<std::is_same<ValueType, bool>>,
+              Traits::Any<std::is_same<ValueType, std::int8_t>, std::is_same<ValueType, std::uint8_t>,
+                  Traits::Bool<(sizeof(ValueType) >= sizeof(int))>>>>::value> {};
+
+/*!
+ * \brief Returns the specified \a number as one of the types RapidJSON's value can be constructed from.
+ */
+template <typename Type> inline auto jsonNumber(Type number)
+{
+    if constexpr (std::is_floating_point_v<Type>) {
+        return ReflectiveRapidJSON::Detail::jsonDouble(number);
+    } else if constexpr (std::is_signed_v<Type>) {
+        return static_cast<std::int64_t>(number);
+    } else {
+        return static_cast<std::uint64_t>(number);
+    }
+}
+
+/*!
+ * \brief Pulls the specified \a number from the specified \a value if it contains a number of the expected type.
+ * \returns Returns whether the \a number could be pulled; if not, the generic pull() must be used to convert the value
+ *          or to report the error.
+ */
+template <typename Type> inline bool pullNumber(Type &number, const RAPIDJSON_NAMESPACE::GenericValue<RAPIDJSON_NAMESPACE::UTF8<char>> &value)
+{
+    if constexpr (std::is_floating_point_v<Type>) {
+        if (!value.IsNumber()) {
+            return false;
+        }
+        number = static_cast<Type>(value.GetDouble());
+    } else {
+        using ExpectedType = Traits::Conditional<Traits::Any<std::is_same<Type, std::int8_t>, std::is_same<Type, std::uint8_t>>, int, Type>;
+        if (!value.Is<ExpectedType>()) {
+            return false;
+        }
+        number = static_cast<Type>(value.Get<ExpectedType>());
+    }
+    return true;
+}
+
+} // namespace Detail
+
 // define traits to distinguish between "built-in" types like int, std::string, std::vector, ... and custom structs/classes
 template <typename Type>
 using IsBuiltInType = Traits::Any<std::is_integral<Type>, std::is_floating_point<Type>, std::is_pointer<Type>, std::is_enum<Type>,
@@ -93,6 +275,14 @@ template <typename Type>
 using IsJsonSerializable
     = Traits::Any<Traits::Not<Traits::IsComplete<Type>>, std::is_base_of<JsonSerializable<Type>, Type>, AdaptedJsonSerializable<Type>>;
 
+/*!
+ * \brief The JsonMemberKeys class provides the keys of the members of \tparam Type as constexpr JsonMemberKey objects.
+ * \remarks
+ * - Specializations providing one static JsonMemberKey per member (named like the member) are emitted by the code generator.
+ * - The keys are used when pushing, writing and pulling members so names are neither measured nor escaped at runtime.
+ */
+template <typename Type> struct JsonMemberKeys;
+
 // define functions to "push" values to a RapidJSON array or object
 
 /*!
@@ -127,6 +317,13 @@ template <typename Type, Traits::DisableIf<IsJsonSerializable<Type>> * = nullptr
 void push(
     const Type &reflectable, const char *name, RAPIDJSON_NAMESPACE::Value::Object &value, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator);
 
+/*!
+ * \brief Pushes the specified \a reflectable as a member with the specified precomputed \a key to the specified object.
+ */
+template <typename Type>
+void push(const Type &reflectable, const JsonMemberKey &key, RAPIDJSON_NAMESPACE::Value::Object &value,
+    RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator);
+
 /*!
  * \brief Pushes the \a reflectable which has a custom type to the specified object.
  * \remarks The definition of this function must be provided by the code generator or Boost.Hana.
@@ -154,7 +351,11 @@ template <typename Type,
         std::is_floating_point<Type>> * = nullptr>
 inline void push(Type reflectable, RAPIDJSON_NAMESPACE::Value &value, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator)
 {
-    value.Set(reflectable, allocator);
+    if constexpr (std::is_floating_point_v<Type>) {
+        value.SetDouble(ReflectiveRapidJSON::Detail::jsonDouble(reflectable));
+    } else {
+        value.Set(reflectable, allocator);
+    }
 }
 
 /*!
@@ -220,8 +421,15 @@ void push(const Type &reflectable, RAPIDJSON_NAMESPACE::Value &value, RAPIDJSON_
     value.SetArray();
     RAPIDJSON_NAMESPACE::Value::Array array(value.GetArray());
     array.Reserve(rapidJsonSize(reflectable.size()), allocator);
-    for (const auto &item : reflectable) {
-        push(item, array, allocator);
+    if constexpr (Detail::IsArithmeticVector<Type>::value) {
+        for (const auto item : reflectable) {
+            RAPIDJSON_NAMESPACE::Value itemValue(Detail::jsonNumber(item));
+            array.PushBack(itemValue, allocator);
+        }
+    } else {
+        for (const auto &item : reflectable) {
+            push(item, array, allocator);
+        }
     }
 }
 
@@ -258,16 +466,43 @@ template <typename Type, Traits::EnableIfAny<IsMultiMapOrHash<Type>> * = nullptr
 void push(const Type &reflectable, RAPIDJSON_NAMESPACE::Value &value, RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator)
 {
     value.SetObject();
-    for (const auto &item : reflectable) {
-        const auto memberName = RAPIDJSON_NAMESPACE::Value::StringRefType(item.first.data(), rapidJsonSize(item.first.size()));
-        const auto existingMember = value.FindMember(memberName);
-        const auto arrayAlreadyExists
-            = existingMember != value.MemberEnd() && existingMember->value.GetType() == RAPIDJSON_NAMESPACE::Type::kArrayType;
-        auto newArrayValue = RAPIDJSON_NAMESPACE::Value{ RAPIDJSON_NAMESPACE::kArrayType };
-        RAPIDJSON_NAMESPACE::Value::Array array = arrayAlreadyExists ? existingMember->value.GetArray() : newArrayValue.GetArray();
-        push(item.second, array, allocator);
-        if (!arrayAlreadyExists) {
-            value.AddMember(memberName, newArrayValue, allocator);
+    if constexpr (Traits::IsSpecializingAnyOf<Type, std::multimap, std::unordered_multimap>::value) {
+        // elements with equivalent keys are adjacent in std::multimap and std::unordered_multimap so they can be grouped in one pass
+        const auto groupEnd = [end = reflectable.end()](auto i, RAPIDJSON_NAMESPACE::SizeType &count) {
+            const auto &key = i->first;
+            for (count = 0; i != end && i->first == key; ++i, ++count)
+                ;
+            return i;
+        };
+        auto memberCount = RAPIDJSON_NAMESPACE::SizeType();
+        auto count = RAPIDJSON_NAMESPACE::SizeType();
+        for (auto i = reflectable.begin(), end = reflectable.end(); i != end; i = groupEnd(i, count)) {
+            ++memberCount;
+        }
+        Detail::reserveMembers(value, memberCount, allocator);
+        for (auto i = reflectable.begin(), end = reflectable.end(); i != end;) {
+            const auto &key = i->first;
+            const auto last = groupEnd(i, count);
+            auto arrayValue = RAPIDJSON_NAMESPACE::Value(RAPIDJSON_NAMESPACE::kArrayType);
+            auto array = arrayValue.GetArray();
+            array.Reserve(count, allocator);
+            for (; i != last; ++i) {
+                push(i->second, array, allocator);
+            }
+            value.AddMember(RAPIDJSON_NAMESPACE::Value::StringRefType(key.data(), rapidJsonSize(key.size())), arrayValue, allocator);
+        }
+    } else {
+        // group elements via a temporary index of the member for each key if adjacency of equivalent keys is not guaranteed
+        auto memberIndex = std::unordered_map<std::string_view, RAPIDJSON_NAMESPACE::SizeType>();
+        for (const auto &item : reflectable) {
+            const auto [memberIterator, isNew]
+                = memberIndex.try_emplace(std::string_view(item.first.data(), item.first.size()), value.MemberCount());
+            if (isNew) {
+                value.AddMember(RAPIDJSON_NAMESPACE::Value::StringRefType(item.first.data(), rapidJsonSize(item.first.size())),
+                    RAPIDJSON_NAMESPACE::Value(RAPIDJSON_NAMESPACE::kArrayType), allocator);
+            }
+            auto array = (value.MemberBegin() + memberIterator->second)->value.GetArray();
+            push(item.second, array, allocator);
         }
     }
 }
@@ -409,6 +644,379 @@ void push(
     value.AddMember(RAPIDJSON_NAMESPACE::StringRef(name), genericValue, allocator);
 }
 
+/*!
+ * \brief Pushes the specified \a reflectable as a member with the specified precomputed \a key to the specified object.
+ * \remarks The key is referenced (not copied) so its length does not need to be determined.
+ */
+template <typename Type>
+inline void push(const Type &reflectable, const JsonMemberKey &key, RAPIDJSON_NAMESPACE::Value::Object &value,
+    RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator)
+{
+    RAPIDJSON_NAMESPACE::Value genericValue;
+    push(reflectable, genericValue, allocator);
+    value.AddMember(RAPIDJSON_NAMESPACE::StringRef(key.name, key.length), genericValue, allocator);
+}
+
+// define functions to "write" values directly to a RapidJSON handler (e.g. RAPIDJSON_NAMESPACE::Writer) without building a DOM
+
+/*!
+ * \brief The HasCustomTypeWriter class checks whether CustomTypeWriter<Type>::writeMembers() is defined for \tparam Type.
+ * \remarks Specializations are provided by the code generator and Boost.Hana along with the definition of writeMembers().
+ */
+template <typename Type, typename = void> struct HasCustomTypeWriter : public Traits::Bool<false> {};
+
+/*!
+ * \brief The CustomTypeWriter class writes custom types directly to a RapidJSON handler.
+ * \remarks
+ * - The definition of writeMembers() must be provided by the code generator or Boost.Hana (see HasCustomTypeWriter).
+ * - Custom types without writeMembers() are written via their push() functions using an intermediate document.
+ * - writeValue() might be specialized to serialize a custom type not as object, see reflector-chronoutilities.h.
+ */
+template <typename Type> struct CustomTypeWriter {
+    template <typename Handler> static void writeValue(const Type &reflectable, Handler &handler);
+    template <typename Handler> static RAPIDJSON_NAMESPACE::SizeType writeMembers(const Type &reflectable, Handler &handler);
+};
+
+/*!
+ * \brief Writes the specified \a reflectable which has a custom type to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::DisableIf<IsBuiltInType<Type>> * = nullptr>
+void write(const Type &reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified integer/float/boolean to the specified \a handler.
+ */
+template <typename Handler, typename Type,
+    Traits::EnableIfAny<
+        Traits::All<std::is_integral<Type>, Traits::Not<std::is_same<Type, std::uint8_t>>, Traits::Not<std::is_same<Type, std::int8_t>>>,
+        std::is_floating_point<Type>> * = nullptr>
+void write(Type reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified 8-bit integer to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::EnableIfAny<std::is_same<Type, std::uint8_t>, std::is_same<Type, std::int8_t>> * = nullptr>
+void write(Type reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified enumeration item to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::EnableIfAny<std::is_enum<Type>> * = nullptr> void write(Type reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified C-string to the specified \a handler.
+ */
+template <typename Handler, typename Type,
+    Traits::EnableIfAny<std::is_same<Type, const char *>, std::is_same<Type, const char *const &>> * = nullptr>
+void write(Type reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified std::string_view to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::EnableIf<std::is_same<Type, std::string_view>> * = nullptr>
+void write(Type reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified std::string to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::EnableIf<std::is_same<Type, std::string>> * = nullptr>
+void write(const Type &reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified iteratable (eg. std::vector, std::list) to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::EnableIf<IsArrayOrSet<Type>> * = nullptr>
+void write(const Type &reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified map (std::map, std::unordered_map) to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::EnableIfAny<IsMapOrHash<Type>> * = nullptr>
+void write(const Type &reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified multimap (std::multimap, std::unordered_multimap) to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::EnableIfAny<IsMultiMapOrHash<Type>> * = nullptr>
+void write(const Type &reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified tuple to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::tuple>> * = nullptr>
+void write(const Type &reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified pair to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> * = nullptr>
+void write(const Type &reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified unique_ptr, shared_ptr, weak_ptr or optional to the specified \a handler.
+ */
+template <typename Handler, typename Type,
+    Traits::EnableIfAny<Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::shared_ptr, std::weak_ptr, std::optional>> * = nullptr>
+void write(const Type &reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified variant to the specified \a handler.
+ */
+template <typename Handler, typename Type, Traits::EnableIf<IsVariant<Type>> * = nullptr> void write(const Type &reflectable, Handler &handler);
+
+/*!
+ * \brief Writes the specified \a reflectable as a member with the specified \a name to the specified \a handler.
+ * \remarks The caller is responsible for opening/closing the object the member belongs to.
+ */
+template <typename Handler, typename Type> void write(const Type &reflectable, const char *name, Handler &handler);
+
+/*!
+ * \brief Writes the specified \a reflectable as a member with the specified precomputed \a key to the specified \a handler.
+ * \remarks The key is written verbatim if the \a handler supports it (e.g. JsonWriter).
+ */
+template <typename Handler, typename Type> void write(const Type &reflectable, const JsonMemberKey &key, Handler &handler);
+
+namespace Detail {
+
+/*!
+ * \brief Writes the specified \a reflectable to the specified \a handler by pushing it to an intermediate document.
+ * \remarks This is used for custom types which only provide push() functions (e.g. hand-written ones).
+ */
+template <typename Type, typename Handler> void writeViaPush(const Type &reflectable, Handler &handler)
+{
+    RAPIDJSON_NAMESPACE::Document document;
+    push(reflectable, document, document.GetAllocator());
+    document.Accept(handler);
+}
+
+} // namespace Detail
+
+/*!
+ * \brief Writes the specified \a reflectable as object to the specified \a handler.
+ * \remarks Falls back to writing \a reflectable via its push() functions if writeMembers() is not defined for \tparam Type.
+ */
+template <typename Type> template <typename Handler> void CustomTypeWriter<Type>::writeValue(const Type &reflectable, Handler &handler)
+{
+    if constexpr (HasCustomTypeWriter<Type>::value) {
+        handler.StartObject();
+        handler.EndObject(writeMembers(reflectable, handler));
+    } else {
+        Detail::writeViaPush(reflectable, handler);
+    }
+}
+
+template <typename Handler, typename Type, Traits::DisableIf<IsBuiltInType<Type>> *> inline void write(const Type &reflectable, Handler &handler)
+{
+    CustomTypeWriter<Type>::writeValue(reflectable, handler);
+}
+
+template <typename Handler, typename Type,
+    Traits::EnableIfAny<
+        Traits::All<std::is_integral<Type>, Traits::Not<std::is_same<Type, std::uint8_t>>, Traits::Not<std::is_same<Type, std::int8_t>>>,
+        std::is_floating_point<Type>> *>
+inline void write(Type reflectable, Handler &handler)
+{
+    if constexpr (std::is_same_v<Type, bool>) {
+        handler.Bool(reflectable);
+    } else if constexpr (std::is_floating_point_v<Type>) {
+        ReflectiveRapidJSON::Detail::writeJsonNumber(reflectable, handler);
+    } else if constexpr (std::is_signed_v<Type>) {
+        if constexpr (sizeof(Type) <= sizeof(int)) {
+            handler.Int(static_cast<int>(reflectable));
+        } else {
+            handler.Int64(static_cast<std::int64_t>(reflectable));
+        }
+    } else {
+        if constexpr (sizeof(Type) <= sizeof(unsigned int)) {
+            handler.Uint(static_cast<unsigned int>(reflectable));
+        } else {
+            handler.Uint64(static_cast<std::uint64_t>(reflectable));
+        }
+    }
+}
+
+template <typename Handler, typename Type, Traits::EnableIfAny<std::is_same<Type, std::uint8_t>, std::is_same<Type, std::int8_t>> *>
+inline void write(Type reflectable, Handler &handler)
+{
+    handler.Int(static_cast<int>(reflectable));
+}
+
+template <typename Handler, typename Type, Traits::EnableIfAny<std::is_enum<Type>> *> inline void write(Type reflectable, Handler &handler)
+{
+    if constexpr (std::is_unsigned_v<std::underlying_type_t<Type>>) {
+        handler.Uint64(static_cast<std::uint64_t>(reflectable));
+    } else {
+        handler.Int64(static_cast<std::int64_t>(reflectable));
+    }
+}
+
+template <typename Handler, typename Type, Traits::EnableIfAny<std::is_same<Type, const char *>, std::is_same<Type, const char *const &>> *>
+inline void write(Type reflectable, Handler &handler)
+{
+    if (reflectable) {
+        handler.String(reflectable, rapidJsonSize(std::strlen(reflectable)), false);
+    } else {
+        handler.Null();
+    }
+}
+
+template <typename Handler, typename Type, Traits::EnableIf<std::is_same<Type, std::string_view>> *>
+inline void write(Type reflectable, Handler &handler)
+{
+    if (reflectable.data()) {
+        handler.String(reflectable.data(), rapidJsonSize(reflectable.size()), false);
+    } else {
+        handler.Null();
+    }
+}
+
+template <typename Handler, typename Type, Traits::EnableIf<std::is_same<Type, std::string>> *>
+inline void write(const Type &reflectable, Handler &handler)
+{
+    handler.String(reflectable.data(), rapidJsonSize(reflectable.size()), false);
+}
+
+template <typename Handler, typename Type, Traits::EnableIf<IsArrayOrSet<Type>> *> void write(const Type &reflectable, Handler &handler)
+{
+    RAPIDJSON_NAMESPACE::SizeType elementCount = 0;
+    handler.StartArray();
+    for (const auto &item : reflectable) {
+        write(item, handler);
+        ++elementCount;
+    }
+    handler.EndArray(elementCount);
+}
+
+template <typename Handler, typename Type, Traits::EnableIfAny<IsMapOrHash<Type>> *> void write(const Type &reflectable, Handler &handler)
+{
+    RAPIDJSON_NAMESPACE::SizeType memberCount = 0;
+    handler.StartObject();
+    for (const auto &item : reflectable) {
+        handler.Key(item.first.data(), rapidJsonSize(item.first.size()), false);
+        write(item.second, handler);
+        ++memberCount;
+    }
+    handler.EndObject(memberCount);
+}
+
+template <typename Handler, typename Type, Traits::EnableIfAny<IsMultiMapOrHash<Type>> *> void write(const Type &reflectable, Handler &handler)
+{
+    if constexpr (!Traits::IsSpecializingAnyOf<Type, std::multimap, std::unordered_multimap>::value) {
+        // group elements via a temporary index if adjacency of equivalent keys is not guaranteed
+        auto memberIndex = std::unordered_map<std::string_view, std::size_t>();
+        auto members = std::vector<std::pair<std::string_view, std::vector<const typename Type::mapped_type *>>>();
+        for (const auto &item : reflectable) {
+            const auto key = std::string_view(item.first.data(), item.first.size());
+            const auto [memberIterator, isNew] = memberIndex.try_emplace(key, members.size());
+            if (isNew) {
+                members.emplace_back(key, std::vector<const typename Type::mapped_type *>());
+            }
+            members[memberIterator->second].second.emplace_back(&item.second);
+        }
+        handler.StartObject();
+        for (const auto &[key, values] : members) {
+            handler.Key(key.data(), rapidJsonSize(key.size()), false);
+            handler.StartArray();
+            for (const auto *const value : values) {
+                write(*value, handler);
+            }
+            handler.EndArray(rapidJsonSize(values.size()));
+        }
+        handler.EndObject(rapidJsonSize(members.size()));
+        return;
+    }
+
+    // elements with equivalent keys are adjacent in std::multimap and std::unordered_multimap so they can be grouped in one pass
+    RAPIDJSON_NAMESPACE::SizeType memberCount = 0, elementCount = 0;
+    const typename Type::key_type *currentKey = nullptr;
+    handler.StartObject();
+    for (const auto &item : reflectable) {
+        if (!currentKey || !(*currentKey == item.first)) {
+            if (currentKey) {
+                handler.EndArray(elementCount);
+            }
+            currentKey = &item.first;
+            elementCount = 0;
+            handler.Key(item.first.data(), rapidJsonSize(item.first.size()), false);
+            handler.StartArray();
+            ++memberCount;
+        }
+        write(item.second, handler);
+        ++elementCount;
+    }
+    if (currentKey) {
+        handler.EndArray(elementCount);
+    }
+    handler.EndObject(memberCount);
+}
+
+template <typename Handler, typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::tuple>> *>
+void write(const Type &reflectable, Handler &handler)
+{
+    handler.StartArray();
+    std::apply([&handler](const auto &...elements) { (write(elements, handler), ...); }, reflectable);
+    handler.EndArray(std::tuple_size<Type>::value);
+}
+
+template <typename Handler, typename Type, Traits::EnableIf<Traits::IsSpecializationOf<Type, std::pair>> *>
+void write(const Type &reflectable, Handler &handler)
+{
+    handler.StartArray();
+    write(reflectable.first, handler);
+    write(reflectable.second, handler);
+    handler.EndArray(2);
+}
+
+template <typename Handler, typename Type,
+    Traits::EnableIfAny<Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::shared_ptr, std::weak_ptr, std::optional>> *>
+void write(const Type &reflectable, Handler &handler)
+{
+    if (!reflectable) {
+        handler.Null();
+        return;
+    }
+    write(*reflectable, handler);
+}
+
+template <typename Handler, typename Type, Traits::EnableIf<IsVariant<Type>> *> void write(const Type &reflectable, Handler &handler)
+{
+    if (reflectable.valueless_by_exception()) {
+        handler.Null();
+        return;
+    }
+
+    handler.StartObject();
+    handler.Key("index", 5, false);
+    handler.Uint64(reflectable.index());
+    handler.Key("data", 4, false);
+    std::visit(
+        [&handler](const auto &reflectableOfActualType) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(reflectableOfActualType)>, std::monostate>) {
+                write(reflectableOfActualType, handler);
+            } else {
+                handler.Null();
+            }
+        },
+        reflectable);
+    handler.EndObject(2);
+}
+
+template <typename Handler, typename Type> inline void write(const Type &reflectable, const char *name, Handler &handler)
+{
+    handler.Key(name, rapidJsonSize(std::strlen(name)), false);
+    write(reflectable, handler);
+}
+
+template <typename Handler, typename Type> inline void write(const Type &reflectable, const JsonMemberKey &key, Handler &handler)
+{
+    if constexpr (ReflectiveRapidJSON::Detail::SupportsMemberKey<Handler>::value) {
+        handler.Key(key);
+    } else {
+        handler.Key(key.name, key.length, false);
+    }
+    write(reflectable, handler);
+}
+
 // define functions to "pull" values from a RapidJSON array or object
 
 /*!
@@ -604,7 +1212,7 @@ inline void pull(
         }
         return;
     }
-    reflectable = value.GetString();
+    reflectable.assign(value.GetString(), value.GetStringLength());
 }
 
 /*!
@@ -664,6 +1272,25 @@ void pull(Type &reflectable, rapidjson::GenericValue<RAPIDJSON_NAMESPACE::UTF8<c
     // clear previous contents of the array
     reflectable.clear();
 
+    // pull numbers into the pre-sized vector and only resort to the generic pull() to convert the value or to report an error
+    if constexpr (Detail::IsArithmeticVector<Type>::value) {
+        reflectable.resize(array.Size());
+        auto *number = reflectable.data();
+        for (const rapidjson::GenericValue<RAPIDJSON_NAMESPACE::UTF8<char>> &item : array) {
+            if (!Detail::pullNumber(*number, item)) {
+                if (errors) {
+                    errors->currentIndex = static_cast<std::size_t>(number - reflectable.data());
+                }
+                pull(*number, item, errors);
+                if (errors) {
+                    errors->currentIndex = JsonDeserializationError::noIndex;
+                }
+            }
+            ++number;
+        }
+        return;
+    }
+
     // pull all array elements of the specified value
     std::size_t index = 0;
     for (const rapidjson::GenericValue<RAPIDJSON_NAMESPACE::UTF8<char>> &item : array) {
@@ -754,7 +1381,7 @@ void pull(Type &reflectable, const rapidjson::GenericValue<RAPIDJSON_NAMESPACE::
     }
     auto obj = value.GetObject();
     for (auto i = obj.MemberBegin(), end = obj.MemberEnd(); i != end; ++i) {
-        pull(reflectable[i->name.GetString()], i->value, errors);
+        pull(reflectable[Detail::makeKey<typename Type::key_type>(i->name.GetString(), i->name.GetStringLength())], i->value, errors);
     }
 }
 
@@ -773,13 +1400,15 @@ void pull(Type &reflectable, const rapidjson::GenericValue<RAPIDJSON_NAMESPACE::
     auto obj = value.GetObject();
     for (auto i = obj.MemberBegin(), end = obj.MemberEnd(); i != end; ++i) {
         if (i->value.GetType() != RAPIDJSON_NAMESPACE::kArrayType) {
-            auto insertedIterator = reflectable.insert(typename Type::value_type(i->name.GetString(), typename Type::mapped_type()));
+            auto insertedIterator = reflectable.insert(typename Type::value_type(
+                Detail::makeKey<typename Type::key_type>(i->name.GetString(), i->name.GetStringLength()), typename Type::mapped_type()));
             pull(insertedIterator->second, i->value, errors);
             continue;
         }
         const auto array = i->value.GetArray();
         for (const auto &arrayValue : array) {
-            auto insertedIterator = reflectable.insert(typename Type::value_type(i->name.GetString(), typename Type::mapped_type()));
+            auto insertedIterator = reflectable.insert(typename Type::value_type(
+                Detail::makeKey<typename Type::key_type>(i->name.GetString(), i->name.GetStringLength()), typename Type::mapped_type()));
             pull(insertedIterator->second, arrayValue, errors);
         }
     }
@@ -996,6 +1625,39 @@ inline void pull(Type &reflectable, const char *name, const rapidjson::GenericVa
     }
 }
 
+/*!
+ * \brief Pulls the specified member of \a reflectable from the specified \a memberValue which has already been looked up by the caller.
+ * \remarks
+ * - This is used by the generated code to dispatch all members within a single pass over the object instead of searching each member
+ *   via FindMember().
+ * - The error context for the current record is only changed if \a record is not nullptr. This allows members of base classes to be
+ *   reported with the record they have been declared in.
+ */
+template <typename Type>
+inline void pullMember(Type &reflectable, const char *record, const char *name,
+    const rapidjson::GenericValue<RAPIDJSON_NAMESPACE::UTF8<char>> &memberValue, JsonDeserializationErrors *errors)
+{
+    if (!errors) {
+        pull<Type>(reflectable, memberValue, errors);
+        return;
+    }
+
+    // set error context for current record/member
+    const char *const previousRecord = errors->currentRecord;
+    const char *const previousMember = errors->currentMember;
+    if (record) {
+        errors->currentRecord = record;
+    }
+    errors->currentMember = name;
+
+    // actually pull value for member
+    pull<Type>(reflectable, memberValue, errors);
+
+    // restore previous error context
+    errors->currentRecord = previousRecord;
+    errors->currentMember = previousMember;
+}
+
 /*!
  * \brief Pulls the \a reflectable which has a custom type from the specified value which is supposed and checked to contain an object.
  */
@@ -1011,6 +1673,16 @@ void pull(Type &reflectable, const RAPIDJSON_NAMESPACE::GenericValue<RAPIDJSON_N
     pull(reflectable, value.GetObject(), errors);
 }
 
+/*!
+ * \brief The CustomTypeReader class allows populating custom types incrementally via the JsonReaderHandler (see saxreader.h).
+ * \remarks
+ * - Specializations providing the record name and readMember() are emitted by the code generator.
+ * - Custom types without specialization can still be read via JsonReaderHandler. Their objects are captured and pulled as usual.
+ */
+template <typename Type> struct CustomTypeReader {
+    static constexpr bool isSupported = false;
+};
+
 // define functions providing high-level JSON serialization
 
 /*!
@@ -1031,7 +1703,11 @@ template <typename Type, Traits::EnableIfAny<std::is_integral<Type>, std::is_flo
 RAPIDJSON_NAMESPACE::Document toJsonDocument(Type reflectable)
 {
     RAPIDJSON_NAMESPACE::Document document(RAPIDJSON_NAMESPACE::kNumberType);
-    document.Set(reflectable, document.GetAllocator());
+    if constexpr (std::is_floating_point_v<Type>) {
+        document.SetDouble(ReflectiveRapidJSON::Detail::jsonDouble(reflectable));
+    } else {
+        document.Set(reflectable, document.GetAllocator());
+    }
     return document;
 }
 
@@ -1079,105 +1755,270 @@ template <typename Type, Traits::EnableIf<IsArray<Type>> * = nullptr> RAPIDJSON_
 }
 
 /*!
- * \brief Serializes the specified \a reflectable.
+ * \brief Returns the estimated size of the JSON the specified \a reflectable is serialized to.
+ * \remarks See JsonSizeEstimator for the accuracy of the estimation.
  */
 template <typename Type,
     Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>, std::is_integral<Type>, std::is_floating_point<Type>,
         Traits::IsString<Type>, IsArray<Type>> * = nullptr>
+std::size_t estimateJsonSize(const Type &reflectable)
+{
+    JsonSizeEstimator estimator;
+    write(reflectable, estimator);
+    return estimator.size();
+}
+
+/*!
+ * \brief Serializes the specified \a reflectable according to the specified \tparam Policy.
+ * \remarks The buffer is reserved upfront according to estimateJsonSize() if enabled via JsonPolicy::reserveOutput.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy,
+    Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>, std::is_integral<Type>, std::is_floating_point<Type>,
+        Traits::IsString<Type>, IsArray<Type>> * = nullptr>
 RAPIDJSON_NAMESPACE::StringBuffer toJson(const Type &reflectable)
 {
-    auto document(toJsonDocument(reflectable));
-    return serializeJsonDocToString(document);
+    RAPIDJSON_NAMESPACE::StringBuffer buffer;
+    if constexpr (Policy::reserveOutput) {
+        buffer.Reserve(estimateJsonSize(reflectable));
+    }
+    JsonWriter<RAPIDJSON_NAMESPACE::StringBuffer, Policy> writer(buffer);
+    write(reflectable, writer);
+    return buffer;
+}
+
+/*!
+ * \brief Serializes the specified \a reflectable into the output buffer of the specified \a context.
+ * \remarks The returned buffer is owned by \a context and only valid until \a context is used again.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy,
+    Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>, std::is_integral<Type>, std::is_floating_point<Type>,
+        Traits::IsString<Type>, IsArray<Type>> * = nullptr>
+const RAPIDJSON_NAMESPACE::StringBuffer &toJson(const Type &reflectable, JsonSerializationContext &context)
+{
+    if constexpr (std::is_same_v<JsonWriter<RAPIDJSON_NAMESPACE::StringBuffer, Policy>, JsonSerializationContext::Writer>) {
+        write(reflectable, context.startWriting());
+    } else {
+        context.startWriting();
+        JsonWriter<RAPIDJSON_NAMESPACE::StringBuffer, Policy> writer(context.output());
+        write(reflectable, writer);
+    }
+    return context.output();
+}
+
+/*!
+ * \brief Serializes the specified \a reflectable directly into the specified \a output string.
+ * \remarks The previous contents of \a output are replaced but its capacity is reused. If \a output has no capacity yet
+ *          and JsonPolicy::reserveOutput is enabled, it is reserved upfront according to estimateJsonSize().
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy,
+    Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>, std::is_integral<Type>, std::is_floating_point<Type>,
+        Traits::IsString<Type>, IsArray<Type>> * = nullptr>
+void toJson(const Type &reflectable, std::string &output)
+{
+    output.clear();
+    if constexpr (Policy::reserveOutput) {
+        if (output.capacity() <= std::string().capacity()) {
+            output.reserve(estimateJsonSize(reflectable));
+        }
+    }
+    StringOutputStream stream(output);
+    JsonWriter<StringOutputStream, Policy> writer(stream);
+    write(reflectable, writer);
+}
+
+/*!
+ * \brief Serializes the specified \a reflectable to the specified \a sink.
+ * \remarks The output is written through the fixed-size buffer of \a sink without building the JSON in memory. The sink is
+ *          flushed at the end.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy,
+    Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>, std::is_integral<Type>, std::is_floating_point<Type>,
+        Traits::IsString<Type>, IsArray<Type>> * = nullptr>
+void toJson(const Type &reflectable, JsonSink &sink)
+{
+    JsonWriter<JsonSink, Policy> writer(sink);
+    write(reflectable, writer);
+    sink.flush();
+}
+
+/*!
+ * \brief Serializes the specified \a reflectable to the specified \a stream.
+ * \remarks The output is written through a fixed-size buffer without building the JSON in memory.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy,
+    Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>, std::is_integral<Type>, std::is_floating_point<Type>,
+        Traits::IsString<Type>, IsArray<Type>> * = nullptr>
+void toJson(const Type &reflectable, std::ostream &stream)
+{
+    JsonOStreamSink sink(stream);
+    toJson<Type, Policy>(reflectable, static_cast<JsonSink &>(sink));
 }
 
 // define functions providing high-level JSON deserialization
 
 /*!
- * \brief Deserializes the specified JSON to \tparam Type which is a custom type or can be mapped to an object.
+ * \brief Deserializes the specified JSON \a document to \tparam Type which is a custom type or can be mapped to an object.
  */
 template <typename Type, Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>> * = nullptr>
-Type fromJson(const char *json, std::size_t jsonSize, JsonDeserializationErrors *errors = nullptr)
+Type fromJsonDocument(const RAPIDJSON_NAMESPACE::Value &document, JsonDeserializationErrors *errors = nullptr)
 {
-    RAPIDJSON_NAMESPACE::Document doc(parseJsonDocFromString(json, jsonSize));
-    if (!doc.IsObject()) {
+    if (!document.IsObject()) {
         if (errors) {
-            errors->reportTypeMismatch<Type>(doc.GetType());
+            errors->reportTypeMismatch<Type>(document.GetType());
         }
         return Type();
     }
 
     Type res;
-    pull<Type>(res, doc.GetObject(), errors);
+    pull<Type>(res, document.GetObject(), errors);
     return res;
 }
 
 /*!
- * \brief Deserializes the specified JSON to \tparam Type which is an integer, float or boolean.
+ * \brief Deserializes the specified JSON \a document to \tparam Type which is an integer, float or boolean.
  */
 template <typename Type, Traits::EnableIfAny<std::is_integral<Type>, std::is_floating_point<Type>> * = nullptr>
-Type fromJson(const char *json, std::size_t jsonSize, JsonDeserializationErrors *errors = nullptr)
+Type fromJsonDocument(const RAPIDJSON_NAMESPACE::Value &document, JsonDeserializationErrors *errors = nullptr)
 {
-    RAPIDJSON_NAMESPACE::Document doc(parseJsonDocFromString(json, jsonSize));
-    if (!doc.Is<Type>()) {
+    if (!document.Is<Type>()) {
         if (errors) {
-            errors->reportTypeMismatch<Type>(doc.GetType());
+            errors->reportTypeMismatch<Type>(document.GetType());
         }
         return Type();
     }
 
-    return doc.Get<Type>();
+    return document.Get<Type>();
 }
 
 /*!
- * \brief Deserializes the specified JSON to \tparam Type which is a std::string.
+ * \brief Deserializes the specified JSON \a document to \tparam Type which is a std::string.
  */
 template <typename Type, Traits::EnableIf<std::is_same<Type, std::string>> * = nullptr>
-Type fromJson(const char *json, std::size_t jsonSize, JsonDeserializationErrors *errors = nullptr)
+Type fromJsonDocument(const RAPIDJSON_NAMESPACE::Value &document, JsonDeserializationErrors *errors = nullptr)
 {
-    RAPIDJSON_NAMESPACE::Document doc(parseJsonDocFromString(json, jsonSize));
-    if (!doc.IsString()) {
+    if (!document.IsString()) {
         if (errors) {
-            errors->reportTypeMismatch<Type>(doc.GetType());
+            errors->reportTypeMismatch<Type>(document.GetType());
         }
         return Type();
     }
 
-    return doc.GetString();
+    return Type(document.GetString(), document.GetStringLength());
 }
 
 /*!
- * \brief Deserializes the specified JSON to \tparam Type which can be mapped to an array.
+ * \brief Deserializes the specified JSON \a document to \tparam Type which can be mapped to an array.
  */
 template <typename Type, Traits::EnableIf<IsArray<Type>> * = nullptr>
-Type fromJson(const char *json, std::size_t jsonSize, JsonDeserializationErrors *errors = nullptr)
+Type fromJsonDocument(const RAPIDJSON_NAMESPACE::Value &document, JsonDeserializationErrors *errors = nullptr)
 {
-    RAPIDJSON_NAMESPACE::Document doc(parseJsonDocFromString(json, jsonSize));
-    if (!doc.IsArray()) {
+    if (!document.IsArray()) {
         if (errors) {
-            errors->reportTypeMismatch<Type>(doc.GetType());
+            errors->reportTypeMismatch<Type>(document.GetType());
         }
         return Type();
     }
 
     Type res;
-    pull<Type>(res, doc.GetArray(), errors);
+    pull<Type>(res, document.GetArray(), errors);
     return res;
 }
 
+/*!
+ * \brief Deserializes the specified JSON to \tparam Type parsing it according to the specified \tparam Policy.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy,
+    Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>, std::is_integral<Type>, std::is_floating_point<Type>,
+        std::is_same<Type, std::string>, IsArray<Type>> * = nullptr>
+Type fromJson(const char *json, std::size_t jsonSize, JsonDeserializationErrors *errors = nullptr)
+{
+    const RAPIDJSON_NAMESPACE::Document doc(parseJsonDocFromString<Policy>(json, jsonSize));
+    return fromJsonDocument<Type>(doc, errors);
+}
+
+/*!
+ * \brief Deserializes the specified JSON to \tparam Type using the document of the specified \a context.
+ * \remarks The memory used by the document of \a context is reused and kept for subsequent calls.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy,
+    Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>, std::is_integral<Type>, std::is_floating_point<Type>,
+        std::is_same<Type, std::string>, IsArray<Type>> * = nullptr>
+Type fromJson(const char *json, std::size_t jsonSize, JsonSerializationContext &context, JsonDeserializationErrors *errors = nullptr)
+{
+    auto &doc = context.startParsing();
+    const RAPIDJSON_NAMESPACE::ParseResult parseRes = parseJson<Policy::parseFlags, Policy::numberBackend>(doc, json, jsonSize);
+    if (parseRes.IsError()) {
+        throw parseRes;
+    }
+    return fromJsonDocument<Type>(doc, errors);
+}
+
+/*!
+ * \brief Deserializes the specified JSON to \tparam Type parsing the mutable \a buffer in-situ.
+ * \remarks
+ * - Strings are not copied into an intermediate document but assigned directly from \a buffer.
+ * - The contents of \a buffer are modified.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy,
+    Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>, std::is_integral<Type>, std::is_floating_point<Type>,
+        std::is_same<Type, std::string>, IsArray<Type>> * = nullptr>
+Type fromJsonInsitu(char *buffer, std::size_t bufferSize, JsonDeserializationErrors *errors = nullptr)
+{
+    const RAPIDJSON_NAMESPACE::Document doc(parseJsonDocInsitu<Policy>(buffer, bufferSize));
+    return fromJsonDocument<Type>(doc, errors);
+}
+
+/*!
+ * \brief Deserializes the specified JSON to \tparam Type parsing the mutable \a buffer in-situ using the document of the specified \a context.
+ * \remarks The contents of \a buffer are modified.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy,
+    Traits::EnableIfAny<IsJsonSerializable<Type>, IsMapOrHash<Type>, IsMultiMapOrHash<Type>, std::is_integral<Type>, std::is_floating_point<Type>,
+        std::is_same<Type, std::string>, IsArray<Type>> * = nullptr>
+Type fromJsonInsitu(char *buffer, std::size_t bufferSize, JsonSerializationContext &context, JsonDeserializationErrors *errors = nullptr)
+{
+    auto &doc = context.startParsing();
+    InsituMemoryStream stream(buffer, bufferSize);
+    const RAPIDJSON_NAMESPACE::ParseResult parseRes
+        = parseJsonStream<Policy::parseFlags | RAPIDJSON_NAMESPACE::kParseInsituFlag, Policy::numberBackend>(doc, stream);
+    if (parseRes.IsError()) {
+        throw parseRes;
+    }
+    return fromJsonDocument<Type>(doc, errors);
+}
+
+/*!
+ * \brief Deserializes the specified JSON from an std::string to \tparam Type parsing \a json in-situ.
+ * \remarks The contents of \a json are modified.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy> Type fromJsonInsitu(std::string &json, JsonDeserializationErrors *errors = nullptr)
+{
+    return fromJsonInsitu<Type, Policy>(json.data(), json.size(), errors);
+}
+
+/*!
+ * \brief Deserializes the specified JSON from an std::string to \tparam Type using the document of the specified \a context.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy>
+Type fromJson(const std::string &json, JsonSerializationContext &context, JsonDeserializationErrors *errors = nullptr)
+{
+    return fromJson<Type, Policy>(json.data(), json.size(), context, errors);
+}
+
 /*!
  * \brief Deserializes the specified JSON from an null-terminated C-string to \tparam Type.
  */
-template <typename Type> Type fromJson(const char *json, JsonDeserializationErrors *errors = nullptr)
+template <typename Type, typename Policy = DefaultJsonPolicy> Type fromJson(const char *json, JsonDeserializationErrors *errors = nullptr)
 {
-    return fromJson<Type>(json, std::strlen(json), errors);
+    return fromJson<Type, Policy>(json, std::strlen(json), errors);
 }
 
 /*!
  * \brief Deserializes the specified JSON from an std::string to \tparam Type.
  */
-template <typename Type> Type fromJson(const std::string &json, JsonDeserializationErrors *errors = nullptr)
+template <typename Type, typename Policy = DefaultJsonPolicy> Type fromJson(const std::string &json, JsonDeserializationErrors *errors = nullptr)
 {
-    return fromJson<Type>(json.data(), json.size(), errors);
+    return fromJson<Type, Policy>(json.data(), json.size(), errors);
 }
 
 } // namespace JsonReflector
@@ -0,0 +1,532 @@
+#ifndef REFLECTIVE_RAPIDJSON_JSON_SAX_READER_H
+#define REFLECTIVE_RAPIDJSON_JSON_SAX_READER_H
+
+/*!
+ * \file saxreader.h
+ * \brief Contains the JsonReaderHandler which deserializes JSON via RapidJSON's SAX API straight into C++ objects
+ *        without building an intermediate RAPIDJSON_NAMESPACE::Document.
+ */
+
+#include "./reflector.h"
+
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
+#include <vector>
+
+namespace ReflectiveRapidJSON {
+namespace JsonReflector {
+
+struct JsonReaderFrame;
+struct JsonReaderSlot;
+
+/*!
+ * \brief The JsonReaderFunctions struct holds the type-specific functions the JsonReaderHandler uses to populate a value.
+ */
+struct JsonReaderFunctions {
+    /// \brief Pulls the value from the specified scalar or captured \a value.
+    void (*pullValue)(void *target, const RAPIDJSON_NAMESPACE::Value &value, JsonDeserializationErrors *errors);
+    /// \brief Prepares populating the value incrementally; returns false if the object/array needs to be captured and pulled instead.
+    bool (*start)(JsonReaderFrame &frame, bool isObject, JsonDeserializationErrors *errors);
+    /// \brief Determines the slot for the member with the specified name; returns false if the member is unknown.
+    bool (*member)(JsonReaderFrame &frame, const char *name, RAPIDJSON_NAMESPACE::SizeType nameLength, JsonReaderSlot &slot);
+    /// \brief Determines the slot for the next array element.
+    void (*element)(JsonReaderFrame &frame, JsonReaderSlot &slot);
+    /// \brief Finishes populating the value after the object/array has been ended.
+    void (*end)(JsonReaderFrame &frame, JsonDeserializationErrors *errors);
+};
+
+/*!
+ * \brief The JsonReaderSlot struct refers to a value which is about to be populated by the JsonReaderHandler.
+ * \remarks A slot without functions denotes a value which is skipped (e.g. an unknown member).
+ */
+struct JsonReaderSlot {
+    template <typename Type>
+    static JsonReaderSlot of(
+        Type &reflectable, const char *member = nullptr, const char *record = nullptr, std::size_t index = JsonDeserializationError::noIndex);
+
+    /// \brief The type-specific functions to populate the value.
+    const JsonReaderFunctions *functions = nullptr;
+    /// \brief The value to populate.
+    void *target = nullptr;
+    /// \brief The member name to be used as error context or nullptr if the value is not a member.
+    const char *member = nullptr;
+    /// \brief The record name to be used as error context or nullptr to keep the current record (used for members of base classes).
+    const char *record = nullptr;
+    /// \brief The array index to be used as error context or JsonDeserializationError::noIndex if the value is not an array element.
+    std::size_t index = JsonDeserializationError::noIndex;
+};
+
+/*!
+ * \brief The JsonReaderFrame struct holds the state of an object or array which is currently populated by the JsonReaderHandler.
+ */
+struct JsonReaderFrame {
+    /// \brief The value populated from the object/array.
+    JsonReaderSlot slot;
+    /// \brief The record of the error context before entering the object/array.
+    const char *previousRecord = nullptr;
+    /// \brief The member of the error context before entering the object/array.
+    const char *previousMember = nullptr;
+    /// \brief The number of array elements read so far.
+    std::size_t elementCount = 0;
+    /// \brief Whether the frame represents an object (and not an array).
+    bool isObject = false;
+    /// \brief Whether the object/array is captured and pulled as a whole after it has been ended.
+    bool isCaptured = false;
+};
+
+/// \cond
+namespace Detail {
+template <typename Type> struct JsonReaderTraits {
+    static void pullValue(void *target, const RAPIDJSON_NAMESPACE::Value &value, JsonDeserializationErrors *errors);
+    static bool start(JsonReaderFrame &frame, bool isObject, JsonDeserializationErrors *errors);
+    static bool member(JsonReaderFrame &frame, const char *name, RAPIDJSON_NAMESPACE::SizeType nameLength, JsonReaderSlot &slot);
+    static void element(JsonReaderFrame &frame, JsonReaderSlot &slot);
+    static void end(JsonReaderFrame &frame, JsonDeserializationErrors *errors);
+
+    static constexpr JsonReaderFunctions functions = { &pullValue, &start, &member, &element, &end };
+};
+
+template <typename Type>
+using IsIncrementallyReadableArray = Traits::All<IsArray<Type>, Traits::Not<Traits::IsSpecializationOf<Type, std::basic_string_view>>>;
+
+template <typename Type>
+void JsonReaderTraits<Type>::pullValue(void *target, const RAPIDJSON_NAMESPACE::Value &value, JsonDeserializationErrors *errors)
+{
+    JsonReflector::pull<Type>(*static_cast<Type *>(target), value, errors);
+}
+
+template <typename Type> bool JsonReaderTraits<Type>::start(JsonReaderFrame &frame, bool isObject, JsonDeserializationErrors *errors)
+{
+    auto &reflectable = *static_cast<Type *>(frame.slot.target);
+    if constexpr (Traits::IsSpecializingAnyOf<Type, std::unique_ptr, std::shared_ptr, std::optional>::value) {
+        // create the contained value and continue with it
+        if constexpr (Traits::IsSpecializationOf<Type, std::unique_ptr>::value) {
+            reflectable = std::make_unique<typename Type::element_type>();
+        } else if constexpr (Traits::IsSpecializationOf<Type, std::shared_ptr>::value) {
+            reflectable = std::make_shared<typename Type::element_type>();
+        } else {
+            reflectable.emplace();
+        }
+        frame.slot.functions = &JsonReaderTraits<std::remove_reference_t<decltype(*reflectable)>>::functions;
+        frame.slot.target = &*reflectable;
+        return frame.slot.functions->start(frame, isObject, errors);
+    } else if constexpr (IsIncrementallyReadableArray<Type>::value) {
+        if (isObject) {
+            return false;
+        }
+        reflectable.clear();
+        return true;
+    } else if constexpr (IsMapOrHash<Type>::value) {
+        return isObject;
+    } else if constexpr (CustomTypeReader<Type>::isSupported) {
+        if (!isObject) {
+            return false;
+        }
+        if (errors) {
+            errors->currentRecord = CustomTypeReader<Type>::record;
+        }
+        return true;
+    } else {
+        // capture the object/array of all remaining types (e.g. tuples, sets, multimaps, variants, custom types without CustomTypeReader)
+        CPP_UTILITIES_UNUSED(reflectable)
+        CPP_UTILITIES_UNUSED(isObject)
+        CPP_UTILITIES_UNUSED(errors)
+        return false;
+    }
+}
+
+template <typename Type>
+bool JsonReaderTraits<Type>::member(JsonReaderFrame &frame, const char *name, RAPIDJSON_NAMESPACE::SizeType nameLength, JsonReaderSlot &slot)
+{
+    auto &reflectable = *static_cast<Type *>(frame.slot.target);
+    if constexpr (IsMapOrHash<Type>::value) {
+        slot = JsonReaderSlot::of(reflectable[Detail::makeKey<typename Type::key_type>(name, nameLength)]);
+        return true;
+    } else if constexpr (CustomTypeReader<Type>::isSupported) {
+        return CustomTypeReader<Type>::readMember(reflectable, name, nameLength, slot);
+    } else {
+        CPP_UTILITIES_UNUSED(reflectable)
+        CPP_UTILITIES_UNUSED(name)
+        CPP_UTILITIES_UNUSED(nameLength)
+        CPP_UTILITIES_UNUSED(slot)
+        return false;
+    }
+}
+
+template <typename Type> void JsonReaderTraits<Type>::element(JsonReaderFrame &frame, JsonReaderSlot &slot)
+{
+    if constexpr (IsIncrementallyReadableArray<Type>::value) {
+        auto &reflectable = *static_cast<Type *>(frame.slot.target);
+        reflectable.emplace_back();
+        slot = JsonReaderSlot::of(reflectable.back(), nullptr, nullptr, frame.elementCount++);
+    } else {
+        CPP_UTILITIES_UNUSED(frame)
+        slot = JsonReaderSlot();
+    }
+}
+
+template <typename Type> void JsonReaderTraits<Type>::end(JsonReaderFrame &frame, JsonDeserializationErrors *errors)
+{
+    CPP_UTILITIES_UNUSED(frame)
+    if constexpr (IsIncrementallyReadableArray<Type>::value) {
+        // clear error context
+        if (errors) {
+            errors->currentIndex = JsonDeserializationError::noIndex;
+        }
+    } else {
+        CPP_UTILITIES_UNUSED(errors)
+    }
+}
+} // namespace Detail
+/// \endcond
+
+/*!
+ * \brief Returns a slot referring to the specified \a reflectable.
+ */
+template <typename Type> inline JsonReaderSlot JsonReaderSlot::of(Type &reflectable, const char *member, const char *record, std::size_t index)
+{
+    return JsonReaderSlot{ &Detail::JsonReaderTraits<Type>::functions, &reflectable, member, record, index };
+}
+
+/*!
+ * \brief The JsonReaderHandler class populates C++ objects incrementally from the events of a RAPIDJSON_NAMESPACE::Reader.
+ *
+ * Custom types are populated member by member via CustomTypeReader<Type>::readMember() which is provided by the code generator.
+ * Arrays (eg. std::vector, std::list), maps as well as std::unique_ptr, std::shared_ptr and std::optional are populated incrementally
+ * as well. Values of all other types (eg. tuples, sets, multimaps, variants, custom types without CustomTypeReader) are captured when
+ * they are objects or arrays and then pulled as usual. Scalar values are always pulled directly from the event without copying strings.
+ *
+ * Errors are reported to the specified JsonDeserializationErrors with the same record/member/index context as when using pull().
+ */
+class JsonReaderHandler {
+public:
+    explicit JsonReaderHandler(const JsonReaderSlot &root, JsonDeserializationErrors *errors = nullptr);
+
+    bool Null();
+    bool Bool(bool b);
+    bool Int(int i);
+    bool Uint(unsigned int u);
+    bool Int64(std::int64_t i);
+    bool Uint64(std::uint64_t u);
+    bool Double(double d);
+    bool RawNumber(const char *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy);
+    bool String(const char *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy);
+    bool StartObject();
+    bool Key(const char *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy);
+    bool EndObject(RAPIDJSON_NAMESPACE::SizeType memberCount);
+    bool StartArray();
+    bool EndArray(RAPIDJSON_NAMESPACE::SizeType elementCount);
+
+private:
+    bool nextSlot(JsonReaderSlot &slot);
+    void enterContext(const JsonReaderSlot &slot, const char *&previousRecord, const char *&previousMember);
+    void leaveContext(const char *previousRecord, const char *previousMember);
+    bool scalar(const RAPIDJSON_NAMESPACE::Value &value);
+    bool start(bool isObject);
+    bool end();
+    void finishCapture();
+
+    JsonReaderSlot m_root;
+    JsonReaderSlot m_pendingMember;
+    JsonDeserializationErrors *m_errors;
+    std::vector<JsonReaderFrame> m_frames;
+    std::size_t m_captureDepth;
+    std::vector<RAPIDJSON_NAMESPACE::Value> m_captured;
+    RAPIDJSON_NAMESPACE::Document::AllocatorType m_captureAllocator;
+};
+
+/*!
+ * \brief Constructs a new handler to populate the specified \a root slot.
+ */
+inline JsonReaderHandler::JsonReaderHandler(const JsonReaderSlot &root, JsonDeserializationErrors *errors)
+    : m_root(root)
+    , m_errors(errors)
+    , m_captureDepth(0)
+{
+}
+
+/*!
+ * \brief Determines the slot for the next value. Returns false if the value is supposed to be skipped.
+ */
+inline bool JsonReaderHandler::nextSlot(JsonReaderSlot &slot)
+{
+    if (m_frames.empty()) {
+        slot = m_root;
+    } else if (JsonReaderFrame &frame = m_frames.back(); !frame.slot.functions) {
+        slot = JsonReaderSlot();
+    } else if (frame.isObject) {
+        slot = m_pendingMember;
+    } else {
+        frame.slot.functions->element(frame, slot);
+    }
+    return slot.functions != nullptr;
+}
+
+/*!
+ * \brief Sets the error context for the value referred by the specified \a slot.
+ */
+inline void JsonReaderHandler::enterContext(const JsonReaderSlot &slot, const char *&previousRecord, const char *&previousMember)
+{
+    if (!m_errors) {
+        return;
+    }
+    previousRecord = m_errors->currentRecord;
+    previousMember = m_errors->currentMember;
+    if (slot.record) {
+        m_errors->currentRecord = slot.record;
+    }
+    if (slot.member) {
+        m_errors->currentMember = slot.member;
+    }
+    if (slot.index != JsonDeserializationError::noIndex) {
+        m_errors->currentIndex = slot.index;
+    }
+}
+
+/*!
+ * \brief Restores the error context.
+ */
+inline void JsonReaderHandler::leaveContext(const char *previousRecord, const char *previousMember)
+{
+    if (m_errors) {
+        m_errors->currentRecord = previousRecord;
+        m_errors->currentMember = previousMember;
+    }
+}
+
+/*!
+ * \brief Pulls the next value from the specified scalar \a value.
+ */
+inline bool JsonReaderHandler::scalar(const RAPIDJSON_NAMESPACE::Value &value)
+{
+    if (m_captureDepth) {
+        m_captured.emplace_back(value, m_captureAllocator);
+        return true;
+    }
+    JsonReaderSlot slot;
+    if (!nextSlot(slot)) {
+        return true;
+    }
+    const char *previousRecord = nullptr, *previousMember = nullptr;
+    enterContext(slot, previousRecord, previousMember);
+    slot.functions->pullValue(slot.target, value, m_errors);
+    leaveContext(previousRecord, previousMember);
+    return true;
+}
+
+inline bool JsonReaderHandler::Null()
+{
+    return scalar(RAPIDJSON_NAMESPACE::Value());
+}
+
+inline bool JsonReaderHandler::Bool(bool b)
+{
+    return scalar(RAPIDJSON_NAMESPACE::Value(b));
+}
+
+inline bool JsonReaderHandler::Int(int i)
+{
+    return scalar(RAPIDJSON_NAMESPACE::Value(i));
+}
+
+inline bool JsonReaderHandler::Uint(unsigned int u)
+{
+    return scalar(RAPIDJSON_NAMESPACE::Value(u));
+}
+
+inline bool JsonReaderHandler::Int64(std::int64_t i)
+{
+    return scalar(RAPIDJSON_NAMESPACE::Value(i));
+}
+
+inline bool JsonReaderHandler::Uint64(std::uint64_t u)
+{
+    return scalar(RAPIDJSON_NAMESPACE::Value(u));
+}
+
+inline bool JsonReaderHandler::Double(double d)
+{
+    return scalar(RAPIDJSON_NAMESPACE::Value(d));
+}
+
+/*!
+ * \brief Handles numbers parsed with RAPIDJSON_NAMESPACE::kParseNumbersAsStringsFlag like RAPIDJSON_NAMESPACE::Document does (as strings).
+ */
+inline bool JsonReaderHandler::RawNumber(const char *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy)
+{
+    return String(str, length, copy);
+}
+
+/*!
+ * \brief Pulls the next value from the specified string.
+ * \remarks The string is only copied if it is part of a captured object/array.
+ */
+inline bool JsonReaderHandler::String(const char *str, RAPIDJSON_NAMESPACE::SizeType length, bool)
+{
+    if (m_captureDepth) {
+        m_captured.emplace_back(str, length, m_captureAllocator);
+        return true;
+    }
+    return scalar(RAPIDJSON_NAMESPACE::Value(RAPIDJSON_NAMESPACE::StringRef(str, length)));
+}
+
+/*!
+ * \brief Enters the next value which is an object or an array.
+ */
+inline bool JsonReaderHandler::start(bool isObject)
+{
+    if (m_captureDepth) {
+        ++m_captureDepth;
+        return true;
+    }
+    JsonReaderSlot slot;
+    const auto skip = !nextSlot(slot);
+    JsonReaderFrame &frame = m_frames.emplace_back();
+    frame.slot = slot;
+    frame.isObject = isObject;
+    if (skip) {
+        return true;
+    }
+    enterContext(slot, frame.previousRecord, frame.previousMember);
+    if (!slot.functions->start(frame, isObject, m_errors)) {
+        frame.isCaptured = true;
+        m_captureDepth = 1;
+    }
+    return true;
+}
+
+inline bool JsonReaderHandler::StartObject()
+{
+    return start(true);
+}
+
+/*!
+ * \brief Determines the slot for the member with the specified name.
+ */
+inline bool JsonReaderHandler::Key(const char *str, RAPIDJSON_NAMESPACE::SizeType length, bool)
+{
+    if (m_captureDepth) {
+        m_captured.emplace_back(str, length, m_captureAllocator);
+        return true;
+    }
+    m_pendingMember = JsonReaderSlot();
+    if (JsonReaderFrame &frame = m_frames.back(); frame.slot.functions && !frame.slot.functions->member(frame, str, length, m_pendingMember)) {
+        m_pendingMember = JsonReaderSlot(); // ignore unknown members
+    }
+    return true;
+}
+
+/*!
+ * \brief Leaves the current object/array.
+ */
+inline bool JsonReaderHandler::end()
+{
+    JsonReaderFrame &frame = m_frames.back();
+    if (frame.slot.functions) {
+        frame.slot.functions->end(frame, m_errors);
+        leaveContext(frame.previousRecord, frame.previousMember);
+    }
+    m_frames.pop_back();
+    return true;
+}
+
+/*!
+ * \brief Pulls the value of the current frame from the captured object/array.
+ */
+inline void JsonReaderHandler::finishCapture()
+{
+    JsonReaderFrame &frame = m_frames.back();
+    frame.slot.functions->pullValue(frame.slot.target, m_captured.back(), m_errors);
+    leaveContext(frame.previousRecord, frame.previousMember);
+    m_frames.pop_back();
+    m_captured.clear();
+    m_captureAllocator.Clear();
+}
+
+inline bool JsonReaderHandler::EndObject(RAPIDJSON_NAMESPACE::SizeType memberCount)
+{
+    if (!m_captureDepth) {
+        return end();
+    }
+    RAPIDJSON_NAMESPACE::Value object(RAPIDJSON_NAMESPACE::kObjectType);
+    Detail::reserveMembers(object, memberCount, m_captureAllocator);
+    const auto members = m_captured.end() - static_cast<std::ptrdiff_t>(memberCount) * 2;
+    for (auto i = members; i != m_captured.end(); i += 2) {
+        object.AddMember(*i, *(i + 1), m_captureAllocator);
+    }
+    m_captured.erase(members, m_captured.end());
+    m_captured.emplace_back(std::move(object));
+    if (!--m_captureDepth) {
+        finishCapture();
+    }
+    return true;
+}
+
+inline bool JsonReaderHandler::StartArray()
+{
+    return start(false);
+}
+
+inline bool JsonReaderHandler::EndArray(RAPIDJSON_NAMESPACE::SizeType elementCount)
+{
+    if (!m_captureDepth) {
+        return end();
+    }
+    RAPIDJSON_NAMESPACE::Value array(RAPIDJSON_NAMESPACE::kArrayType);
+    array.Reserve(elementCount, m_captureAllocator);
+    const auto elements = m_captured.end() - static_cast<std::ptrdiff_t>(elementCount);
+    for (auto i = elements; i != m_captured.end(); ++i) {
+        array.PushBack(*i, m_captureAllocator);
+    }
+    m_captured.erase(elements, m_captured.end());
+    m_captured.emplace_back(std::move(array));
+    if (!--m_captureDepth) {
+        finishCapture();
+    }
+    return true;
+}
+
+// define functions providing high-level JSON deserialization via RapidJSON's SAX API
+
+/*!
+ * \brief Populates the specified \a reflectable from the JSON read from the specified \a stream without building a
+ *        RAPIDJSON_NAMESPACE::Document.
+ * \throws Throws RAPIDJSON_NAMESPACE::ParseResult if the JSON is invalid (like parseJsonDocFromString()).
+ */
+template <typename Type, unsigned int parseFlags = RAPIDJSON_NAMESPACE::kParseDefaultFlags, typename InputStream>
+void readJson(Type &reflectable, InputStream &stream, JsonDeserializationErrors *errors = nullptr)
+{
+    JsonReaderHandler handler(JsonReaderSlot::of(reflectable), errors);
+    RAPIDJSON_NAMESPACE::Reader reader;
+    const RAPIDJSON_NAMESPACE::ParseResult parseRes = reader.Parse<parseFlags>(stream, handler);
+    if (parseRes.IsError()) {
+        throw parseRes;
+    }
+}
+
+/*!
+ * \brief Deserializes the specified JSON to \tparam Type without building a RAPIDJSON_NAMESPACE::Document.
+ * \remarks Behaves like fromJson() but populates the returned object incrementally while parsing.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy>
+Type fromJsonSax(const char *json, std::size_t jsonSize, JsonDeserializationErrors *errors = nullptr)
+{
+    RAPIDJSON_NAMESPACE::MemoryStream stream(json, jsonSize);
+    Type res;
+    readJson<Type, Policy::parseFlags>(res, stream, errors);
+    return res;
+}
+
+/*!
+ * \brief Deserializes the specified JSON to \tparam Type without building a RAPIDJSON_NAMESPACE::Document.
+ */
+template <typename Type, typename Policy = DefaultJsonPolicy> Type fromJsonSax(const std::string &json, JsonDeserializationErrors *errors = nullptr)
+{
+    return fromJsonSax<Type, Policy>(json.data(), json.size(), errors);
+}
+
+} // namespace JsonReflector
+} // namespace ReflectiveRapidJSON
+
+#endif // REFLECTIVE_RAPIDJSON_JSON_SAX_READER_H
@@ -8,6 +8,7 @@
  */
 
 #include "./reflector.h"
+#include "./saxreader.h"
 
 #include <rapidjson/document.h>
 
@@ -23,12 +24,24 @@ template <typename Type> struct JsonSerializable {
     void push(RAPIDJSON_NAMESPACE::Value &container);
     void push(RAPIDJSON_NAMESPACE::Value &container, const char *name);
 
-    // high-level API
-    RAPIDJSON_NAMESPACE::StringBuffer toJson() const;
+    // high-level API (the optional template argument specifies the JsonPolicy)
+    template <typename Policy = DefaultJsonPolicy> RAPIDJSON_NAMESPACE::StringBuffer toJson() const;
+    template <typename Policy = DefaultJsonPolicy> const RAPIDJSON_NAMESPACE::StringBuffer &toJson(JsonSerializationContext &context) const;
+    template <typename Policy = DefaultJsonPolicy> void toJson(std::string &output) const;
+    template <typename Policy = DefaultJsonPolicy> void toJson(JsonSink &sink) const;
+    template <typename Policy = DefaultJsonPolicy> void toJson(std::ostream &stream) const;
     RAPIDJSON_NAMESPACE::Document toJsonDocument() const;
+    template <typename Policy = DefaultJsonPolicy>
     static Type fromJson(const char *json, std::size_t jsonSize, JsonDeserializationErrors *errors = nullptr);
-    static Type fromJson(const char *json, JsonDeserializationErrors *errors = nullptr);
-    static Type fromJson(const std::string &json, JsonDeserializationErrors *errors = nullptr);
+    template <typename Policy = DefaultJsonPolicy> static Type fromJson(const char *json, JsonDeserializationErrors *errors = nullptr);
+    template <typename Policy = DefaultJsonPolicy> static Type fromJson(const std::string &json, JsonDeserializationErrors *errors = nullptr);
+    template <typename Policy = DefaultJsonPolicy>
+    static Type fromJson(const char *json, std::size_t jsonSize, JsonSerializationContext &context, JsonDeserializationErrors *errors = nullptr);
+    template <typename Policy = DefaultJsonPolicy>
+    static Type fromJson(const std::string &json, JsonSerializationContext &context, JsonDeserializationErrors *errors = nullptr);
+    template <typename Policy = DefaultJsonPolicy>
+    static Type fromJsonInsitu(char *json, std::size_t jsonSize, JsonDeserializationErrors *errors = nullptr);
+    template <typename Policy = DefaultJsonPolicy> static Type fromJsonInsitu(std::string &json, JsonDeserializationErrors *errors = nullptr);
 
     static constexpr const char *qualifiedName = "ReflectiveRapidJSON::JsonSerializable";
 
@@ -57,9 +70,44 @@ template <typename Type> void JsonSerializable<Type>::push(RAPIDJSON_NAMESPACE::
  * \brief Converts the object to its JSON representation (rapidjson::StringBuffer).
  * \remarks To obtain a string from the returned buffer, just use its GetString() method.
  */
-template <typename Type> RAPIDJSON_NAMESPACE::StringBuffer JsonSerializable<Type>::toJson() const
+template <typename Type> template <typename Policy> RAPIDJSON_NAMESPACE::StringBuffer JsonSerializable<Type>::toJson() const
 {
-    return JsonReflector::toJson<Type>(static_cast<const Type &>(*this));
+    return JsonReflector::toJson<Type, Policy>(static_cast<const Type &>(*this));
+}
+
+/*!
+ * \brief Converts the object to its JSON representation using the output buffer of the specified \a context.
+ * \remarks The returned buffer is only valid until \a context is used again.
+ */
+template <typename Type>
+template <typename Policy>
+const RAPIDJSON_NAMESPACE::StringBuffer &JsonSerializable<Type>::toJson(JsonSerializationContext &context) const
+{
+    return JsonReflector::toJson<Type, Policy>(static_cast<const Type &>(*this), context);
+}
+
+/*!
+ * \brief Converts the object to its JSON representation storing it directly in the specified \a output string.
+ */
+template <typename Type> template <typename Policy> void JsonSerializable<Type>::toJson(std::string &output) const
+{
+    JsonReflector::toJson<Type, Policy>(static_cast<const Type &>(*this), output);
+}
+
+/*!
+ * \brief Converts the object to its JSON representation writing it to the specified \a sink.
+ */
+template <typename Type> template <typename Policy> void JsonSerializable<Type>::toJson(JsonSink &sink) const
+{
+    JsonReflector::toJson<Type, Policy>(static_cast<const Type &>(*this), sink);
+}
+
+/*!
+ * \brief Converts the object to its JSON representation writing it to the specified \a stream.
+ */
+template <typename Type> template <typename Policy> void JsonSerializable<Type>::toJson(std::ostream &stream) const
+{
+    JsonReflector::toJson<Type, Policy>(static_cast<const Type &>(*this), stream);
 }
 
 /*!
@@ -74,25 +122,69 @@ template <typename Type> RAPIDJSON_NAMESPACE::Document JsonSerializable<Type>::t
 /*!
  * \brief Constructs a new object from the specified JSON.
  */
-template <typename Type> Type JsonSerializable<Type>::fromJson(const char *json, std::size_t jsonSize, JsonDeserializationErrors *errors)
+template <typename Type>
+template <typename Policy>
+Type JsonSerializable<Type>::fromJson(const char *json, std::size_t jsonSize, JsonDeserializationErrors *errors)
 {
-    return JsonReflector::fromJson<Type>(json, jsonSize, errors);
+    return JsonReflector::fromJson<Type, Policy>(json, jsonSize, errors);
 }
 
 /*!
  * \brief Constructs a new object from the specified JSON.
  */
-template <typename Type> Type JsonSerializable<Type>::fromJson(const char *json, JsonDeserializationErrors *errors)
+template <typename Type> template <typename Policy> Type JsonSerializable<Type>::fromJson(const char *json, JsonDeserializationErrors *errors)
 {
-    return JsonReflector::fromJson<Type>(json, std::strlen(json), errors);
+    return JsonReflector::fromJson<Type, Policy>(json, std::strlen(json), errors);
 }
 
 /*!
  * \brief Constructs a new object from the specified JSON.
  */
-template <typename Type> Type JsonSerializable<Type>::fromJson(const std::string &json, JsonDeserializationErrors *errors)
+template <typename Type>
+template <typename Policy>
+Type JsonSerializable<Type>::fromJson(const std::string &json, JsonDeserializationErrors *errors)
+{
+    return JsonReflector::fromJson<Type, Policy>(json.data(), json.size(), errors);
+}
+
+/*!
+ * \brief Constructs a new object from the specified JSON reusing the resources of the specified \a context.
+ */
+template <typename Type>
+template <typename Policy>
+Type JsonSerializable<Type>::fromJson(const char *json, std::size_t jsonSize, JsonSerializationContext &context, JsonDeserializationErrors *errors)
+{
+    return JsonReflector::fromJson<Type, Policy>(json, jsonSize, context, errors);
+}
+
+/*!
+ * \brief Constructs a new object from the specified JSON reusing the resources of the specified \a context.
+ */
+template <typename Type>
+template <typename Policy>
+Type JsonSerializable<Type>::fromJson(const std::string &json, JsonSerializationContext &context, JsonDeserializationErrors *errors)
+{
+    return JsonReflector::fromJson<Type, Policy>(json.data(), json.size(), context, errors);
+}
+
+/*!
+ * \brief Constructs a new object from the specified JSON parsing the mutable \a json buffer in-situ.
+ * \remarks The contents of \a json are modified.
+ */
+template <typename Type>
+template <typename Policy>
+Type JsonSerializable<Type>::fromJsonInsitu(char *json, std::size_t jsonSize, JsonDeserializationErrors *errors)
+{
+    return JsonReflector::fromJsonInsitu<Type, Policy>(json, jsonSize, errors);
+}
+
+/*!
+ * \brief Constructs a new object from the specified JSON parsing the mutable \a json string in-situ.
+ * \remarks The contents of \a json are modified.
+ */
+template <typename Type> template <typename Policy> Type JsonSerializable<Type>::fromJsonInsitu(std::string &json, JsonDeserializationErrors *errors)
 {
-    return JsonReflector::fromJson<Type>(json.data(), json.size(), errors);
+    return JsonReflector::fromJsonInsitu<Type, Policy>(json.data(), json.size(), errors);
 }
 
 /*!
@@ -128,7 +220,8 @@ const JsonSerializable<Type> &as(const Type &serializable)
  */
 #define REFLECTIVE_RAPIDJSON_PUSH_PRIVATE_MEMBERS(T)                                                                                                 \
     friend void ::ReflectiveRapidJSON::JsonReflector::push<T>(                                                                                       \
-        const T &reflectable, ::RAPIDJSON_NAMESPACE::Value::Object &value, ::RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator)
+        const T &reflectable, ::RAPIDJSON_NAMESPACE::Value::Object &value, ::RAPIDJSON_NAMESPACE::Document::AllocatorType &allocator);               \
+    friend struct ::ReflectiveRapidJSON::JsonReflector::CustomTypeWriter<T>
 
 /*!
  * \def The REFLECTIVE_RAPIDJSON_PULL_PRIVATE_MEMBERS macro enables deserialization of private members.
@@ -137,7 +230,8 @@ const JsonSerializable<Type> &as(const Type &serializable)
 #define REFLECTIVE_RAPIDJSON_PULL_PRIVATE_MEMBERS(T)                                                                                                 \
     friend void ::ReflectiveRapidJSON::JsonReflector::pull<T>(T & reflectable,                                                                       \
         const ::RAPIDJSON_NAMESPACE::GenericValue<::RAPIDJSON_NAMESPACE::UTF8<char>>::ConstObject &value,                                            \
-        ::ReflectiveRapidJSON::JsonDeserializationErrors *errors)
+        ::ReflectiveRapidJSON::JsonDeserializationErrors *errors);                                                                                   \
+    friend struct ::ReflectiveRapidJSON::JsonReflector::CustomTypeReader<T>
 
 /*!
  * \def The REFLECTIVE_RAPIDJSON_ENABLE_PRIVATE_MEMBERS macro enables serialization and deserialization of private members.
@@ -0,0 +1,246 @@
+#ifndef REFLECTIVE_RAPIDJSON_JSON_SINK_H
+#define REFLECTIVE_RAPIDJSON_JSON_SINK_H
+
+/*!
+ * \file sink.h
+ * \brief Contains output streams for RapidJSON's writer which write JSON through a fixed-size buffer.
+ */
+
+#include <c++utilities/application/global.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <system_error>
+#include <utility>
+
+#ifdef PLATFORM_UNIX
+#include <unistd.h>
+#endif
+
+namespace ReflectiveRapidJSON {
+
+/*!
+ * \brief The JsonSink class is the base for RapidJSON output streams which pass the output to a destination chunk-wise.
+ *
+ * The output is collected in a buffer of fixed size which is handed to writeChunk() whenever it is full and when
+ * flush() is called. So the memory required for serializing is bounded by the buffer size regardless of the size of
+ * the produced JSON.
+ */
+class JsonSink {
+public:
+    using Ch = char;
+
+    static constexpr std::size_t defaultBufferSize = 64 * 1024;
+
+    explicit JsonSink(std::size_t bufferSize = defaultBufferSize);
+    JsonSink(const JsonSink &) = delete;
+    JsonSink &operator=(const JsonSink &) = delete;
+    virtual ~JsonSink() = default;
+
+    void Put(char c);
+    void put(const char *chars, std::size_t size);
+    void Flush();
+    void flush();
+    std::size_t bufferSize() const;
+    std::size_t bytesWritten() const;
+
+protected:
+    /// \brief Writes the specified \a chunk to the actual destination.
+    virtual void writeChunk(const char *chunk, std::size_t size) = 0;
+
+private:
+    std::unique_ptr<char[]> m_buffer;
+    char *m_current;
+    char *m_end;
+    std::size_t m_bytesWritten;
+};
+
+/*!
+ * \brief Constructs a new sink using a buffer of the specified \a bufferSize.
+ */
+inline JsonSink::JsonSink(std::size_t bufferSize)
+    : m_buffer(std::make_unique<char[]>(bufferSize ? bufferSize : 1))
+    , m_current(m_buffer.get())
+    , m_end(m_buffer.get() + (bufferSize ? bufferSize : 1))
+    , m_bytesWritten(0)
+{
+}
+
+/*!
+ * \brief Appends the specified character to the buffer passing the buffer to writeChunk() if it is full.
+ */
+inline void JsonSink::Put(char c)
+{
+    if (m_current == m_end) {
+        flush();
+    }
+    *m_current++ = c;
+}
+
+/*!
+ * \brief Appends the specified \a chars to the buffer passing the buffer to writeChunk() whenever it is full.
+ */
+inline void JsonSink::put(const char *chars, std::size_t size)
+{
+    while (size) {
+        if (m_current == m_end) {
+            flush();
+        }
+        const auto chunkSize = std::min(size, static_cast<std::size_t>(m_end - m_current));
+        std::memcpy(m_current, chars, chunkSize);
+        m_current += chunkSize;
+        chars += chunkSize;
+        size -= chunkSize;
+    }
+}
+
+/*!
+ * \brief Does nothing; only present to satisfy RapidJSON's stream concept.
+ * \remarks RapidJSON's writer calls this function after each complete value. Passing the buffer on at this point would
+ *          render the buffer useless when writing many small values (e.g. JSON Lines). Hence only flush() passes the
+ *          buffer on.
+ */
+inline void JsonSink::Flush()
+{
+}
+
+/*!
+ * \brief Passes the buffered output to writeChunk().
+ */
+inline void JsonSink::flush()
+{
+    const auto size = static_cast<std::size_t>(m_current - m_buffer.get());
+    if (!size) {
+        return;
+    }
+    m_current = m_buffer.get();
+    m_bytesWritten += size;
+    writeChunk(m_buffer.get(), size);
+}
+
+/*!
+ * \brief Returns the size of the buffer.
+ */
+inline std::size_t JsonSink::bufferSize() const
+{
+    return static_cast<std::size_t>(m_end - m_buffer.get());
+}
+
+/*!
+ * \brief Returns the number of bytes passed to writeChunk() so far.
+ */
+inline std::size_t JsonSink::bytesWritten() const
+{
+    return m_bytesWritten;
+}
+
+/*!
+ * \brief The JsonOStreamSink class writes JSON to an std::ostream.
+ * \remarks Errors are reported via the stream's state (and its exception mask).
+ */
+class JsonOStreamSink : public JsonSink {
+public:
+    explicit JsonOStreamSink(std::ostream &stream, std::size_t bufferSize = defaultBufferSize);
+
+protected:
+    void writeChunk(const char *chunk, std::size_t size) override;
+
+private:
+    std::ostream &m_stream;
+};
+
+/*!
+ * \brief Constructs a new sink writing to the specified \a stream.
+ */
+inline JsonOStreamSink::JsonOStreamSink(std::ostream &stream, std::size_t bufferSize)
+    : JsonSink(bufferSize)
+    , m_stream(stream)
+{
+}
+
+inline void JsonOStreamSink::writeChunk(const char *chunk, std::size_t size)
+{
+    m_stream.write(chunk, static_cast<std::streamsize>(size));
+}
+
+#ifdef PLATFORM_UNIX
+/*!
+ * \brief The JsonFileDescriptorSink class writes JSON to a POSIX file descriptor (e.g. a file, pipe or socket).
+ * \remarks The file descriptor is not closed by the sink.
+ * \throws Throws std::system_error if writing fails.
+ */
+class JsonFileDescriptorSink : public JsonSink {
+public:
+    explicit JsonFileDescriptorSink(int fileDescriptor, std::size_t bufferSize = defaultBufferSize);
+
+protected:
+    void writeChunk(const char *chunk, std::size_t size) override;
+
+private:
+    int m_fileDescriptor;
+};
+
+/*!
+ * \brief Constructs a new sink writing to the specified \a fileDescriptor.
+ */
+inline JsonFileDescriptorSink::JsonFileDescriptorSink(int fileDescriptor, std::size_t bufferSize)
+    : JsonSink(bufferSize)
+    , m_fileDescriptor(fileDescriptor)
+{
+}
+
+inline void JsonFileDescriptorSink::writeChunk(const char *chunk, std::size_t size)
+{
+    while (size) {
+        const auto written = ::write(m_fileDescriptor, chunk, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "unable to write JSON to file descriptor");
+        }
+        chunk += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+#endif
+
+/*!
+ * \brief The JsonCallbackSink class passes JSON chunk-wise to a callback.
+ * \remarks The chunk passed to the callback is only valid during the call.
+ */
+class JsonCallbackSink : public JsonSink {
+public:
+    using Callback = std::function<void(const char *chunk, std::size_t size)>;
+
+    explicit JsonCallbackSink(Callback &&callback, std::size_t bufferSize = defaultBufferSize);
+
+protected:
+    void writeChunk(const char *chunk, std::size_t size) override;
+
+private:
+    Callback m_callback;
+};
+
+/*!
+ * \brief Constructs a new sink passing chunks to the specified \a callback.
+ */
+inline JsonCallbackSink::JsonCallbackSink(Callback &&callback, std::size_t bufferSize)
+    : JsonSink(bufferSize)
+    , m_callback(std::move(callback))
+{
+}
+
+inline void JsonCallbackSink::writeChunk(const char *chunk, std::size_t size)
+{
+    m_callback(chunk, size);
+}
+
+} // namespace ReflectiveRapidJSON
+
+#endif // REFLECTIVE_RAPIDJSON_JSON_SINK_H
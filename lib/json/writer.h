@@ -0,0 +1,267 @@
+#ifndef REFLECTIVE_RAPIDJSON_JSON_WRITER_H
+#define REFLECTIVE_RAPIDJSON_JSON_WRITER_H
+
+/*!
+ * \file writer.h
+ * \brief Contains a RapidJSON writer which escapes strings chunk-wise using vectorized code if enabled.
+ */
+
+#include <c++utilities/application/global.h>
+#include <c++utilities/misc/traits.h>
+
+#include <rapidjson/rapidjson.h>
+#include <rapidjson/writer.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(RAPIDJSON_SSE2) || defined(RAPIDJSON_SSE42)
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(RAPIDJSON_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace ReflectiveRapidJSON {
+
+/*!
+ * \brief The JsonMemberKey struct holds the name of a member along with its quoted and escaped JSON representation.
+ * \remarks Instances are usually emitted as constexpr tables by the code generator (see JsonReflector::JsonMemberKeys) so
+ *          neither the length nor the escaping of keys needs to be determined when serializing.
+ */
+struct JsonMemberKey {
+    template <std::size_t nameSize, std::size_t quotedNameSize>
+    constexpr JsonMemberKey(const char (&name)[nameSize], const char (&quotedName)[quotedNameSize])
+        : name(name)
+        , length(static_cast<RAPIDJSON_NAMESPACE::SizeType>(nameSize - 1))
+        , quotedName(quotedName)
+        , quotedLength(static_cast<RAPIDJSON_NAMESPACE::SizeType>(quotedNameSize - 1))
+    {
+    }
+
+    /// \brief The name of the member (not escaped).
+    const char *name;
+    /// \brief The length of name.
+    RAPIDJSON_NAMESPACE::SizeType length;
+    /// \brief The escaped name of the member including the enclosing quotation marks.
+    const char *quotedName;
+    /// \brief The length of quotedName.
+    RAPIDJSON_NAMESPACE::SizeType quotedLength;
+};
+
+namespace Detail {
+
+/*!
+ * \brief Returns whether the specified character needs to be escaped within a JSON string.
+ * \remarks Like RapidJSON's writer, only control characters, the quotation mark and the backslash are escaped. All other
+ *          characters (including non-ASCII bytes of UTF-8 sequences) are copied as-is.
+ */
+constexpr bool isJsonCharToEscape(char c)
+{
+    return static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\';
+}
+
+/*!
+ * \brief Returns the first character within [\a begin, \a end) which needs to be escaped or \a end if there is none.
+ * \remarks Processes 16 bytes at a time if SSE2 or NEON is enabled (see CMake option JSON_SIMD) and 8 bytes at a time
+ *          otherwise.
+ */
+inline const char *findJsonCharToEscape(const char *begin, const char *end)
+{
+#if defined(RAPIDJSON_SSE2) || defined(RAPIDJSON_SSE42)
+    const auto quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\'), maxControlChar = _mm_set1_epi8(0x1F);
+    for (; end - begin >= 16; begin += 16) {
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        const auto controlChars = _mm_cmpeq_epi8(_mm_max_epu8(chars, maxControlChar), maxControlChar);
+        const auto charsToEscape = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, backslash)), controlChars);
+        if (const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(charsToEscape))) {
+#ifdef _MSC_VER
+            unsigned long offset;
+            _BitScanForward(&offset, mask);
+            return begin + offset;
+#else
+            return begin + __builtin_ctz(mask);
+#endif
+        }
+    }
+#elif defined(RAPIDJSON_NEON)
+    const auto quote = vdupq_n_u8('"'), backslash = vdupq_n_u8('\\'), maxControlChar = vdupq_n_u8(0x1F);
+    for (; end - begin >= 16; begin += 16) {
+        const auto chars = vld1q_u8(reinterpret_cast<const std::uint8_t *>(begin));
+        const auto charsToEscape = vorrq_u8(vorrq_u8(vceqq_u8(chars, quote), vceqq_u8(chars, backslash)), vcleq_u8(chars, maxControlChar));
+        // note: vmaxvq_u8() would only be available on AArch64 so combine the two halves instead (also works on ARMv7)
+        const auto lanes = vreinterpretq_u64_u8(charsToEscape);
+        if (vgetq_lane_u64(lanes, 0) | vgetq_lane_u64(lanes, 1)) {
+            break;
+        }
+    }
+#else
+    // check 8 bytes at a time for a byte less than 0x20, a quotation mark or a backslash (only the presence is exact)
+    constexpr auto ones = std::uint64_t(0x0101010101010101u), highBits = std::uint64_t(0x8080808080808080u);
+    for (; end - begin >= 8; begin += 8) {
+        auto chars = std::uint64_t();
+        std::memcpy(&chars, begin, sizeof(chars));
+        const auto quotes = chars ^ (ones * '"'), backslashes = chars ^ (ones * '\\');
+        const auto candidates = ((chars - ones * 0x20) & ~chars) | ((quotes - ones) & ~quotes) | ((backslashes - ones) & ~backslashes);
+        if (candidates & highBits) {
+            break;
+        }
+    }
+#endif
+    for (; begin != end && !isJsonCharToEscape(*begin); ++begin)
+        ;
+    return begin;
+}
+
+/*!
+ * \brief The HasBulkPut class checks whether \tparam OutputStream provides put() to append multiple characters at once.
+ */
+template <typename OutputStream, typename = void> struct HasBulkPut : public Traits::Bool<false> {};
+template <typename OutputStream>
+struct HasBulkPut<OutputStream, std::void_t<decltype(std::declval<OutputStream &>().put(static_cast<const char *>(nullptr), std::size_t()))>>
+    : public Traits::Bool<true> {};
+
+/*!
+ * \brief The HasPush class checks whether \tparam OutputStream provides Push() to allocate space for multiple characters
+ *        (like RAPIDJSON_NAMESPACE::StringBuffer).
+ */
+template <typename OutputStream, typename = void> struct HasPush : public Traits::Bool<false> {};
+template <typename OutputStream>
+struct HasPush<OutputStream, std::void_t<decltype(std::declval<OutputStream &>().Push(std::size_t()))>> : public Traits::Bool<true> {};
+
+/*!
+ * \brief Appends the specified \a chars to the specified \a stream as efficiently as supported by the stream.
+ */
+template <typename OutputStream> inline void putChars(OutputStream &stream, const char *chars, std::size_t size)
+{
+    if constexpr (HasBulkPut<OutputStream>::value) {
+        stream.put(chars, size);
+    } else if constexpr (HasPush<OutputStream>::value) {
+        if (size) {
+            std::memcpy(stream.Push(size), chars, size);
+        }
+    } else {
+        for (const auto *const end = chars + size; chars != end; ++chars) {
+            stream.Put(*chars);
+        }
+    }
+}
+
+/*!
+ * \brief The SupportsMemberKey class checks whether \tparam Handler can write a JsonMemberKey verbatim.
+ */
+template <typename Handler, typename = void> struct SupportsMemberKey : public Traits::Bool<false> {};
+template <typename Handler>
+struct SupportsMemberKey<Handler, std::void_t<decltype(std::declval<Handler &>().Key(std::declval<const JsonMemberKey &>()))>>
+    : public Traits::Bool<true> {};
+
+} // namespace Detail
+
+/*!
+ * \brief The FastStringWriter class is a RapidJSON writer which writes strings and keys chunk-wise.
+ *
+ * RapidJSON's writer checks and copies strings character by character. This writer determines the next character which
+ * needs to be escaped via Detail::findJsonCharToEscape() and copies everything before it at once. So strings which need
+ * no escaping (e.g. log lines consisting of ASCII characters) are merely scanned and copied.
+ *
+ * Keys given as JsonMemberKey are copied verbatim as they are already quoted and escaped.
+ *
+ * \tparam BaseWriter Specifies the writer to derive from, e.g. RAPIDJSON_NAMESPACE::Writer or CharConvWriter.
+ * \tparam writeFlags Specifies the write flags the \tparam BaseWriter has been instantiated with.
+ * \remarks The output is exactly the same as the output of \tparam BaseWriter. If kWriteValidateEncodingFlag is set, the
+ *          strings are written by \tparam BaseWriter as the encoding needs to be validated character by character anyway.
+ */
+template <typename BaseWriter, unsigned int writeFlags = RAPIDJSON_NAMESPACE::kWriteDefaultFlags> class FastStringWriter : public BaseWriter {
+public:
+    using Base = BaseWriter;
+    using Ch = typename Base::Ch;
+    using Base::Base;
+    using Base::Key;
+    using Base::String;
+
+    bool String(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy = false)
+    {
+        if constexpr (writeFlags & RAPIDJSON_NAMESPACE::kWriteValidateEncodingFlag) {
+            return Base::String(str, length, copy);
+        } else {
+            CPP_UTILITIES_UNUSED(copy)
+            this->Prefix(RAPIDJSON_NAMESPACE::kStringType);
+            return this->EndValue(writeString(str, length));
+        }
+    }
+    bool Key(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length, bool copy = false)
+    {
+        return String(str, length, copy);
+    }
+    bool Key(const JsonMemberKey &key)
+    {
+        if constexpr (writeFlags & RAPIDJSON_NAMESPACE::kWriteValidateEncodingFlag) {
+            return Base::Key(key.name, key.length);
+        } else {
+            this->Prefix(RAPIDJSON_NAMESPACE::kStringType);
+            Detail::putChars(*this->os_, key.quotedName, key.quotedLength);
+            return this->EndValue(true);
+        }
+    }
+
+private:
+    bool writeString(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length);
+};
+
+/*!
+ * \brief Writes the specified string escaping it like RapidJSON's writer would do.
+ */
+template <typename BaseWriter, unsigned int writeFlags>
+bool FastStringWriter<BaseWriter, writeFlags>::writeString(const Ch *str, RAPIDJSON_NAMESPACE::SizeType length)
+{
+    static constexpr char hexDigits[] = "0123456789ABCDEF";
+    auto &stream = *this->os_;
+    stream.Put('\"');
+    for (const Ch *begin = str, *const end = str + length; begin != end;) {
+        const auto *const charToEscape = Detail::findJsonCharToEscape(begin, end);
+        Detail::putChars(stream, begin, static_cast<std::size_t>(charToEscape - begin));
+        if (charToEscape == end) {
+            break;
+        }
+        const auto c = static_cast<unsigned char>(*charToEscape);
+        stream.Put('\\');
+        switch (c) {
+        case '"':
+        case '\\':
+            stream.Put(static_cast<Ch>(c));
+            break;
+        case '\b':
+            stream.Put('b');
+            break;
+        case '\f':
+            stream.Put('f');
+            break;
+        case '\n':
+            stream.Put('n');
+            break;
+        case '\r':
+            stream.Put('r');
+            break;
+        case '\t':
+            stream.Put('t');
+            break;
+        default:
+            stream.Put('u');
+            stream.Put('0');
+            stream.Put('0');
+            stream.Put(hexDigits[c >> 4]);
+            stream.Put(hexDigits[c & 0xF]);
+        }
+        begin = charToEscape + 1;
+    }
+    stream.Put('\"');
+    return true;
+}
+
+} // namespace ReflectiveRapidJSON
+
+#endif // REFLECTIVE_RAPIDJSON_JSON_WRITER_H
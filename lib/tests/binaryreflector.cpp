@@ -1,3 +1,4 @@
+#include "../binary/mapping.h"
 #include "../binary/reflector-chronoutilities.h"
 #include "../binary/reflector.h"
 #include "../binary/serializable.h"
@@ -11,16 +12,27 @@ using CppUtilities::operator<<; // must be visible prior to the call site
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
+#include <array>
 #include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
+#ifdef PLATFORM_UNIX
+#include <unistd.h>
+#endif
+
 using namespace std;
 using namespace CPPUNIT_NS;
 using namespace CppUtilities;
@@ -71,6 +83,65 @@ struct ObjectWithVariantsBinary : public BinarySerializable<ObjectWithVariantsBi
     variant<string, int> yetAnotherVariant;
 };
 
+// define a trait to check whether a deserializer can read borrowed strings
+template <typename Deserializer, typename = void> struct CanBorrowStrings : public std::false_type {};
+template <typename Deserializer>
+struct CanBorrowStrings<Deserializer, std::void_t<decltype(std::declval<Deserializer &>().read(std::declval<std::string_view &>()))>>
+    : public std::true_type {};
+
+// define a struct only (de)serializable via streams to test shared pointers within the fallbacks for buffers
+struct SharedPointerHolderBinary : public BinarySerializable<SharedPointerHolderBinary> {
+    shared_ptr<std::int32_t> pointer;
+};
+
+// define two versions of a skippable record to test reading records written by a newer version
+struct SkippableRecordV1Binary : public BinarySerializable<SkippableRecordV1Binary, 1> {
+    std::uint32_t number = 0;
+    string text;
+};
+
+struct SkippableRecordV2Binary : public BinarySerializable<SkippableRecordV2Binary, 2> {
+    std::uint32_t number = 0;
+    string text;
+    // as of version 2
+    vector<string> tags;
+};
+
+namespace ReflectiveRapidJSON {
+REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD(SkippableRecordV1Binary);
+REFLECTIVE_RAPIDJSON_SKIPPABLE_BINARY_RECORD(SkippableRecordV2Binary);
+} // namespace ReflectiveRapidJSON
+
+// define containers of integers to test packing them
+struct PackedCountersBinary : public vector<std::int32_t> {
+    using vector<std::int32_t>::vector;
+};
+
+struct PackedEventIdsBinary : public vector<std::uint64_t> {
+    using vector<std::uint64_t>::vector;
+};
+
+using PackedArrayBinary = std::array<std::int16_t, 3>;
+
+namespace ReflectiveRapidJSON {
+REFLECTIVE_RAPIDJSON_PACKED_BINARY_INTEGERS(PackedCountersBinary);
+REFLECTIVE_RAPIDJSON_PACKED_BINARY_INTEGERS(PackedEventIdsBinary);
+REFLECTIVE_RAPIDJSON_PACKED_BINARY_INTEGERS(PackedArrayBinary);
+} // namespace ReflectiveRapidJSON
+
+// define a struct with members of various types to test projected reading
+struct ProjectedObjectBinary : public BinarySerializable<ProjectedObjectBinary> {
+    std::uint32_t number = 0;
+    string text;
+    vector<std::uint16_t> numbers;
+    map<string, vector<string>> someMap;
+    optional<string> someOptional;
+    variant<int, string, monostate> someVariant;
+    shared_ptr<string> someSharedPointer;
+    SkippableRecordV2Binary record;
+    bool boolean = false;
+};
+
 // pretend serialization code for structs has been generated
 namespace ReflectiveRapidJSON {
 namespace BinaryReflector {
@@ -116,6 +187,48 @@ template <> void writeCustomType<TestObjectBinary>(BinarySerializer &serializer,
     serializer.write(customType.dateTime);
 }
 
+template <>
+BinaryVersion readCustomType<TestObjectBinary>(BinaryBufferDeserializer &deserializer, TestObjectBinary &customType, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    deserializer.read(customType.number);
+    deserializer.read(customType.number2);
+    deserializer.read(customType.numbers);
+    deserializer.read(customType.text);
+    deserializer.read(customType.boolean);
+    deserializer.read(customType.someMap);
+    deserializer.read(customType.someHash);
+    deserializer.read(customType.someSet);
+    deserializer.read(customType.someMultiset);
+    deserializer.read(customType.someUnorderedSet);
+    deserializer.read(customType.someUnorderedMultiset);
+    deserializer.read(customType.someEnum);
+    deserializer.read(customType.someEnumClass);
+    deserializer.read(customType.timeSpan);
+    deserializer.read(customType.dateTime);
+    return 0;
+}
+
+template <> void writeCustomType<TestObjectBinary>(BinaryBufferSerializer &serializer, const TestObjectBinary &customType, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    serializer.write(customType.number);
+    serializer.write(customType.number2);
+    serializer.write(customType.numbers);
+    serializer.write(customType.text);
+    serializer.write(customType.boolean);
+    serializer.write(customType.someMap);
+    serializer.write(customType.someHash);
+    serializer.write(customType.someSet);
+    serializer.write(customType.someMultiset);
+    serializer.write(customType.someUnorderedSet);
+    serializer.write(customType.someUnorderedMultiset);
+    serializer.write(customType.someEnum);
+    serializer.write(customType.someEnumClass);
+    serializer.write(customType.timeSpan);
+    serializer.write(customType.dateTime);
+}
+
 template <> BinaryVersion readCustomType<NestingArrayBinary>(BinaryDeserializer &deserializer, NestingArrayBinary &customType, BinaryVersion version)
 {
     CPP_UTILITIES_UNUSED(version)
@@ -150,6 +263,183 @@ void writeCustomType<ObjectWithVariantsBinary>(BinarySerializer &serializer, con
     serializer.write(customType.yetAnotherVariant);
 }
 
+template <>
+BinaryVersion readCustomType<SharedPointerHolderBinary>(
+    BinaryDeserializer &deserializer, SharedPointerHolderBinary &customType, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    deserializer.read(customType.pointer);
+    return 0;
+}
+
+template <>
+void writeCustomType<SharedPointerHolderBinary>(BinarySerializer &serializer, const SharedPointerHolderBinary &customType, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    serializer.write(customType.pointer);
+}
+
+template <> struct BinarySchemaFingerprint<SkippableRecordV2Binary> : public std::integral_constant<std::uint64_t, 0x0102030405060708> {};
+
+template <typename Serializer, typename Record> void writeSkippableRecord(Serializer &serializer, const Record &customObject, BinaryVersion version)
+{
+    using V = Versioning<BinarySerializable<Record, Record::version>>;
+    constexpr auto skippable = V::enabled && SkippableBinaryRecord<Record>::value;
+    if constexpr (V::enabled) {
+        serializer.template writeVersion<V>(version);
+    }
+    const auto record = serializer.beginRecord(skippable);
+    serializer.write(customObject.number, version);
+    serializer.write(customObject.text, version);
+    if constexpr (std::is_same_v<Record, SkippableRecordV2Binary>) {
+        if (version >= 2) {
+            serializer.write(customObject.tags, version);
+        }
+    }
+    serializer.endRecord(record);
+}
+
+template <typename Deserializer, typename Record>
+BinaryVersion readSkippableRecord(Deserializer &deserializer, Record &customObject, BinaryVersion version)
+{
+    using V = Versioning<BinarySerializable<Record, Record::version>>;
+    constexpr auto skippable = V::enabled && SkippableBinaryRecord<Record>::value;
+    if constexpr (V::enabled) {
+        if (deserializer.readVersion(version) && !skippable) {
+            V::assertVersion(version, "SkippableRecordBinary");
+        }
+    }
+    const auto record = deserializer.beginRecord(skippable);
+    deserializer.read(customObject.number, version);
+    deserializer.read(customObject.text, version);
+    if constexpr (std::is_same_v<Record, SkippableRecordV2Binary>) {
+        if (version >= 2) {
+            deserializer.read(customObject.tags, version);
+        }
+    }
+    deserializer.endRecord(record);
+    return version;
+}
+
+template <>
+void writeCustomType<SkippableRecordV1Binary>(BinarySerializer &serializer, const SkippableRecordV1Binary &customType, BinaryVersion version)
+{
+    writeSkippableRecord(serializer, customType, version);
+}
+
+template <>
+void writeCustomType<SkippableRecordV1Binary>(BinaryBufferSerializer &serializer, const SkippableRecordV1Binary &customType, BinaryVersion version)
+{
+    writeSkippableRecord(serializer, customType, version);
+}
+
+template <>
+void measureCustomType<SkippableRecordV1Binary>(BinarySizeCalculator &calculator, const SkippableRecordV1Binary &customType, BinaryVersion version)
+{
+    writeSkippableRecord(calculator, customType, version);
+}
+
+template <>
+BinaryVersion readCustomType<SkippableRecordV1Binary>(BinaryDeserializer &deserializer, SkippableRecordV1Binary &customType, BinaryVersion version)
+{
+    return readSkippableRecord(deserializer, customType, version);
+}
+
+template <>
+BinaryVersion readCustomType<SkippableRecordV1Binary>(
+    BinaryBufferDeserializer &deserializer, SkippableRecordV1Binary &customType, BinaryVersion version)
+{
+    return readSkippableRecord(deserializer, customType, version);
+}
+
+template <>
+void writeCustomType<SkippableRecordV2Binary>(BinarySerializer &serializer, const SkippableRecordV2Binary &customType, BinaryVersion version)
+{
+    writeSkippableRecord(serializer, customType, version);
+}
+
+template <>
+void writeCustomType<SkippableRecordV2Binary>(BinaryBufferSerializer &serializer, const SkippableRecordV2Binary &customType, BinaryVersion version)
+{
+    writeSkippableRecord(serializer, customType, version);
+}
+
+template <>
+void measureCustomType<SkippableRecordV2Binary>(BinarySizeCalculator &calculator, const SkippableRecordV2Binary &customType, BinaryVersion version)
+{
+    writeSkippableRecord(calculator, customType, version);
+}
+
+template <>
+BinaryVersion readCustomType<SkippableRecordV2Binary>(BinaryDeserializer &deserializer, SkippableRecordV2Binary &customType, BinaryVersion version)
+{
+    return readSkippableRecord(deserializer, customType, version);
+}
+
+template <>
+BinaryVersion readCustomType<SkippableRecordV2Binary>(
+    BinaryBufferDeserializer &deserializer, SkippableRecordV2Binary &customType, BinaryVersion version)
+{
+    return readSkippableRecord(deserializer, customType, version);
+}
+
+template <>
+BinaryVersion readCustomTypeProjected<SkippableRecordV2Binary>(
+    BinaryBufferDeserializer &deserializer, SkippableRecordV2Binary &customType, BinaryFieldMask fields, BinaryVersion version)
+{
+    if (fields) {
+        return readSkippableRecord(deserializer, customType, version);
+    }
+    // skip record as a whole via its length like generated code does
+    deserializer.readVersion(version);
+    deserializer.endRecord(deserializer.beginRecord(true));
+    return version;
+}
+
+template <>
+void writeCustomType<ProjectedObjectBinary>(BinaryBufferSerializer &serializer, const ProjectedObjectBinary &customType, BinaryVersion version)
+{
+    CPP_UTILITIES_UNUSED(version)
+    serializer.write(customType.number);
+    serializer.write(customType.text);
+    serializer.write(customType.numbers);
+    serializer.write(customType.someMap);
+    serializer.write(customType.someOptional);
+    serializer.write(customType.someVariant);
+    serializer.write(customType.someSharedPointer);
+    serializer.write(customType.record);
+    serializer.write(customType.boolean);
+}
+
+template <> struct BinaryFields<ProjectedObjectBinary> {
+    static constexpr BinaryFieldMask number = BinaryFieldMask(1) << 0;
+    static constexpr BinaryFieldMask text = BinaryFieldMask(1) << 1;
+    static constexpr BinaryFieldMask numbers = BinaryFieldMask(1) << 2;
+    static constexpr BinaryFieldMask someMap = BinaryFieldMask(1) << 3;
+    static constexpr BinaryFieldMask someOptional = BinaryFieldMask(1) << 4;
+    static constexpr BinaryFieldMask someVariant = BinaryFieldMask(1) << 5;
+    static constexpr BinaryFieldMask someSharedPointer = BinaryFieldMask(1) << 6;
+    static constexpr BinaryFieldMask record = BinaryFieldMask(1) << 7;
+    static constexpr BinaryFieldMask boolean = BinaryFieldMask(1) << 8;
+};
+
+template <>
+BinaryVersion readCustomTypeProjected<ProjectedObjectBinary>(
+    BinaryBufferDeserializer &deserializer, ProjectedObjectBinary &customType, BinaryFieldMask fields, BinaryVersion version)
+{
+    using Fields = BinaryFields<ProjectedObjectBinary>;
+    deserializer.readOrSkip(customType.number, fields & Fields::number, version);
+    deserializer.readOrSkip(customType.text, fields & Fields::text, version);
+    deserializer.readOrSkip(customType.numbers, fields & Fields::numbers, version);
+    deserializer.readOrSkip(customType.someMap, fields & Fields::someMap, version);
+    deserializer.readOrSkip(customType.someOptional, fields & Fields::someOptional, version);
+    deserializer.readOrSkip(customType.someVariant, fields & Fields::someVariant, version);
+    deserializer.readOrSkip(customType.someSharedPointer, fields & Fields::someSharedPointer, version);
+    deserializer.readOrSkip(customType.record, fields & Fields::record, version);
+    deserializer.readOrSkip(customType.boolean, fields & Fields::boolean, version);
+    return version;
+}
+
 } // namespace BinaryReflector
 
 // namespace BinaryReflector
@@ -169,8 +459,20 @@ class BinaryReflectorTests : public TestFixture {
     CPPUNIT_TEST(testDeserializeNestedStruct);
     CPPUNIT_TEST(testSmallSharedPointer);
     CPPUNIT_TEST(testBigSharedPointer);
+    CPPUNIT_TEST(testSequentialSharedPointerIds);
     CPPUNIT_TEST(testVariant);
     CPPUNIT_TEST(testOptional);
+    CPPUNIT_TEST(testBinarySize);
+    CPPUNIT_TEST(testBufferSerialization);
+    CPPUNIT_TEST(testBulkSerialization);
+    CPPUNIT_TEST(testByteOrder);
+    CPPUNIT_TEST(testSkippableRecords);
+    CPPUNIT_TEST(testProjection);
+    CPPUNIT_TEST(testSchemaHeader);
+    CPPUNIT_TEST(testPackedIntegers);
+#ifdef PLATFORM_UNIX
+    CPPUNIT_TEST(testMappedFile);
+#endif
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -187,8 +489,20 @@ public:
     void testSharedPointer(std::uintptr_t fakePointer);
     void testSmallSharedPointer();
     void testBigSharedPointer();
+    void testSequentialSharedPointerIds();
     void testVariant();
     void testOptional();
+    void testBinarySize();
+    void testBufferSerialization();
+    void testBulkSerialization();
+    void testByteOrder();
+    void testSkippableRecords();
+    void testProjection();
+    void testSchemaHeader();
+    void testPackedIntegers();
+#ifdef PLATFORM_UNIX
+    void testMappedFile();
+#endif
 
 private:
     vector<unsigned char> m_buffer;
@@ -366,31 +680,53 @@ void BinaryReflectorTests::assertTestObject(const TestObjectBinary &deserialized
 
 void BinaryReflectorTests::testSharedPointer(uintptr_t fakePointer)
 {
-    // create a shared pointer for the fake pointer ensuring that it is not actually deleted
-    shared_ptr<int> sharedPointer(reinterpret_cast<int *>(fakePointer), [](int *) {});
-
     // setup stream
     stringstream stream(ios_base::in | ios_base::out | ios_base::binary);
     stream.exceptions(ios_base::failbit | ios_base::badbit);
 
-    // serialize the shared pointer assuming its contents have been written before (to prevent actually dereferencing it)
+    // write a shared pointer like older versions did (using the address as ID) followed by further occurrences
     BinaryReflector::BinarySerializer serializer(&stream);
-    serializer.m_pointer[fakePointer] = true;
-    serializer.write(sharedPointer);
+    const auto bigId = fakePointer >= 0x80000000000000;
+    const auto writeId = [&] {
+        if (bigId) {
+            serializer.writeUInt64BE(fakePointer);
+        } else {
+            serializer.writeVariableLengthUIntBE(fakePointer);
+        }
+    };
+    serializer.writeByte(bigId ? 0x5 : 0x1);
+    writeId();
+    serializer.write(std::int32_t(42));
+    for (auto i = 0; i != 2; ++i) {
+        serializer.writeByte(bigId ? 0x6 : 0x2);
+        writeId();
+    }
+    serializer.writeByte(0x2);
+    serializer.writeVariableLengthUIntBE(99);
 
-    // deserialize the shared pointer assuming it has already been read and the type does not match
+    // deserialize the shared pointer and a further occurrence
     BinaryReflector::BinaryDeserializer deserializer(&stream);
-    shared_ptr<int> readPtr;
-    deserializer.m_pointer[fakePointer] = "foo";
-    CPPUNIT_ASSERT_THROW(deserializer.read(readPtr), CppUtilities::ConversionException);
-    CPPUNIT_ASSERT(readPtr == nullptr);
-
-    // deserialize the shared pointer assuming it has already been read and the type matches
-    stream.seekg(0);
-    deserializer.m_pointer[fakePointer] = make_shared<int>(42);
+    shared_ptr<std::int32_t> readPtr, furtherReadPtr;
     deserializer.read(readPtr);
+    deserializer.read(furtherReadPtr);
     CPPUNIT_ASSERT(readPtr != nullptr);
     CPPUNIT_ASSERT_EQUAL(42, *readPtr);
+    CPPUNIT_ASSERT(readPtr == furtherReadPtr);
+
+    // deserialize a further occurrence assuming the type does not match
+    shared_ptr<std::string> mismatchingPtr;
+    CPPUNIT_ASSERT_THROW(deserializer.read(mismatchingPtr), CppUtilities::ConversionException);
+    CPPUNIT_ASSERT(mismatchingPtr == nullptr);
+
+    // deserialize a reference to a pointer which has not been read
+    CPPUNIT_ASSERT_THROW(deserializer.read(furtherReadPtr), CppUtilities::ConversionException);
+
+    // deserialize a first occurrence reusing the ID of a pointer which has already been read
+    serializer.writeByte(bigId ? 0x5 : 0x1);
+    writeId();
+    serializer.write(std::int32_t(43));
+    CPPUNIT_ASSERT_THROW(deserializer.read(furtherReadPtr), CppUtilities::ConversionException);
+    CPPUNIT_ASSERT_EQUAL(42, *readPtr);
 }
 
 void BinaryReflectorTests::testSmallSharedPointer()
@@ -403,6 +739,68 @@ void BinaryReflectorTests::testBigSharedPointer()
     testSharedPointer(std::numeric_limits<std::uintptr_t>::max());
 }
 
+void BinaryReflectorTests::testSequentialSharedPointerIds()
+{
+    // serialize shared pointers twice (with different addresses)
+    const auto makePointers = [] {
+        auto a = make_shared<std::int32_t>(1), b = make_shared<std::int32_t>(2);
+        return std::vector<std::shared_ptr<std::int32_t>>{ a, b, a, nullptr, b };
+    };
+    // clang-format off
+    const auto expected = "\x85"
+        "\x01\x80\x00\x00\x00\x01"
+        "\x01\x81\x00\x00\x00\x02"
+        "\x02\x80"
+        "\x00"
+        "\x02\x81"s;
+    // clang-format on
+    const auto pointers = makePointers();
+    auto stream = std::stringstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    BinaryReflector::BinarySerializer(&stream).write(pointers);
+    CPPUNIT_ASSERT_EQUAL(expected, stream.str());
+    CPPUNIT_ASSERT_EQUAL(expected, BinaryReflector::toBinary(pointers));
+    CPPUNIT_ASSERT_EQUAL(expected, BinaryReflector::toBinary(makePointers()));
+    CPPUNIT_ASSERT_EQUAL(expected.size(), BinaryReflector::binarySize(pointers));
+
+    // deserialize them again
+    auto readPointers = std::vector<std::shared_ptr<std::int32_t>>();
+    BinaryReflector::BinaryDeserializer(&stream).read(readPointers);
+    CPPUNIT_ASSERT_EQUAL(5_st, readPointers.size());
+    CPPUNIT_ASSERT_EQUAL(1, *readPointers[0]);
+    CPPUNIT_ASSERT_EQUAL(2, *readPointers[1]);
+    CPPUNIT_ASSERT(readPointers[0] == readPointers[2]);
+    CPPUNIT_ASSERT(readPointers[3] == nullptr);
+    CPPUNIT_ASSERT(readPointers[1] == readPointers[4]);
+    readPointers = BinaryReflector::fromBinary<std::vector<std::shared_ptr<std::int32_t>>>(expected.data(), expected.size());
+    CPPUNIT_ASSERT_EQUAL(5_st, readPointers.size());
+    CPPUNIT_ASSERT(readPointers[0] == readPointers[2]);
+    CPPUNIT_ASSERT(readPointers[1] == readPointers[4]);
+
+    // continue IDs within custom types (de)serialized via the stream-based fallbacks for buffers
+    const auto holderPointers = makePointers();
+    auto holders = std::vector<std::pair<std::shared_ptr<std::int32_t>, SharedPointerHolderBinary>>(2);
+    holders[0].first = holderPointers[0];
+    holders[0].second.pointer = holderPointers[1];
+    holders[1].first = holderPointers[1];
+    holders[1].second.pointer = holderPointers[0];
+    // clang-format off
+    const auto expectedHolders = "\x82"
+        "\x01\x80\x00\x00\x00\x01"
+        "\x01\x81\x00\x00\x00\x02"
+        "\x02\x81"
+        "\x02\x80"s;
+    // clang-format on
+    CPPUNIT_ASSERT_EQUAL(expectedHolders, BinaryReflector::toBinary(holders));
+    CPPUNIT_ASSERT_EQUAL(expectedHolders.size(), BinaryReflector::binarySize(holders));
+    const auto readHolders = BinaryReflector::fromBinary<decltype(holders)>(expectedHolders.data(), expectedHolders.size());
+    CPPUNIT_ASSERT_EQUAL(2_st, readHolders.size());
+    CPPUNIT_ASSERT_EQUAL(1, *readHolders[0].first);
+    CPPUNIT_ASSERT_EQUAL(2, *readHolders[0].second.pointer);
+    CPPUNIT_ASSERT(readHolders[0].first == readHolders[1].second.pointer);
+    CPPUNIT_ASSERT(readHolders[0].second.pointer == readHolders[1].first);
+}
+
 void BinaryReflectorTests::testVariant()
 {
     // create test object
@@ -450,3 +848,696 @@ void BinaryReflectorTests::testOptional()
     CPPUNIT_ASSERT_EQUAL("foo"s, deserStr.value());
     CPPUNIT_ASSERT(!nullStr.has_value());
 }
+
+void BinaryReflectorTests::testBinarySize()
+{
+    // fixed sizes
+    static_assert(BinaryReflector::BinaryFixedSize<std::int32_t>::value == 4);
+    static_assert(BinaryReflector::BinaryFixedSize<bool>::value == 1);
+    static_assert(BinaryReflector::BinaryFixedSize<SomeEnumClassBinary>::value == sizeof(std::underlying_type_t<SomeEnumClassBinary>));
+    static_assert(BinaryReflector::BinaryFixedSize<std::pair<std::int32_t, double>>::value == 12);
+    static_assert(BinaryReflector::BinaryFixedSize<std::array<std::uint16_t, 3>>::value == 7);
+    static_assert(BinaryReflector::BinaryFixedSize<DateTime>::value == 8);
+    static_assert(BinaryReflector::BinaryFixedSize<std::string>::value == 0);
+    static_assert(BinaryReflector::BinaryFixedSize<std::vector<std::int32_t>>::value == 0);
+    static_assert(BinaryReflector::BinaryFixedSize<std::pair<std::int32_t, std::string>>::value == 0);
+    static_assert(BinaryReflector::BinaryFixedSize<TestObjectBinary>::value == 0);
+
+    // variable-length integers
+    CPPUNIT_ASSERT_EQUAL(1_st, BinaryReflector::Detail::variableLengthUIntSize(0x7F));
+    CPPUNIT_ASSERT_EQUAL(2_st, BinaryReflector::Detail::variableLengthUIntSize(0x80));
+    CPPUNIT_ASSERT_EQUAL(2_st, BinaryReflector::Detail::variableLengthUIntSize(0x3FFF));
+    CPPUNIT_ASSERT_EQUAL(3_st, BinaryReflector::Detail::variableLengthUIntSize(0x4000));
+    CPPUNIT_ASSERT_EQUAL(200_st * 2 + 2, BinaryReflector::binarySize(std::vector<std::uint16_t>(200)));
+
+    // custom types without measureCustomType() specialization (written to counting stream)
+    CPPUNIT_ASSERT_EQUAL(m_expectedTestObj.size(), BinaryReflector::binarySize(m_testObj));
+    CPPUNIT_ASSERT_EQUAL(m_expectedNestedTestObj.size(), BinaryReflector::binarySize(m_nestedTestObj));
+
+    // shared pointer are only written once
+    const auto pointer = std::make_shared<std::int32_t>(42);
+    const auto pointers = std::vector<std::shared_ptr<std::int32_t>>{ pointer, pointer, nullptr };
+    const auto serializedPointers = BinaryReflector::toBinary(pointers);
+    CPPUNIT_ASSERT_EQUAL(serializedPointers.size(), BinaryReflector::binarySize(pointers));
+
+    // serialization into string/buffer of exact size
+    const auto serializedTestObj = m_testObj.toBinary();
+    CPPUNIT_ASSERT_EQUAL(std::string(m_expectedTestObj.cbegin(), m_expectedTestObj.cend()), serializedTestObj);
+    auto tooSmallBuffer = std::string(m_expectedTestObj.size() - 1, '\0');
+    CPPUNIT_ASSERT_THROW(BinaryReflector::toBinary(m_testObj, tooSmallBuffer.data(), tooSmallBuffer.size()), CppUtilities::ConversionException);
+    const auto fixedSize = BinaryReflector::toFixedSizeBinary(std::make_pair(std::uint16_t(0x0102), true));
+    CPPUNIT_ASSERT_EQUAL(3_st, fixedSize.size());
+    CPPUNIT_ASSERT_EQUAL("\x01\x02\x01"s, std::string(fixedSize.data(), fixedSize.size()));
+}
+
+void BinaryReflectorTests::testBufferSerialization()
+{
+    // serialize/deserialize custom types with readCustomType()/writeCustomType() for buffers
+    const auto serializedTestObj = BinaryReflector::toBinary(m_testObj);
+    CPPUNIT_ASSERT_EQUAL(std::string(m_expectedTestObj.cbegin(), m_expectedTestObj.cend()), serializedTestObj);
+    assertTestObject(TestObjectBinary::fromBinary(serializedTestObj));
+
+    // serialize/deserialize custom types via the stream-based readCustomType()/writeCustomType()
+    auto serializedNestedTestObj = std::string("prefix");
+    BinaryReflector::BinaryBufferSerializer(serializedNestedTestObj).write(m_nestedTestObj);
+    CPPUNIT_ASSERT_EQUAL("prefix"s + std::string(m_expectedNestedTestObj.cbegin(), m_expectedNestedTestObj.cend()), serializedNestedTestObj);
+    auto nestingDeserializer = BinaryReflector::BinaryBufferDeserializer(serializedNestedTestObj.data(), serializedNestedTestObj.size());
+    nestingDeserializer.skip(6);
+    auto deserializedNestedTestObj = NestingArrayBinary();
+    nestingDeserializer.read(deserializedNestedTestObj);
+    CPPUNIT_ASSERT_EQUAL(0_st, nestingDeserializer.bytesRemaining());
+    CPPUNIT_ASSERT_EQUAL(m_nestedTestObj.name, deserializedNestedTestObj.name);
+    CPPUNIT_ASSERT_EQUAL(2_st, deserializedNestedTestObj.testObjects.size());
+    for (const auto &testObj : deserializedNestedTestObj.testObjects) {
+        assertTestObject(testObj);
+    }
+
+    // check that variable-length integers, strings and shared pointers are written exactly like BinarySerializer does
+    const auto pointer = std::make_shared<std::int32_t>(42);
+    const auto numbers = std::vector<std::uint64_t>{ 0, 0x7F, 0x80, 0x3FFF, 0x4000, 0xFFFFFFFFFFFFFF };
+    const auto pointers = std::vector<std::shared_ptr<std::int32_t>>{ pointer, pointer, nullptr };
+    const auto variant = std::variant<std::string, double>(-2.5);
+    auto stream = std::stringstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    auto streamSerializer = BinaryReflector::BinarySerializer(&stream);
+    auto buffer = std::string();
+    auto bufferSerializer = BinaryReflector::BinaryBufferSerializer(buffer);
+    for (const auto number : numbers) {
+        streamSerializer.writeVariableLengthUIntBE(number);
+        bufferSerializer.writeVariableLengthUIntBE(number);
+    }
+    streamSerializer.write(pointers);
+    bufferSerializer.write(pointers);
+    streamSerializer.write(variant);
+    bufferSerializer.write(variant);
+    streamSerializer.write("foo"s);
+    bufferSerializer.write("foo"s);
+    CPPUNIT_ASSERT_EQUAL(stream.str(), buffer);
+    CPPUNIT_ASSERT_EQUAL(buffer.size(), bufferSerializer.bytesWritten());
+
+    // read the data back
+    auto deserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    for (const auto number : numbers) {
+        CPPUNIT_ASSERT_EQUAL(number, deserializer.readVariableLengthUIntBE());
+    }
+    auto readPointers = std::vector<std::shared_ptr<std::int32_t>>();
+    auto readVariant = std::variant<std::string, double>();
+    auto readString = std::string();
+    deserializer.read(readPointers);
+    deserializer.read(readVariant);
+    deserializer.read(readString);
+    CPPUNIT_ASSERT_EQUAL(3_st, readPointers.size());
+    CPPUNIT_ASSERT(readPointers[0] != nullptr);
+    CPPUNIT_ASSERT_EQUAL(42, *readPointers[0]);
+    CPPUNIT_ASSERT(readPointers[0] == readPointers[1]);
+    CPPUNIT_ASSERT(readPointers[2] == nullptr);
+    CPPUNIT_ASSERT_EQUAL(-2.5, std::get<double>(readVariant));
+    CPPUNIT_ASSERT_EQUAL("foo"s, readString);
+    CPPUNIT_ASSERT_EQUAL(0_st, deserializer.bytesRemaining());
+
+    // reading beyond the end of the buffer is an error
+    CPPUNIT_ASSERT_THROW(deserializer.readByte(), CppUtilities::ConversionException);
+    CPPUNIT_ASSERT_THROW(TestObjectBinary::fromBinary(serializedTestObj.data(), serializedTestObj.size() - 1), CppUtilities::ConversionException);
+}
+
+void BinaryReflectorTests::testBulkSerialization()
+{
+    using BinaryReflector::binarySize;
+
+    // serialize containers of arithmetic values (big enough to be converted in multiple chunks)
+    auto numbers = std::vector<std::uint32_t>(3000);
+    for (std::size_t i = 0; i != numbers.size(); ++i) {
+        numbers[i] = static_cast<std::uint32_t>(i * 0x01020304u);
+    }
+    const auto floats = std::array<float, 3>{ 1.5f, -2.25f, 0.0f };
+    const auto doubles = std::vector<double>{ 2.5, -1.0e300 };
+    const auto shorts = std::vector<std::int16_t>{ -1, 0x1234 };
+    const auto bytes = std::vector<std::uint8_t>{ 0x00, 0x80, 0xFF };
+    auto stream = std::stringstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    auto streamSerializer = BinaryReflector::BinarySerializer(&stream);
+    auto buffer = std::string();
+    auto bufferSerializer = BinaryReflector::BinaryBufferSerializer(buffer);
+    streamSerializer.write(numbers);
+    streamSerializer.write(floats);
+    streamSerializer.write(doubles);
+    streamSerializer.write(shorts);
+    streamSerializer.write(bytes);
+    streamSerializer.write(std::vector<std::uint64_t>());
+    bufferSerializer.write(numbers);
+    bufferSerializer.write(floats);
+    bufferSerializer.write(doubles);
+    bufferSerializer.write(shorts);
+    bufferSerializer.write(bytes);
+    bufferSerializer.write(std::vector<std::uint64_t>());
+    CPPUNIT_ASSERT_EQUAL(stream.str(), buffer);
+
+    // check that the wire format is the same as when writing element by element
+    auto expected = std::string();
+    auto elementSerializer = BinaryReflector::BinaryBufferSerializer(expected);
+    const auto writeElements = [&elementSerializer](const auto &container) {
+        elementSerializer.writeVariableLengthUIntBE(container.size());
+        for (const auto element : container) {
+            elementSerializer.write(element);
+        }
+    };
+    writeElements(numbers);
+    writeElements(floats);
+    writeElements(doubles);
+    writeElements(shorts);
+    writeElements(bytes);
+    writeElements(std::vector<std::uint64_t>());
+    CPPUNIT_ASSERT_EQUAL(expected, buffer);
+    CPPUNIT_ASSERT_EQUAL(binarySize(numbers) + binarySize(floats) + binarySize(doubles) + binarySize(shorts) + binarySize(bytes) + 1, buffer.size());
+
+    // read the data back via stream and buffer
+    auto readNumbers = std::vector<std::uint32_t>();
+    auto readFloats = std::array<float, 3>();
+    auto readDoubles = std::vector<double>();
+    auto readShorts = std::vector<std::int16_t>();
+    auto readBytes = std::vector<std::uint8_t>();
+    auto readEmpty = std::vector<std::uint64_t>{ 1 };
+    auto streamDeserializer = BinaryReflector::BinaryDeserializer(&stream);
+    streamDeserializer.read(readNumbers);
+    streamDeserializer.read(readFloats);
+    streamDeserializer.read(readDoubles);
+    streamDeserializer.read(readShorts);
+    streamDeserializer.read(readBytes);
+    streamDeserializer.read(readEmpty);
+    CPPUNIT_ASSERT(numbers == readNumbers);
+    CPPUNIT_ASSERT(floats == readFloats);
+    CPPUNIT_ASSERT(doubles == readDoubles);
+    CPPUNIT_ASSERT(shorts == readShorts);
+    CPPUNIT_ASSERT(bytes == readBytes);
+    CPPUNIT_ASSERT(readEmpty.empty());
+    readNumbers.clear();
+    readFloats = std::array<float, 3>();
+    auto bufferDeserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    bufferDeserializer.read(readNumbers);
+    bufferDeserializer.read(readFloats);
+    CPPUNIT_ASSERT(numbers == readNumbers);
+    CPPUNIT_ASSERT(floats == readFloats);
+
+    // the number of elements must match the size of std::array
+    auto tooBigArray = std::array<float, 4>();
+    CPPUNIT_ASSERT_THROW(BinaryReflector::BinaryBufferDeserializer(buffer.data() + binarySize(numbers), binarySize(floats)).read(tooBigArray),
+        CppUtilities::ConversionException);
+
+    // reading beyond the end of the buffer is an error (also when the number of elements is too big to be allocated)
+    CPPUNIT_ASSERT_THROW(
+        BinaryReflector::BinaryBufferDeserializer(buffer.data(), binarySize(numbers) - 1).read(readNumbers), CppUtilities::ConversionException);
+    const auto hugeSize = "\x01\xFF\xFF\xFF\xFF\xFF\xFF\xFF"s;
+    CPPUNIT_ASSERT_THROW(
+        BinaryReflector::BinaryBufferDeserializer(hugeSize.data(), hugeSize.size()).read(readDoubles), CppUtilities::ConversionException);
+}
+
+void BinaryReflectorTests::testByteOrder()
+{
+    // write header and data in little-endian byte order
+    const auto numbers = std::vector<std::uint32_t>{ 0x01020304, 0x05060708 };
+    auto stream = std::stringstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    auto streamSerializer = BinaryReflector::BinarySerializer(&stream);
+    streamSerializer.writeHeader(BinaryReflector::BinaryByteOrder::LittleEndian);
+    CPPUNIT_ASSERT(streamSerializer.byteOrder() == BinaryReflector::BinaryByteOrder::LittleEndian);
+    streamSerializer.write(std::int16_t(0x0102));
+    streamSerializer.write(numbers);
+    streamSerializer.write(m_testObj);
+    const auto littleEndian = stream.str();
+    CPPUNIT_ASSERT_EQUAL("RRJB\x01\x01\x02\x01\x82\x04\x03\x02\x01\x08\x07\x06\x05"s, littleEndian.substr(0, 17));
+
+    // write the same via buffer serializer
+    auto buffer = std::string();
+    auto bufferSerializer = BinaryReflector::BinaryBufferSerializer(buffer);
+    bufferSerializer.writeHeader(BinaryReflector::BinaryByteOrder::LittleEndian);
+    bufferSerializer.write(std::int16_t(0x0102));
+    bufferSerializer.write(numbers);
+    bufferSerializer.write(m_testObj);
+    CPPUNIT_ASSERT_EQUAL(littleEndian, buffer);
+    auto calculator = BinaryReflector::BinarySizeCalculator();
+    calculator.writeHeader();
+    calculator.write(std::int16_t(0x0102));
+    calculator.write(numbers);
+    calculator.write(m_testObj);
+    CPPUNIT_ASSERT_EQUAL(littleEndian.size(), calculator.size());
+
+    // read the data back determining the byte order from the header
+    auto streamDeserializer = BinaryReflector::BinaryDeserializer(&stream);
+    auto readShort = std::int16_t();
+    auto readNumbers = std::vector<std::uint32_t>();
+    auto readTestObj = TestObjectBinary();
+    CPPUNIT_ASSERT(streamDeserializer.readHeader() == BinaryReflector::BinaryByteOrder::LittleEndian);
+    streamDeserializer.read(readShort);
+    streamDeserializer.read(readNumbers);
+    streamDeserializer.read(readTestObj);
+    CPPUNIT_ASSERT_EQUAL(std::int16_t(0x0102), readShort);
+    CPPUNIT_ASSERT(numbers == readNumbers);
+    assertTestObject(readTestObj);
+    auto bufferDeserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    CPPUNIT_ASSERT(bufferDeserializer.readHeader() == BinaryReflector::BinaryByteOrder::LittleEndian);
+    readTestObj = TestObjectBinary();
+    bufferDeserializer.read(readShort);
+    bufferDeserializer.read(readNumbers);
+    bufferDeserializer.read(readTestObj);
+    CPPUNIT_ASSERT_EQUAL(std::int16_t(0x0102), readShort);
+    CPPUNIT_ASSERT(numbers == readNumbers);
+    assertTestObject(readTestObj);
+    CPPUNIT_ASSERT_EQUAL(0_st, bufferDeserializer.bytesRemaining());
+
+    // big-endian data after the header is the same as without header
+    auto bigEndian = std::string();
+    auto bigEndianSerializer = BinaryReflector::BinaryBufferSerializer(bigEndian);
+    bigEndianSerializer.writeHeader(BinaryReflector::BinaryByteOrder::BigEndian);
+    bigEndianSerializer.write(m_testObj);
+    CPPUNIT_ASSERT_EQUAL("RRJB\x01\x00"s + std::string(m_expectedTestObj.cbegin(), m_expectedTestObj.cend()), bigEndian);
+
+    // invalid headers are rejected
+    const auto invalidMagic = "RRJX\x01\x00"s, invalidRevision = "RRJB\x02\x00"s, invalidByteOrder = "RRJB\x01\x02"s;
+    CPPUNIT_ASSERT_THROW(
+        BinaryReflector::BinaryBufferDeserializer(invalidMagic.data(), invalidMagic.size()).readHeader(), CppUtilities::ConversionException);
+    CPPUNIT_ASSERT_THROW(
+        BinaryReflector::BinaryBufferDeserializer(invalidRevision.data(), invalidRevision.size()).readHeader(), CppUtilities::ConversionException);
+    CPPUNIT_ASSERT_THROW(
+        BinaryReflector::BinaryBufferDeserializer(invalidByteOrder.data(), invalidByteOrder.size()).readHeader(), CppUtilities::ConversionException);
+}
+
+void BinaryReflectorTests::testSkippableRecords()
+{
+    auto records = std::vector<SkippableRecordV2Binary>(2);
+    records[0].number = 1;
+    records[0].text = "foo";
+    records[0].tags = { "a", "bc" };
+    records[1].number = 2;
+    records[1].text = "bar";
+
+    // write records (prefixed with version and size) followed by a further value
+    auto stream = std::stringstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    auto streamSerializer = BinaryReflector::BinarySerializer(&stream);
+    streamSerializer.write(records);
+    streamSerializer.write(std::uint16_t(0xF00D));
+    const auto data = stream.str();
+    CPPUNIT_ASSERT_EQUAL("\x82\x82\x8E\x00\x00\x00\x01\x83\x66\x6F\x6F\x82\x81\x61\x82\x62\x63"
+                         "\x82\x89\x00\x00\x00\x02\x83\x62\x61\x72\x80\xF0\x0D"s,
+        data);
+
+    // write the same via buffer serializers
+    auto buffer = std::string();
+    auto bufferSerializer = BinaryReflector::BinaryBufferSerializer(buffer);
+    bufferSerializer.write(records);
+    bufferSerializer.write(std::uint16_t(0xF00D));
+    CPPUNIT_ASSERT_EQUAL(data, buffer);
+    auto fixedSizeBuffer = std::string(data.size(), '\0');
+    auto fixedSizeBufferSerializer = BinaryReflector::BinaryBufferSerializer(fixedSizeBuffer.data(), fixedSizeBuffer.size());
+    fixedSizeBufferSerializer.write(records);
+    fixedSizeBufferSerializer.write(std::uint16_t(0xF00D));
+    CPPUNIT_ASSERT_EQUAL(data, fixedSizeBuffer);
+    auto calculator = BinaryReflector::BinarySizeCalculator();
+    calculator.write(records);
+    calculator.write(std::uint16_t(0xF00D));
+    CPPUNIT_ASSERT_EQUAL(data.size(), calculator.size());
+
+    // read the records via the older version skipping the tags
+    auto streamDeserializer = BinaryReflector::BinaryDeserializer(&stream);
+    auto oldRecords = std::vector<SkippableRecordV1Binary>();
+    auto furtherValue = std::uint16_t();
+    streamDeserializer.read(oldRecords);
+    streamDeserializer.read(furtherValue);
+    CPPUNIT_ASSERT_EQUAL(2_st, oldRecords.size());
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(1), oldRecords[0].number);
+    CPPUNIT_ASSERT_EQUAL("foo"s, oldRecords[0].text);
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(2), oldRecords[1].number);
+    CPPUNIT_ASSERT_EQUAL("bar"s, oldRecords[1].text);
+    CPPUNIT_ASSERT_EQUAL(std::uint16_t(0xF00D), furtherValue);
+    auto bufferDeserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    oldRecords.clear();
+    bufferDeserializer.read(oldRecords);
+    bufferDeserializer.read(furtherValue);
+    CPPUNIT_ASSERT_EQUAL(2_st, oldRecords.size());
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(1), oldRecords[0].number);
+    CPPUNIT_ASSERT_EQUAL("foo"s, oldRecords[0].text);
+    CPPUNIT_ASSERT_EQUAL("bar"s, oldRecords[1].text);
+    CPPUNIT_ASSERT_EQUAL(std::uint16_t(0xF00D), furtherValue);
+    CPPUNIT_ASSERT_EQUAL(0_st, bufferDeserializer.bytesRemaining());
+    auto oldRecord = SkippableRecordV1Binary();
+    CPPUNIT_ASSERT_EQUAL(BinaryVersion(2), BinaryReflector::BinaryBufferDeserializer(buffer.data() + 1, buffer.size() - 1).read(oldRecord));
+
+    // read a record written by the older version via the newer version
+    const auto oldData = oldRecord.toBinary();
+    CPPUNIT_ASSERT_EQUAL("\x81\x88\x00\x00\x00\x01\x83\x66\x6F\x6F"s, oldData);
+    const auto newRecord = SkippableRecordV2Binary::fromBinary(oldData);
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(1), newRecord.number);
+    CPPUNIT_ASSERT_EQUAL("foo"s, newRecord.text);
+    CPPUNIT_ASSERT(newRecord.tags.empty());
+
+    // read records exceeding the internal buffer of the stream-based deserializer
+    auto bigRecord = SkippableRecordV2Binary();
+    bigRecord.number = 3;
+    bigRecord.text = std::string(1000, 'x');
+    bigRecord.tags = std::vector<std::string>(100, "some tag");
+    auto bigRecordStream = std::stringstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    bigRecordStream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    auto bigRecordSerializer = BinaryReflector::BinarySerializer(&bigRecordStream);
+    bigRecordSerializer.write(bigRecord);
+    bigRecordSerializer.write(std::uint16_t(0xF00D));
+    auto bigRecordDeserializer = BinaryReflector::BinaryDeserializer(&bigRecordStream);
+    bigRecordDeserializer.read(oldRecord);
+    bigRecordDeserializer.read(furtherValue);
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(3), oldRecord.number);
+    CPPUNIT_ASSERT_EQUAL(bigRecord.text, oldRecord.text);
+    CPPUNIT_ASSERT_EQUAL(std::uint16_t(0xF00D), furtherValue);
+
+    // records exceeding the data are rejected
+    const auto truncated = data.substr(0, 10);
+    auto truncatedRecords = std::vector<SkippableRecordV1Binary>();
+    CPPUNIT_ASSERT_THROW(
+        BinaryReflector::BinaryBufferDeserializer(truncated.data(), truncated.size()).read(truncatedRecords), CppUtilities::ConversionException);
+    auto truncatedStream = std::stringstream(truncated, std::ios_base::in | std::ios_base::binary);
+    truncatedStream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    CPPUNIT_ASSERT_THROW(BinaryReflector::BinaryDeserializer(&truncatedStream).read(truncatedRecords), std::ios_base::failure);
+
+    // the size of records is not trusted (the data is not allocated upfront)
+    const auto hugeRecord = "\x82\x01\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x00\x00\x00\x01\x83\x66\x6F\x6F"s;
+    auto hugeRecordStream = std::stringstream(hugeRecord, std::ios_base::in | std::ios_base::binary);
+    hugeRecordStream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    CPPUNIT_ASSERT_THROW(BinaryReflector::BinaryDeserializer(&hugeRecordStream).read(oldRecord), std::ios_base::failure);
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(1), oldRecord.number);
+    CPPUNIT_ASSERT_EQUAL("foo"s, oldRecord.text);
+    CPPUNIT_ASSERT_THROW(BinaryReflector::BinaryBufferDeserializer(hugeRecord.data(), hugeRecord.size()).read(oldRecord),
+        CppUtilities::ConversionException);
+}
+
+void BinaryReflectorTests::testProjection()
+{
+    auto object = ProjectedObjectBinary();
+    object.number = 42;
+    object.text = "foo";
+    object.numbers = { 1, 2, 3 };
+    object.someMap = { { "a", { "b", "c" } }, { "d", {} } };
+    object.someOptional = "bar";
+    object.someVariant = "baz"s;
+    object.someSharedPointer = make_shared<string>("shared");
+    object.record.number = 5;
+    object.record.text = "record";
+    object.record.tags = { "tag" };
+    object.boolean = true;
+    auto buffer = std::string();
+    auto serializer = BinaryReflector::BinaryBufferSerializer(buffer);
+    serializer.write(object);
+    serializer.write(std::uint16_t(0xF00D));
+
+    // read only some members skipping all others
+    using Fields = BinaryReflector::BinaryFields<ProjectedObjectBinary>;
+    auto deserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    auto projected = ProjectedObjectBinary();
+    auto furtherValue = std::uint16_t();
+    deserializer.readProjected(projected, Fields::text | Fields::boolean);
+    deserializer.read(furtherValue);
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(0), projected.number);
+    CPPUNIT_ASSERT_EQUAL("foo"s, projected.text);
+    CPPUNIT_ASSERT(projected.numbers.empty());
+    CPPUNIT_ASSERT(projected.someMap.empty());
+    CPPUNIT_ASSERT(!projected.someOptional.has_value());
+    CPPUNIT_ASSERT_EQUAL(0_st, projected.someVariant.index());
+    CPPUNIT_ASSERT(!projected.someSharedPointer);
+    CPPUNIT_ASSERT(projected.record.text.empty());
+    CPPUNIT_ASSERT(projected.boolean);
+    CPPUNIT_ASSERT_EQUAL(std::uint16_t(0xF00D), furtherValue);
+    CPPUNIT_ASSERT_EQUAL(0_st, deserializer.bytesRemaining());
+
+    // read the remaining members
+    deserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    deserializer.readProjected(projected, Fields::number | Fields::numbers | Fields::someMap | Fields::someVariant | Fields::record);
+    deserializer.read(furtherValue);
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(42), projected.number);
+    CPPUNIT_ASSERT_EQUAL((vector<std::uint16_t>{ 1, 2, 3 }), projected.numbers);
+    CPPUNIT_ASSERT_EQUAL(2_st, projected.someMap.size());
+    CPPUNIT_ASSERT_EQUAL((vector<string>{ "b", "c" }), projected.someMap["a"]);
+    CPPUNIT_ASSERT_EQUAL("baz"s, get<string>(projected.someVariant));
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(5), projected.record.number);
+    CPPUNIT_ASSERT_EQUAL("record"s, projected.record.text);
+    CPPUNIT_ASSERT_EQUAL((vector<string>{ "tag" }), projected.record.tags);
+    CPPUNIT_ASSERT_EQUAL(std::uint16_t(0xF00D), furtherValue);
+
+    // read all members
+    deserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    projected = ProjectedObjectBinary();
+    deserializer.readProjected(projected, ~BinaryReflector::BinaryFieldMask());
+    CPPUNIT_ASSERT_EQUAL("bar"s, projected.someOptional.value());
+    CPPUNIT_ASSERT(projected.someSharedPointer);
+    CPPUNIT_ASSERT_EQUAL("shared"s, *projected.someSharedPointer);
+    CPPUNIT_ASSERT_EQUAL(2_st, deserializer.bytesRemaining());
+
+    // skip values directly
+    deserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    deserializer.skipValue<ProjectedObjectBinary>();
+    CPPUNIT_ASSERT_EQUAL(2_st, deserializer.bytesRemaining());
+
+    // skipping data which is too short is detected
+    deserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), 10);
+    CPPUNIT_ASSERT_THROW(deserializer.readProjected(projected, Fields::boolean), ConversionException);
+
+    // skippable records are skipped via their length without looking at their members
+    const auto recordText = buffer.find("\x86record");
+    CPPUNIT_ASSERT(recordText != std::string::npos);
+    buffer[recordText] = '\xFF';
+    deserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    deserializer.readProjected(projected, Fields::boolean);
+    deserializer.read(furtherValue);
+    CPPUNIT_ASSERT_EQUAL(std::uint16_t(0xF00D), furtherValue);
+    deserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    CPPUNIT_ASSERT_THROW(deserializer.readProjected(projected, Fields::record), ConversionException);
+}
+
+void BinaryReflectorTests::testSchemaHeader()
+{
+    auto records = std::vector<SkippableRecordV2Binary>(2);
+    records[0].number = 1;
+    records[0].text = "foo";
+    records[0].tags = { "a", "bc" };
+    records[1].number = 2;
+    records[1].text = "bar";
+
+    // write header recording the schema followed by records without version
+    auto stream = std::stringstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    auto streamSerializer = BinaryReflector::BinarySerializer(&stream);
+    streamSerializer.writeHeader<SkippableRecordV2Binary>(BinaryReflector::BinaryByteOrder::BigEndian);
+    streamSerializer.write(records);
+    const auto data = stream.str();
+    CPPUNIT_ASSERT_EQUAL("RRJB\x02\x00\x01\x02\x03\x04\x05\x06\x07\x08\x82"
+                         "\x82\x8E\x00\x00\x00\x01\x83\x66\x6F\x6F\x82\x81\x61\x82\x62\x63"
+                         "\x89\x00\x00\x00\x02\x83\x62\x61\x72\x80"s,
+        data);
+    CPPUNIT_ASSERT_EQUAL(BinaryVersion(2), streamSerializer.schema().version);
+
+    // write the same via buffer serializer
+    auto buffer = std::string();
+    auto bufferSerializer = BinaryReflector::BinaryBufferSerializer(buffer);
+    bufferSerializer.writeHeader<SkippableRecordV2Binary>(BinaryReflector::BinaryByteOrder::BigEndian);
+    bufferSerializer.write(records);
+    CPPUNIT_ASSERT_EQUAL(data, buffer);
+    auto calculator = BinaryReflector::BinarySizeCalculator();
+    calculator.writeHeader<SkippableRecordV2Binary>();
+    calculator.write(records);
+    CPPUNIT_ASSERT_EQUAL(data.size(), calculator.size());
+
+    // types without fingerprint lead to the same header as without schema
+    auto withoutSchema = std::string();
+    BinaryReflector::BinaryBufferSerializer(withoutSchema).writeHeader<TestObjectBinary>(BinaryReflector::BinaryByteOrder::BigEndian);
+    CPPUNIT_ASSERT_EQUAL("RRJB\x01\x00"s, withoutSchema);
+
+    // read the records via the same type verifying the schema
+    auto streamDeserializer = BinaryReflector::BinaryDeserializer(&stream);
+    auto readRecords = std::vector<SkippableRecordV2Binary>();
+    streamDeserializer.readHeader<SkippableRecordV2Binary>();
+    CPPUNIT_ASSERT(streamDeserializer.schema().verified);
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(0x0102030405060708), streamDeserializer.schema().fingerprint);
+    CPPUNIT_ASSERT_EQUAL(BinaryVersion(2), streamDeserializer.schema().version);
+    streamDeserializer.read(readRecords);
+    CPPUNIT_ASSERT_EQUAL(2_st, readRecords.size());
+    CPPUNIT_ASSERT_EQUAL("foo"s, readRecords[0].text);
+    CPPUNIT_ASSERT_EQUAL((std::vector<std::string>{ "a", "bc" }), readRecords[0].tags);
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(2), readRecords[1].number);
+    auto bufferDeserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    readRecords.clear();
+    bufferDeserializer.readHeader<SkippableRecordV2Binary>();
+    CPPUNIT_ASSERT(bufferDeserializer.schema().verified);
+    bufferDeserializer.read(readRecords);
+    CPPUNIT_ASSERT_EQUAL(2_st, readRecords.size());
+    CPPUNIT_ASSERT_EQUAL((std::vector<std::string>{ "a", "bc" }), readRecords[0].tags);
+    CPPUNIT_ASSERT_EQUAL("bar"s, readRecords[1].text);
+    CPPUNIT_ASSERT_EQUAL(0_st, bufferDeserializer.bytesRemaining());
+
+    // read the records via the older version which has a different schema using the version from the header
+    auto oldRecords = std::vector<SkippableRecordV1Binary>();
+    bufferDeserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    bufferDeserializer.readHeader<SkippableRecordV1Binary>();
+    CPPUNIT_ASSERT(!bufferDeserializer.schema().verified);
+    bufferDeserializer.read(oldRecords);
+    CPPUNIT_ASSERT_EQUAL(2_st, oldRecords.size());
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(1), oldRecords[0].number);
+    CPPUNIT_ASSERT_EQUAL("foo"s, oldRecords[0].text);
+    CPPUNIT_ASSERT_EQUAL("bar"s, oldRecords[1].text);
+    CPPUNIT_ASSERT_EQUAL(0_st, bufferDeserializer.bytesRemaining());
+
+    // headers of a newer revision are rejected
+    const auto newerRevision = "RRJB\x03\x00"s;
+    CPPUNIT_ASSERT_THROW(BinaryReflector::BinaryBufferDeserializer(newerRevision.data(), newerRevision.size()).readHeader(), ConversionException);
+}
+
+void BinaryReflectorTests::testPackedIntegers()
+{
+    // write small values taking one byte and a value taking two bytes (zigzag-encoded as 2, 3 and 600)
+    auto counters = PackedCountersBinary{ 1, -2, 300 };
+    auto buffer = std::string();
+    auto bufferSerializer = BinaryReflector::BinaryBufferSerializer(buffer);
+    bufferSerializer.write(counters);
+    CPPUNIT_ASSERT_EQUAL("\x83\x10\x02\x03\x58\x02"s, buffer);
+    CPPUNIT_ASSERT_EQUAL(buffer.size(), BinaryReflector::binarySize(counters));
+
+    // write many values of different sizes so full groups of four elements and the remaining elements are decoded
+    auto manyCounters = PackedCountersBinary();
+    auto eventIds = PackedEventIdsBinary();
+    for (auto i = std::int32_t(); i != 103; ++i) {
+        manyCounters.emplace_back(i % 2 ? -i * i * i * 1000 : i);
+        eventIds.emplace_back(std::uint64_t(1) << ((i * 7) % 64));
+    }
+    manyCounters.emplace_back(std::numeric_limits<std::int32_t>::min());
+    manyCounters.emplace_back(std::numeric_limits<std::int32_t>::max());
+    eventIds.emplace_back(std::numeric_limits<std::uint64_t>::max());
+    const auto array = PackedArrayBinary{ 1, -0x100, std::numeric_limits<std::int16_t>::min() };
+    static_assert(BinaryReflector::BinaryFixedSize<PackedArrayBinary>::value == 0);
+    auto stream = std::stringstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    auto streamSerializer = BinaryReflector::BinarySerializer(&stream);
+    streamSerializer.write(manyCounters);
+    streamSerializer.write(eventIds);
+    streamSerializer.write(array);
+    streamSerializer.write(PackedCountersBinary());
+    streamSerializer.write(std::uint16_t(0xF00D));
+    buffer.clear();
+    bufferSerializer.write(manyCounters);
+    bufferSerializer.write(eventIds);
+    bufferSerializer.write(array);
+    bufferSerializer.write(PackedCountersBinary());
+    bufferSerializer.write(std::uint16_t(0xF00D));
+    CPPUNIT_ASSERT_EQUAL(stream.str(), buffer);
+    auto calculator = BinaryReflector::BinarySizeCalculator();
+    calculator.write(manyCounters);
+    calculator.write(eventIds);
+    calculator.write(array);
+    calculator.write(PackedCountersBinary());
+    calculator.write(std::uint16_t(0xF00D));
+    CPPUNIT_ASSERT_EQUAL(buffer.size(), calculator.size());
+    CPPUNIT_ASSERT(buffer.size() < (manyCounters.size() * sizeof(std::int32_t) + eventIds.size() * sizeof(std::uint64_t)));
+
+    // read the values back
+    auto readCounters = PackedCountersBinary{ 5 };
+    auto readEventIds = PackedEventIdsBinary();
+    auto readArray = PackedArrayBinary();
+    auto furtherValue = std::uint16_t();
+    auto streamDeserializer = BinaryReflector::BinaryDeserializer(&stream);
+    streamDeserializer.read(readCounters);
+    streamDeserializer.read(readEventIds);
+    streamDeserializer.read(readArray);
+    CPPUNIT_ASSERT(manyCounters == readCounters);
+    CPPUNIT_ASSERT(eventIds == readEventIds);
+    CPPUNIT_ASSERT(array == readArray);
+    streamDeserializer.read(readCounters);
+    streamDeserializer.read(furtherValue);
+    CPPUNIT_ASSERT(readCounters.empty());
+    CPPUNIT_ASSERT_EQUAL(std::uint16_t(0xF00D), furtherValue);
+    auto bufferDeserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    readEventIds.clear();
+    readArray = PackedArrayBinary();
+    bufferDeserializer.read(readCounters);
+    bufferDeserializer.read(readEventIds);
+    bufferDeserializer.read(readArray);
+    CPPUNIT_ASSERT(manyCounters == readCounters);
+    CPPUNIT_ASSERT(eventIds == readEventIds);
+    CPPUNIT_ASSERT(array == readArray);
+
+    // skip the values
+    bufferDeserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    bufferDeserializer.skipValue<PackedCountersBinary>();
+    bufferDeserializer.skipValue<PackedEventIdsBinary>();
+    bufferDeserializer.skipValue<PackedArrayBinary>();
+    bufferDeserializer.skipValue<PackedCountersBinary>();
+    bufferDeserializer.read(furtherValue);
+    CPPUNIT_ASSERT_EQUAL(std::uint16_t(0xF00D), furtherValue);
+    CPPUNIT_ASSERT_EQUAL(0_st, bufferDeserializer.bytesRemaining());
+
+    // truncated data is detected
+    bufferDeserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), 20);
+    CPPUNIT_ASSERT_THROW(bufferDeserializer.read(readCounters), ConversionException);
+
+    // variable-length integers at the end of the buffer are read byte by byte
+    buffer.clear();
+    bufferSerializer.writeVariableLengthUIntBE(0x3FFF);
+    bufferSerializer.writeVariableLengthUIntBE(0x4000);
+    bufferDeserializer = BinaryReflector::BinaryBufferDeserializer(buffer.data(), buffer.size());
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(0x3FFF), bufferDeserializer.readVariableLengthUIntBE());
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(0x4000), bufferDeserializer.readVariableLengthUIntBE());
+}
+
+#ifdef PLATFORM_UNIX
+void BinaryReflectorTests::testMappedFile()
+{
+    // write strings to a temporary file
+    using Strings = std::vector<std::pair<std::string_view, std::uint32_t>>;
+    const auto strings = Strings{ { "foo", 1 }, { "", 2 }, { "some longer string", 3 } };
+    const auto serializedStrings = BinaryReflector::toBinary(strings);
+    auto stream = std::stringstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    BinaryReflector::BinarySerializer(&stream).write(strings);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("string_view written like std::string", stream.str(), serializedStrings);
+    CPPUNIT_ASSERT_EQUAL(
+        BinaryReflector::toBinary(std::vector<std::pair<std::string, std::uint32_t>>{ { "foo", 1 }, { "", 2 }, { "some longer string", 3 } }),
+        serializedStrings);
+    // prepend a header switching to little-endian which must be taken into account when reading the numbers back
+    auto fileContents = std::string();
+    auto fileSerializer = BinaryReflector::BinaryBufferSerializer(fileContents);
+    fileSerializer.writeHeader<Strings>(BinaryReflector::BinaryByteOrder::LittleEndian);
+    fileSerializer.write(strings);
+    const auto file = std::unique_ptr<std::FILE, decltype(&std::fclose)>(std::tmpfile(), &std::fclose);
+    CPPUNIT_ASSERT(file != nullptr);
+    CPPUNIT_ASSERT_EQUAL(fileContents.size(), std::fwrite(fileContents.data(), 1, fileContents.size(), file.get()));
+    CPPUNIT_ASSERT_EQUAL(0, std::fflush(file.get()));
+
+    // read strings back without copying them
+    const auto mappedStrings = BinaryReflector::BinaryMappedObject<Strings>(BinaryReflector::BinaryFileMapping(fileno(file.get())));
+    const auto &mapping = mappedStrings.mapping();
+    CPPUNIT_ASSERT_EQUAL(fileContents.size(), mapping.size());
+    CPPUNIT_ASSERT_EQUAL(strings.size(), mappedStrings->size());
+    for (std::size_t i = 0; i != strings.size(); ++i) {
+        const auto &[string, number] = mappedStrings.get()[i];
+        CPPUNIT_ASSERT_EQUAL(std::string(strings[i].first), std::string(string));
+        CPPUNIT_ASSERT_EQUAL(strings[i].second, number);
+        CPPUNIT_ASSERT_MESSAGE(
+            "string_view points into mapping", string.data() >= mapping.data() && string.data() <= mapping.data() + mapping.size());
+    }
+
+    // borrowing is not possible from streams
+    static_assert(!CanBorrowStrings<BinaryReflector::BinaryDeserializer>::value, "reading std::string_view from stream does not compile");
+    static_assert(CanBorrowStrings<BinaryReflector::BinaryBufferDeserializer>::value, "reading std::string_view from buffer compiles");
+
+    // reading beyond the end of the mapping is an error
+    CPPUNIT_ASSERT_EQUAL(0, ftruncate(fileno(file.get()), static_cast<off_t>(fileContents.size() - 1)));
+    CPPUNIT_ASSERT_THROW(BinaryReflector::BinaryMappedObject<Strings>(BinaryReflector::BinaryFileMapping(fileno(file.get()))),
+        CppUtilities::ConversionException);
+
+    // mapped data without header is an error
+    CPPUNIT_ASSERT_EQUAL(0, ftruncate(fileno(file.get()), 0));
+    CPPUNIT_ASSERT_EQUAL(0, std::fseek(file.get(), 0, SEEK_SET));
+    CPPUNIT_ASSERT_EQUAL(serializedStrings.size(), std::fwrite(serializedStrings.data(), 1, serializedStrings.size(), file.get()));
+    CPPUNIT_ASSERT_EQUAL(0, std::fflush(file.get()));
+    CPPUNIT_ASSERT_THROW(BinaryReflector::BinaryMappedObject<Strings>(BinaryReflector::BinaryFileMapping(fileno(file.get()))),
+        CppUtilities::ConversionException);
+
+    // empty files can be mapped but contain no data
+    CPPUNIT_ASSERT_EQUAL(0, ftruncate(fileno(file.get()), 0));
+    const auto emptyMapping = BinaryReflector::BinaryFileMapping(fileno(file.get()));
+    CPPUNIT_ASSERT_EQUAL(0_st, emptyMapping.size());
+    CPPUNIT_ASSERT(emptyMapping.data() == nullptr);
+}
+#endif
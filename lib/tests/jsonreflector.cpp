@@ -1,3 +1,6 @@
+#include "../json/errorformatting.h"
+#include "../json/jsonlines.h"
+#include "../json/parallel.h"
 #include "../json/reflector.h"
 #include "../json/serializable.h"
 
@@ -14,8 +17,12 @@ using CppUtilities::operator<<; // must be visible prior to the call site
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <cstdio>
 #include <iostream>
+#include <limits>
+#include <list>
 #include <map>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -30,6 +37,9 @@ using namespace ReflectiveRapidJSON;
 
 /// \cond
 
+// format long double values with two decimal places via std::to_chars (long double is not used by other tests)
+REFLECTIVE_RAPIDJSON_JSON_NUMBER_FORMAT(long double, JsonNumberBackend::CharConv, 2);
+
 // define some enums and structs for testing serialization
 
 enum SomeEnum {
@@ -73,10 +83,34 @@ struct NestingArray : public JsonSerializable<NestingArray> {
     vector<TestObject> testObjects;
 };
 
+struct PushOnlyObject : public JsonSerializable<PushOnlyObject> {
+    int number;
+    string text;
+};
+
+struct UnsortedMultiMap : public vector<pair<string, int>> {
+    using key_type = string;
+    using mapped_type = int;
+};
+
+namespace ReflectiveRapidJSON {
+REFLECTIVE_RAPIDJSON_TREAT_AS_MULTI_MAP_OR_HASH(UnsortedMultiMap);
+} // namespace ReflectiveRapidJSON
+
 // pretend serialization code for structs has been generated
 namespace ReflectiveRapidJSON {
 namespace JsonReflector {
 
+template <> struct JsonMemberKeys<NestingObject> {
+    static constexpr JsonMemberKey name{ "name", "\"name\"" };
+    static constexpr JsonMemberKey testObj{ "testObj", "\"testObj\"" };
+};
+
+template <> struct JsonMemberKeys<NestingArray> {
+    static constexpr JsonMemberKey name{ "name", "\"name\"" };
+    static constexpr JsonMemberKey testObjects{ "testObjects", "\"testObjects\"" };
+};
+
 template <> inline void push<TestObject>(const TestObject &reflectable, Value::Object &value, Document::AllocatorType &allocator)
 {
     push(reflectable.number, "number", value, allocator);
@@ -99,14 +133,66 @@ template <> inline void push<TestObject>(const TestObject &reflectable, Value::O
 
 template <> inline void push<NestingObject>(const NestingObject &reflectable, Value::Object &value, Document::AllocatorType &allocator)
 {
-    push(reflectable.name, "name", value, allocator);
-    push(reflectable.testObj, "testObj", value, allocator);
+    push(reflectable.name, JsonMemberKeys<NestingObject>::name, value, allocator);
+    push(reflectable.testObj, JsonMemberKeys<NestingObject>::testObj, value, allocator);
 }
 
 template <> inline void push<NestingArray>(const NestingArray &reflectable, Value::Object &value, Document::AllocatorType &allocator)
 {
-    push(reflectable.name, "name", value, allocator);
-    push(reflectable.testObjects, "testObjects", value, allocator);
+    push(reflectable.name, JsonMemberKeys<NestingArray>::name, value, allocator);
+    push(reflectable.testObjects, JsonMemberKeys<NestingArray>::testObjects, value, allocator);
+}
+
+// pretend push() has been written by hand for PushOnlyObject (write() falls back to it)
+template <> inline void push<PushOnlyObject>(const PushOnlyObject &reflectable, Value::Object &value, Document::AllocatorType &allocator)
+{
+    push(reflectable.number, "number", value, allocator);
+    push(reflectable.text, "text", value, allocator);
+}
+
+template <> struct HasCustomTypeWriter<TestObject> : public Traits::Bool<true> {};
+template <> struct HasCustomTypeWriter<NestingObject> : public Traits::Bool<true> {};
+template <> struct HasCustomTypeWriter<NestingArray> : public Traits::Bool<true> {};
+
+template <>
+template <typename Handler>
+inline SizeType CustomTypeWriter<TestObject>::writeMembers(const TestObject &reflectable, Handler &handler)
+{
+    write(reflectable.number, "number", handler);
+    write(reflectable.number2, "number2", handler);
+    write(reflectable.numbers, "numbers", handler);
+    write(reflectable.text, "text", handler);
+    write(reflectable.boolean, "boolean", handler);
+    write(reflectable.someMap, "someMap", handler);
+    write(reflectable.someHash, "someHash", handler);
+    write(reflectable.someMultimap, "someMultimap", handler);
+    write(reflectable.someMultiHash, "someMultiHash", handler);
+    write(reflectable.someSet, "someSet", handler);
+    write(reflectable.someMultiset, "someMultiset", handler);
+    write(reflectable.someUnorderedSet, "someUnorderedSet", handler);
+    write(reflectable.someUnorderedMultiset, "someUnorderedMultiset", handler);
+    write(reflectable.someVariant, "someVariant", handler);
+    write(reflectable.anotherVariant, "anotherVariant", handler);
+    write(reflectable.yetAnotherVariant, "yetAnotherVariant", handler);
+    return 16;
+}
+
+template <>
+template <typename Handler>
+inline SizeType CustomTypeWriter<NestingObject>::writeMembers(const NestingObject &reflectable, Handler &handler)
+{
+    write(reflectable.name, JsonMemberKeys<NestingObject>::name, handler);
+    write(reflectable.testObj, JsonMemberKeys<NestingObject>::testObj, handler);
+    return 2;
+}
+
+template <>
+template <typename Handler>
+inline SizeType CustomTypeWriter<NestingArray>::writeMembers(const NestingArray &reflectable, Handler &handler)
+{
+    write(reflectable.name, JsonMemberKeys<NestingArray>::name, handler);
+    write(reflectable.testObjects, JsonMemberKeys<NestingArray>::testObjects, handler);
+    return 2;
 }
 
 template <>
@@ -168,6 +254,60 @@ inline void pull<NestingArray>(NestingArray &reflectable, const GenericValue<UTF
     }
 }
 
+template <> struct CustomTypeReader<TestObject> {
+    static constexpr bool isSupported = true;
+    static constexpr const char *record = "TestObject";
+    static bool readMember(TestObject &reflectable, const char *name, SizeType, JsonReaderSlot &slot)
+    {
+        const auto member = [name, &slot](auto &value, const char *memberName) {
+            if (strcmp(name, memberName)) {
+                return false;
+            }
+            slot = JsonReaderSlot::of(value, memberName);
+            return true;
+        };
+        return member(reflectable.number, "number") || member(reflectable.number2, "number2") || member(reflectable.numbers, "numbers")
+            || member(reflectable.text, "text") || member(reflectable.boolean, "boolean") || member(reflectable.someMap, "someMap")
+            || member(reflectable.someHash, "someHash") || member(reflectable.someMultimap, "someMultimap")
+            || member(reflectable.someMultiHash, "someMultiHash") || member(reflectable.someSet, "someSet")
+            || member(reflectable.someMultiset, "someMultiset") || member(reflectable.someUnorderedSet, "someUnorderedSet")
+            || member(reflectable.someUnorderedMultiset, "someUnorderedMultiset") || member(reflectable.someVariant, "someVariant")
+            || member(reflectable.anotherVariant, "anotherVariant") || member(reflectable.yetAnotherVariant, "yetAnotherVariant");
+    }
+};
+
+template <> struct CustomTypeReader<NestingObject> {
+    static constexpr bool isSupported = true;
+    static constexpr const char *record = "NestingObject";
+    static bool readMember(NestingObject &reflectable, const char *name, SizeType, JsonReaderSlot &slot)
+    {
+        if (!strcmp(name, "name")) {
+            slot = JsonReaderSlot::of(reflectable.name, "name");
+        } else if (!strcmp(name, "testObj")) {
+            slot = JsonReaderSlot::of(reflectable.testObj, "testObj");
+        } else {
+            return false;
+        }
+        return true;
+    }
+};
+
+template <> struct CustomTypeReader<NestingArray> {
+    static constexpr bool isSupported = true;
+    static constexpr const char *record = "NestingArray";
+    static bool readMember(NestingArray &reflectable, const char *name, SizeType, JsonReaderSlot &slot)
+    {
+        if (!strcmp(name, "name")) {
+            slot = JsonReaderSlot::of(reflectable.name, "name");
+        } else if (!strcmp(name, "testObjects")) {
+            slot = JsonReaderSlot::of(reflectable.testObjects, "testObjects");
+        } else {
+            return false;
+        }
+        return true;
+    }
+};
+
 } // namespace JsonReflector
 
 // namespace JsonReflector
@@ -187,6 +327,14 @@ class JsonReflectorTests : public TestFixture {
     CPPUNIT_TEST(testSerializeUniquePtr);
     CPPUNIT_TEST(testSerializeSharedPtr);
     CPPUNIT_TEST(testSerializeOptional);
+    CPPUNIT_TEST(testWritingDirectly);
+    CPPUNIT_TEST(testSerializeMultiMaps);
+    CPPUNIT_TEST(testArithmeticVectors);
+    CPPUNIT_TEST(testCharConvNumbers);
+    CPPUNIT_TEST(testPolicies);
+    CPPUNIT_TEST(testWritingStrings);
+    CPPUNIT_TEST(testWritingMemberKeys);
+    CPPUNIT_TEST(testEstimatingSize);
     CPPUNIT_TEST(testDeserializePrimitives);
     CPPUNIT_TEST(testDeserializeSimpleObjects);
     CPPUNIT_TEST(testDeserializeNestedObjects);
@@ -195,6 +343,12 @@ class JsonReflectorTests : public TestFixture {
     CPPUNIT_TEST(testDeserializeOptional);
     CPPUNIT_TEST(testHandlingParseError);
     CPPUNIT_TEST(testHandlingTypeMismatch);
+    CPPUNIT_TEST(testReadingIncrementally);
+    CPPUNIT_TEST(testReusingContext);
+    CPPUNIT_TEST(testDeserializeInsitu);
+    CPPUNIT_TEST(testSerializeToSink);
+    CPPUNIT_TEST(testJsonLines);
+    CPPUNIT_TEST(testDeserializeInParallel);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -208,6 +362,14 @@ public:
     void testSerializeUniquePtr();
     void testSerializeSharedPtr();
     void testSerializeOptional();
+    void testWritingDirectly();
+    void testSerializeMultiMaps();
+    void testArithmeticVectors();
+    void testCharConvNumbers();
+    void testPolicies();
+    void testWritingStrings();
+    void testWritingMemberKeys();
+    void testEstimatingSize();
     void testDeserializePrimitives();
     void testDeserializeSimpleObjects();
     void testDeserializeNestedObjects();
@@ -216,6 +378,12 @@ public:
     void testDeserializeOptional();
     void testHandlingParseError();
     void testHandlingTypeMismatch();
+    void testReadingIncrementally();
+    void testReusingContext();
+    void testDeserializeInsitu();
+    void testSerializeToSink();
+    void testJsonLines();
+    void testDeserializeInParallel();
 
 private:
 };
@@ -405,6 +573,52 @@ void JsonReflectorTests::testSerializeOptional()
     CPPUNIT_ASSERT_EQUAL("[\"foo\",null]"s, std::string(strbuf.GetString()));
 }
 
+/*!
+ * \brief Tests writing directly to a RapidJSON handler without building a DOM.
+ * \remarks The output must be the same as when pushing to a DOM and serializing it afterwards.
+ */
+void JsonReflectorTests::testWritingDirectly()
+{
+    auto obj = make_unique<TestObject>();
+    obj->number = 42;
+    obj->number2 = 3.141592653589793;
+    obj->text = "bar";
+    obj->boolean = true;
+    obj->someMultimap = { { "a", 1 }, { "b", 2 }, { "a", 3 } };
+    obj->yetAnotherVariant = 42;
+    const auto reflectable = make_tuple("foo"s, static_cast<const char *>(nullptr), SomeEnumClass::Item3, static_cast<std::uint8_t>(255),
+        vector<double>{ 12.5, 413.0 }, map<string, int>{ { "a", 1 } }, make_pair(false, optional<int>()), std::move(obj));
+
+    StringBuffer strbuf;
+    Writer<StringBuffer> jsonWriter(strbuf);
+    JsonReflector::write(reflectable, jsonWriter);
+    const string expectedJson(
+        "[\"foo\",null,2,255,[12.5,413.0],{\"a\":1},[false,null],{\"number\":42,\"number2\":3.141592653589793,\"numbers\":[],\"text\":\"bar\",\"boolean\":true,\"someMap\":{},\"someHash\":{},\"someMultimap\":{\"a\":[1,3],\"b\":[2]},\"someMultiHash\":{},\"someSet\":[],\"someMultiset\":[],\"someUnorderedSet\":[],\"someUnorderedMultiset\":[],\"someVariant\":{\"index\":0,\"data\":null},\"anotherVariant\":{\"index\":0,\"data\":\"\"},\"yetAnotherVariant\":{\"index\":1,\"data\":42}}]");
+    CPPUNIT_ASSERT_EQUAL(expectedJson, string(strbuf.GetString()));
+
+    Document doc(kArrayType);
+    Document::Array array(doc.GetArray());
+    JsonReflector::push(reflectable, array, doc.GetAllocator());
+    CPPUNIT_ASSERT_EQUAL("[" + expectedJson + "]", string(JsonReflector::serializeJsonDocToString(doc).GetString()));
+
+    // the document itself is a handler as well
+    Document docFromHandler;
+    auto generator = [&reflectable](Document &handler) {
+        JsonReflector::write(reflectable, handler);
+        return true;
+    };
+    docFromHandler.Populate(generator);
+    CPPUNIT_ASSERT_EQUAL(expectedJson, string(JsonReflector::serializeJsonDocToString(docFromHandler).GetString()));
+
+    // custom types with only hand-written push() functions are written via an intermediate document
+    auto pushOnly = PushOnlyObject();
+    pushOnly.number = 5;
+    pushOnly.text = "foo";
+    const auto expectedPushOnlyJson = "{\"number\":5,\"text\":\"foo\"}"s;
+    CPPUNIT_ASSERT_EQUAL(expectedPushOnlyJson, string(pushOnly.toJson().GetString()));
+    CPPUNIT_ASSERT(JsonReflector::estimateJsonSize(pushOnly) >= expectedPushOnlyJson.size());
+}
+
 /*!
  * \brief Tests deserializing strings, numbers (int, float, double) and boolean.
  */
@@ -709,3 +923,607 @@ void JsonReflectorTests::testHandlingTypeMismatch()
     errors.throwOn = JsonDeserializationErrors::ThrowOn::TypeMismatch;
     CPPUNIT_ASSERT_THROW(NestingObject::fromJson("{\"name\":[],\"testObj\":\"this is not an object\"}", &errors), JsonDeserializationError);
 }
+
+/*!
+ * \brief Tests deserializing via RapidJSON's SAX API without building a DOM.
+ * \remarks The results and errors must be the same as when pulling from a DOM.
+ */
+void JsonReflectorTests::testReadingIncrementally()
+{
+    const auto testObjJson = "{\"number\":42,\"number2\":3.141592653589793,\"numbers\":[1,2,3,4],\"text\":\"test\",\"boolean\":"
+                             "false,\"someMap\":{\"a\":1,\"b\":2},\"someHash\":{\"c\":true,\"d\":false},\"someMultimap\":{\"a\":[1,2],\"b\":[3]},"
+                             "\"someMultiHash\":{\"a\":[4,5],\"b\":[6]},\"someSet\":[\"a\",\"b\"],\"someMultiset\":[\"a\",\"a\"],"
+                             "\"someUnorderedSet\":[\"a\",\"b\"],\"someUnorderedMultiset\":[\"a\",\"a\"],\"unknown\":{\"foo\":[1,{}]},"
+                             "\"someVariant\":{\"index\":0,\"data\":null},\"anotherVariant\":{\"index\":0,\"data\":\"foo\"},"
+                             "\"yetAnotherVariant\":{\"index\":1,\"data\":42}}"s;
+    JsonDeserializationErrors errors;
+    const auto testObj = JsonReflector::fromJsonSax<TestObject>(testObjJson, &errors);
+    CPPUNIT_ASSERT_EQUAL(0_st, errors.size());
+    CPPUNIT_ASSERT_EQUAL(42, testObj.number);
+    CPPUNIT_ASSERT_EQUAL(3.141592653589793, testObj.number2);
+    CPPUNIT_ASSERT_EQUAL(vector<int>({ 1, 2, 3, 4 }), testObj.numbers);
+    CPPUNIT_ASSERT_EQUAL("test"s, testObj.text);
+    CPPUNIT_ASSERT_EQUAL(false, testObj.boolean);
+    const map<string, int> expectedMap{ { "a", 1 }, { "b", 2 } };
+    CPPUNIT_ASSERT_EQUAL(expectedMap, testObj.someMap);
+    const unordered_map<string, bool> expectedHash{ { "c", true }, { "d", false } };
+    CPPUNIT_ASSERT_EQUAL(expectedHash, testObj.someHash);
+    const multimap<string, int> expectedMultiMap{ { "a", 1 }, { "a", 2 }, { "b", 3 } };
+    CPPUNIT_ASSERT_EQUAL(expectedMultiMap, testObj.someMultimap);
+    CPPUNIT_ASSERT_EQUAL(set<string>({ "a", "b" }), testObj.someSet);
+    CPPUNIT_ASSERT_EQUAL(multiset<string>({ "a", "a" }), testObj.someMultiset);
+    CPPUNIT_ASSERT_EQUAL(0_st, testObj.someVariant.index());
+    CPPUNIT_ASSERT_EQUAL("foo"s, std::get<0>(testObj.anotherVariant));
+    CPPUNIT_ASSERT_EQUAL(42, std::get<1>(testObj.yetAnotherVariant));
+
+    const auto optionalObjects = JsonReflector::fromJsonSax<vector<optional<TestObject>>>("[null,{\"number\":43}]"s, &errors);
+    CPPUNIT_ASSERT_EQUAL(0_st, errors.size());
+    CPPUNIT_ASSERT_EQUAL(2_st, optionalObjects.size());
+    CPPUNIT_ASSERT(!optionalObjects[0].has_value());
+    CPPUNIT_ASSERT_EQUAL(43, optionalObjects[1]->number);
+
+    // errors are supposed to be reported in the same way as when pulling from a DOM
+    const auto invalidJson = "{\"name\":\"nesting2\",\"testObjects\":[25,{\"number\":42,\"number2\":3.141592653589793,"
+                             "\"numbers\":[1,2,3,4],\"text\":\"test\",\"boolean\":false,\"someSet\":[\"a\",\"a\"]},\"foo\",{\"number\":43,"
+                             "\"number2\":3.141592653589793,\"numbers\":[1,2,3,4,\"bar\"],\"text\":[],\"boolean\":false}]}"s;
+    JsonDeserializationErrors errorsFromDom;
+    const auto nestingArrayFromDom = NestingArray::fromJson(invalidJson, &errorsFromDom);
+    const auto nestingArray = JsonReflector::fromJsonSax<NestingArray>(invalidJson, &errors);
+    CPPUNIT_ASSERT_EQUAL(5_st, errorsFromDom.size());
+    CPPUNIT_ASSERT_EQUAL(errorsFromDom.size(), errors.size());
+    const auto optionalString = [](const char *str) { return str ? string(str) : string(); };
+    for (auto i = 0_st; i != errors.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(errorsFromDom[i].kind, errors[i].kind);
+        CPPUNIT_ASSERT_EQUAL(errorsFromDom[i].expectedType, errors[i].expectedType);
+        CPPUNIT_ASSERT_EQUAL(errorsFromDom[i].actualType, errors[i].actualType);
+        CPPUNIT_ASSERT_EQUAL(optionalString(errorsFromDom[i].record), optionalString(errors[i].record));
+        CPPUNIT_ASSERT_EQUAL(optionalString(errorsFromDom[i].member), optionalString(errors[i].member));
+        CPPUNIT_ASSERT_EQUAL(errorsFromDom[i].index, errors[i].index);
+    }
+    CPPUNIT_ASSERT_EQUAL("[document]"s, string(errors.currentRecord));
+    CPPUNIT_ASSERT(!errors.currentMember);
+    CPPUNIT_ASSERT_EQUAL(nestingArrayFromDom.testObjects.size(), nestingArray.testObjects.size());
+    CPPUNIT_ASSERT_EQUAL(nestingArrayFromDom.testObjects.back().numbers, nestingArray.testObjects.back().numbers);
+    errors.clear();
+
+    CPPUNIT_ASSERT_THROW(JsonReflector::fromJsonSax<NestingArray>("{\"name\":nesting2\"}"s, &errors), RAPIDJSON_NAMESPACE::ParseResult);
+}
+
+/*!
+ * \brief Tests (de)serializing multiple times using the same JsonSerializationContext.
+ */
+void JsonReflectorTests::testReusingContext()
+{
+    NestingArray nestingArray;
+    nestingArray.name = "nesting2";
+    nestingArray.testObjects.resize(25);
+    for (auto i = 0; i != 25; ++i) {
+        nestingArray.testObjects[static_cast<size_t>(i)].number = i;
+        nestingArray.testObjects[static_cast<size_t>(i)].numbers = { 1, 2, 3, i };
+        nestingArray.testObjects[static_cast<size_t>(i)].text = "test";
+    }
+    const auto expectedJson = string(nestingArray.toJson().GetString());
+
+    // serialize into context, a small capacity is supposed to be increased as needed when deserializing
+    JsonSerializationContext context(1024);
+    CPPUNIT_ASSERT_EQUAL(1024_st, context.capacity());
+    for (auto i = 0; i != 3; ++i) {
+        const auto &buffer = nestingArray.toJson(context);
+        CPPUNIT_ASSERT_EQUAL(expectedJson, string(buffer.GetString(), buffer.GetSize()));
+        const auto deserialized = NestingArray::fromJson(buffer.GetString(), buffer.GetSize(), context);
+        CPPUNIT_ASSERT_EQUAL(nestingArray.name, deserialized.name);
+        CPPUNIT_ASSERT_EQUAL(25_st, deserialized.testObjects.size());
+        CPPUNIT_ASSERT_EQUAL(24, deserialized.testObjects.back().number);
+        CPPUNIT_ASSERT_EQUAL(vector<int>({ 1, 2, 3, 24 }), deserialized.testObjects.back().numbers);
+        CPPUNIT_ASSERT(context.document().IsObject());
+    }
+    CPPUNIT_ASSERT(context.capacity() > 1024_st);
+    const auto capacity = context.capacity();
+    context.reset();
+    CPPUNIT_ASSERT_EQUAL(capacity, context.capacity());
+    CPPUNIT_ASSERT_EQUAL(0_st, context.output().GetSize());
+
+    // deserialize other types and handle errors
+    JsonDeserializationErrors errors;
+    CPPUNIT_ASSERT_EQUAL(vector<int>({ 1, 2, 3 }), JsonReflector::fromJson<vector<int>>("[1,2,3]"s, context, &errors));
+    CPPUNIT_ASSERT_EQUAL("foo"s, JsonReflector::fromJson<string>("\"foo\""s, context, &errors));
+    CPPUNIT_ASSERT_EQUAL(0_st, errors.size());
+    CPPUNIT_ASSERT_EQUAL(0, JsonReflector::fromJson<int>("\"foo\""s, context, &errors));
+    CPPUNIT_ASSERT_EQUAL(1_st, errors.size());
+    CPPUNIT_ASSERT_EQUAL(JsonDeserializationErrorKind::TypeMismatch, errors.front().kind);
+    CPPUNIT_ASSERT_THROW(JsonReflector::fromJson<int>("[1,"s, context), RAPIDJSON_NAMESPACE::ParseResult);
+
+    // serialize into caller-provided string
+    string output("previous contents");
+    nestingArray.toJson(output);
+    CPPUNIT_ASSERT_EQUAL(expectedJson, output);
+    JsonReflector::toJson(vector<int>({ 1, 2, 3 }), output);
+    CPPUNIT_ASSERT_EQUAL("[1,2,3]"s, output);
+}
+
+/*!
+ * \brief Tests deserializing a mutable buffer in-situ.
+ */
+void JsonReflectorTests::testDeserializeInsitu()
+{
+    auto json = "{\"name\":\"nesting\",\"testObj\":{\"number\":42,\"numbers\":[1,2,3],\"text\":\"t\\u0000e\\\"st\",\"someMap\":{\"a\\u0000b\":1}}}"s;
+    const auto expected = NestingObject::fromJson(json);
+    const auto nestingObj = NestingObject::fromJsonInsitu(json);
+    CPPUNIT_ASSERT_EQUAL("nesting"s, nestingObj.name);
+    CPPUNIT_ASSERT_EQUAL(42, nestingObj.testObj.number);
+    CPPUNIT_ASSERT_EQUAL(vector<int>({ 1, 2, 3 }), nestingObj.testObj.numbers);
+    CPPUNIT_ASSERT_EQUAL(expected.testObj.text, nestingObj.testObj.text);
+    CPPUNIT_ASSERT_EQUAL("t\0e\"st"s, nestingObj.testObj.text);
+    CPPUNIT_ASSERT_EQUAL(1_st, nestingObj.testObj.someMap.count("a\0b"s));
+
+    // the buffer does not need to be null-terminated
+    char buffer[] = "[\"foo\",\"bar\"]garbage";
+    CPPUNIT_ASSERT_EQUAL(vector<string>({ "foo", "bar" }), JsonReflector::fromJsonInsitu<vector<string>>(buffer, 13));
+    char stringBuffer[] = "\"foo\"";
+    CPPUNIT_ASSERT_EQUAL("foo"s, JsonReflector::fromJsonInsitu<string>(stringBuffer, 5));
+
+    JsonSerializationContext context;
+    JsonDeserializationErrors errors;
+    char intBuffer[] = "\"42\"";
+    CPPUNIT_ASSERT_EQUAL(0, JsonReflector::fromJsonInsitu<int>(intBuffer, 4, context, &errors));
+    CPPUNIT_ASSERT_EQUAL(1_st, errors.size());
+    char invalidBuffer[] = "[1,";
+    CPPUNIT_ASSERT_THROW(JsonReflector::fromJsonInsitu<vector<int>>(invalidBuffer, 3, context), RAPIDJSON_NAMESPACE::ParseResult);
+}
+
+/*!
+ * \brief Tests serializing to sinks which write the output chunk-wise.
+ */
+void JsonReflectorTests::testSerializeToSink()
+{
+    NestingArray nestingArray;
+    nestingArray.name = "nesting2";
+    nestingArray.testObjects.resize(10);
+    for (auto &testObj : nestingArray.testObjects) {
+        testObj.text = "some text which needs to be \"escaped\"";
+    }
+    const auto expectedJson = string(nestingArray.toJson().GetString());
+
+    // pass output to callback using a small buffer
+    string output;
+    auto chunks = 0_st;
+    JsonCallbackSink callbackSink(
+        [&](const char *chunk, std::size_t size) {
+            CPPUNIT_ASSERT(size <= 16);
+            output.append(chunk, size);
+            ++chunks;
+        },
+        16);
+    nestingArray.toJson(callbackSink);
+    CPPUNIT_ASSERT_EQUAL(expectedJson, output);
+    CPPUNIT_ASSERT_EQUAL((expectedJson.size() + 15) / 16, chunks);
+    CPPUNIT_ASSERT_EQUAL(expectedJson.size(), callbackSink.bytesWritten());
+
+    // write to std::ostream
+    stringstream stream;
+    nestingArray.toJson(stream);
+    JsonReflector::toJson(vector<int>({ 1, 2, 3 }), stream);
+    CPPUNIT_ASSERT_EQUAL(expectedJson + "[1,2,3]", stream.str());
+
+#ifdef PLATFORM_UNIX
+    // write to file descriptor
+    const auto file = unique_ptr<FILE, decltype(&fclose)>(tmpfile(), &fclose);
+    CPPUNIT_ASSERT(file);
+    JsonFileDescriptorSink fdSink(fileno(file.get()), 100);
+    nestingArray.toJson(fdSink);
+    rewind(file.get());
+    string fileContents(expectedJson.size() + 1, '\0');
+    fileContents.resize(fread(fileContents.data(), 1, fileContents.size(), file.get()));
+    CPPUNIT_ASSERT_EQUAL(expectedJson, fileContents);
+#endif
+}
+
+/*!
+ * \brief Tests writing and reading records in the JSON Lines format.
+ */
+void JsonReflectorTests::testJsonLines()
+{
+    vector<TestObject> records(3);
+    for (auto i = 0; i != 3; ++i) {
+        records[static_cast<size_t>(i)].number = i;
+        records[static_cast<size_t>(i)].text = "record\n" + numberToString(i);
+    }
+
+    // write records
+    stringstream stream;
+    {
+        JsonLinesWriter<TestObject> writer(stream);
+        for (const auto &record : records) {
+            writer.write(record);
+        }
+        CPPUNIT_ASSERT_EQUAL(3_st, writer.recordsWritten());
+    }
+    auto expectedOutput = string();
+    for (const auto &record : records) {
+        expectedOutput += record.toJson().GetString();
+        expectedOutput += '\n';
+    }
+    CPPUNIT_ASSERT_EQUAL(expectedOutput, stream.str());
+
+    // read records from stream via iterator
+    auto index = 0_st;
+    for (const auto &record : JsonLinesReader<TestObject>(stream)) {
+        CPPUNIT_ASSERT_EQUAL(records[index].number, record.number);
+        CPPUNIT_ASSERT_EQUAL(records[index].text, record.text);
+        ++index;
+    }
+    CPPUNIT_ASSERT_EQUAL(3_st, index);
+
+    // read records from buffer, skip blank lines and annotate errors with line number
+    const auto lines = "{\"number\":1}\n\r\n  \n{\"number\":\"2\"}\r\n{\"number\":3,\n{\"number\":4}"s;
+    JsonDeserializationErrors errors;
+    JsonLinesReader<TestObject> reader(lines.data(), lines.size(), &errors);
+    TestObject record;
+    CPPUNIT_ASSERT(reader.read(record));
+    CPPUNIT_ASSERT_EQUAL(1, record.number);
+    CPPUNIT_ASSERT_EQUAL(1_st, reader.lineNumber());
+    CPPUNIT_ASSERT(reader.read(record));
+    CPPUNIT_ASSERT_EQUAL(4_st, reader.lineNumber());
+    CPPUNIT_ASSERT_EQUAL(1_st, errors.size());
+    CPPUNIT_ASSERT_EQUAL(JsonDeserializationErrorKind::TypeMismatch, errors.front().kind);
+    CPPUNIT_ASSERT_EQUAL("number"s, string(errors.front().member));
+    CPPUNIT_ASSERT_EQUAL(4_st, errors.front().line);
+    CPPUNIT_ASSERT_EQUAL(JsonDeserializationError::noIndex, errors.currentLine);
+    CPPUNIT_ASSERT_EQUAL("type mismatch within record \"TestObject\" and member \"number\" (in line 4): expected \"number\", got \"string\""s,
+        formatJsonDeserializationError(errors.front()));
+    CPPUNIT_ASSERT_THROW(reader.read(record), RAPIDJSON_NAMESPACE::ParseResult);
+    CPPUNIT_ASSERT_EQUAL(5_st, reader.lineNumber());
+    CPPUNIT_ASSERT(reader.read(record));
+    CPPUNIT_ASSERT_EQUAL(4, record.number);
+    CPPUNIT_ASSERT(!reader.read(record));
+    CPPUNIT_ASSERT_EQUAL(3_st, reader.recordsRead());
+
+    // clear the line number also if the error is thrown
+    errors.clear();
+    errors.throwOn = JsonDeserializationErrors::ThrowOn::TypeMismatch;
+    JsonLinesReader<TestObject> throwingReader(lines.data(), lines.size(), &errors);
+    CPPUNIT_ASSERT(throwingReader.read(record));
+    CPPUNIT_ASSERT_THROW(throwingReader.read(record), JsonDeserializationError);
+    CPPUNIT_ASSERT_EQUAL(4_st, errors.front().line);
+    CPPUNIT_ASSERT_EQUAL(JsonDeserializationError::noIndex, errors.currentLine);
+}
+
+/*!
+ * \brief Tests deserializing JSON Lines and JSON arrays using multiple threads.
+ */
+void JsonReflectorTests::testDeserializeInParallel()
+{
+    // create JSON Lines and an equivalent JSON array with some type mismatches
+    auto lines = string(), array = string("[\n");
+    for (auto i = 0; i != 1000; ++i) {
+        const auto record = i % 100 == 5 ? "{\"number\":\"" % numberToString(i) + "\",\"text\":\"[\\\"],{\"}"
+                                         : "{\"number\":" % numberToString(i) % ",\"numbers\":[" % numberToString(i) + "],\"text\":\"[\\\"],{\"}";
+        lines += record + (i % 10 ? "\n" : "\n\n");
+        array += (i ? ",\n " : " ") + record;
+    }
+    array += "\n]";
+
+    JsonDeserializationErrors errors;
+    const auto records = JsonReflector::fromJsonLinesParallel<TestObject>(lines, 4, &errors);
+    CPPUNIT_ASSERT_EQUAL(1000_st, records.size());
+    for (auto i = 0; i != 1000; ++i) {
+        const auto &record = records[static_cast<size_t>(i)];
+        CPPUNIT_ASSERT_EQUAL(i % 100 == 5 ? 0 : i, record.number);
+        CPPUNIT_ASSERT_EQUAL("[\"],{"s, record.text);
+    }
+    CPPUNIT_ASSERT_EQUAL(10_st, errors.size());
+    CPPUNIT_ASSERT_EQUAL(7_st, errors.front().line); // line of record 5 considering the additional blank line after record 0
+    CPPUNIT_ASSERT_EQUAL(JsonDeserializationError::noIndex, errors.front().index);
+    CPPUNIT_ASSERT_EQUAL(997_st, errors.back().line); // line of record 905 considering 91 additional blank lines
+    errors.clear();
+
+    const auto arrayRecords = JsonReflector::fromJsonArrayParallel<vector<TestObject>>(array, 3, &errors);
+    const auto serialArrayRecords = JsonReflector::fromJson<vector<TestObject>>(array);
+    CPPUNIT_ASSERT_EQUAL(1000_st, arrayRecords.size());
+    for (auto i = 0_st; i != 1000; ++i) {
+        CPPUNIT_ASSERT_EQUAL(serialArrayRecords[i].number, arrayRecords[i].number);
+        CPPUNIT_ASSERT_EQUAL(serialArrayRecords[i].numbers, arrayRecords[i].numbers);
+        CPPUNIT_ASSERT_EQUAL(serialArrayRecords[i].text, arrayRecords[i].text);
+    }
+    CPPUNIT_ASSERT_EQUAL(10_st, errors.size());
+    CPPUNIT_ASSERT_EQUAL(5_st, errors.front().index);
+    CPPUNIT_ASSERT_EQUAL(905_st, errors.back().index);
+    CPPUNIT_ASSERT_EQUAL(JsonDeserializationError::noIndex, errors.currentIndex);
+    errors.clear();
+
+    // handle edge cases
+    CPPUNIT_ASSERT_EQUAL(0_st, JsonReflector::fromJsonArrayParallel<vector<TestObject>>(" [ ] "s).size());
+    CPPUNIT_ASSERT_EQUAL(vector<int>({ 1, 2, 3 }), JsonReflector::fromJsonArrayParallel<vector<int>>("[1, 2 ,3]"s, 2));
+    CPPUNIT_ASSERT_EQUAL(0_st, JsonReflector::fromJsonArrayParallel<vector<int>>("{}"s, 2, &errors).size());
+    CPPUNIT_ASSERT_EQUAL(1_st, errors.size());
+    CPPUNIT_ASSERT_EQUAL(JsonDeserializationErrorKind::TypeMismatch, errors.front().kind);
+    CPPUNIT_ASSERT_THROW(JsonReflector::fromJsonArrayParallel<vector<int>>("[1,2"s), RAPIDJSON_NAMESPACE::ParseResult);
+    CPPUNIT_ASSERT_THROW(JsonReflector::fromJsonArrayParallel<vector<int>>("[1,,2]"s), RAPIDJSON_NAMESPACE::ParseResult);
+    CPPUNIT_ASSERT_THROW(JsonReflector::fromJsonArrayParallel<vector<int>>("[1,2] 3"s), RAPIDJSON_NAMESPACE::ParseResult);
+    for (const auto &malformedArray : { "[1}"s, "[{]}"s, "[[}]"s, "[{\"a\":1}"s, "[1,2]}"s }) {
+        CPPUNIT_ASSERT_THROW(JsonReflector::fromJsonArrayParallel<vector<int>>(malformedArray, 2), RAPIDJSON_NAMESPACE::ParseResult);
+    }
+    try {
+        JsonReflector::fromJsonArrayParallel<vector<int>>("[1,2}"s, 2);
+        CPPUNIT_FAIL("mismatching bracket not detected");
+    } catch (const RAPIDJSON_NAMESPACE::ParseResult &parseResult) {
+        CPPUNIT_ASSERT_EQUAL(RAPIDJSON_NAMESPACE::kParseErrorArrayMissCommaOrSquareBracket, parseResult.Code());
+        CPPUNIT_ASSERT_EQUAL(4_st, parseResult.Offset());
+    }
+    try {
+        JsonReflector::fromJsonLinesParallel<TestObject>("{}\n{}\n{\"number\":}\n"s, 2);
+        CPPUNIT_FAIL("parse error not detected");
+    } catch (const RAPIDJSON_NAMESPACE::ParseResult &parseResult) {
+        CPPUNIT_ASSERT_EQUAL(RAPIDJSON_NAMESPACE::kParseErrorValueInvalid, parseResult.Code());
+        CPPUNIT_ASSERT_EQUAL(16_st, parseResult.Offset());
+    }
+}
+
+/*!
+ * \brief Tests serializing multimaps with many distinct keys.
+ */
+void JsonReflectorTests::testSerializeMultiMaps()
+{
+    multimap<string, int> multiMap;
+    unordered_multimap<string, int> multiHash;
+    for (auto i = 0; i != 1000; ++i) {
+        const auto key = "key" + numberToString(i % 250);
+        multiMap.emplace(key, i);
+        multiHash.emplace(key, i);
+    }
+
+    // pushing and writing directly are supposed to produce the same output
+    auto doc = JsonReflector::toJsonDocument(multiMap);
+    CPPUNIT_ASSERT_EQUAL(250u, doc.MemberCount());
+    CPPUNIT_ASSERT_EQUAL(4u, doc["key42"].Size());
+    CPPUNIT_ASSERT_EQUAL(292, doc["key42"][1].GetInt());
+    CPPUNIT_ASSERT_EQUAL(string(JsonReflector::toJson(multiMap).GetString()), string(JsonReflector::serializeJsonDocToString(doc).GetString()));
+    doc = JsonReflector::toJsonDocument(multiHash);
+    CPPUNIT_ASSERT_EQUAL(250u, doc.MemberCount());
+    CPPUNIT_ASSERT_EQUAL(4u, doc["key42"].Size());
+    CPPUNIT_ASSERT_EQUAL(string(JsonReflector::toJson(multiHash).GetString()), string(JsonReflector::serializeJsonDocToString(doc).GetString()));
+
+    // equivalent keys are grouped in the order of their first occurrence if they are not adjacent
+    UnsortedMultiMap unsortedMultiMap;
+    unsortedMultiMap.emplace_back("b", 1);
+    unsortedMultiMap.emplace_back("a", 2);
+    unsortedMultiMap.emplace_back("b", 3);
+    doc = JsonReflector::toJsonDocument(unsortedMultiMap);
+    CPPUNIT_ASSERT_EQUAL("{\"b\":[1,3],\"a\":[2]}"s, string(JsonReflector::serializeJsonDocToString(doc).GetString()));
+    CPPUNIT_ASSERT_EQUAL("{\"b\":[1,3],\"a\":[2]}"s, string(JsonReflector::toJson(unsortedMultiMap).GetString()));
+}
+
+/*!
+ * \brief Tests whether the fast path for vectors of numbers behaves like the generic path (here used via std::list).
+ */
+void JsonReflectorTests::testArithmeticVectors()
+{
+    // pushing is supposed to produce the same output as the generic path and as writing directly
+    const auto doubles = vector<double>{ 1.5, -2.0, 3.141592653589793, 1e300 };
+    const auto int64s = vector<int64_t>{ -1, 0, numeric_limits<int64_t>::min(), numeric_limits<int64_t>::max() };
+    const auto uint8s = vector<uint8_t>{ 0, 1, 255 };
+    const auto floats = vector<float>{ 0.5f, -1.25f };
+    const auto expectedDoubles = string(JsonReflector::toJson(list<double>(doubles.begin(), doubles.end())).GetString());
+    const auto expectedInt64s = string(JsonReflector::toJson(list<int64_t>(int64s.begin(), int64s.end())).GetString());
+    CPPUNIT_ASSERT_EQUAL(expectedDoubles, string(JsonReflector::serializeJsonDocToString(JsonReflector::toJsonDocument(doubles)).GetString()));
+    CPPUNIT_ASSERT_EQUAL(expectedInt64s, string(JsonReflector::serializeJsonDocToString(JsonReflector::toJsonDocument(int64s)).GetString()));
+    CPPUNIT_ASSERT_EQUAL("[0,1,255]"s, string(JsonReflector::serializeJsonDocToString(JsonReflector::toJsonDocument(uint8s)).GetString()));
+    CPPUNIT_ASSERT_EQUAL("[0.5,-1.25]"s, string(JsonReflector::serializeJsonDocToString(JsonReflector::toJsonDocument(floats)).GetString()));
+
+    // pulling is supposed to round-trip
+    CPPUNIT_ASSERT_EQUAL(doubles, JsonReflector::fromJson<vector<double>>(expectedDoubles));
+    CPPUNIT_ASSERT_EQUAL(int64s, JsonReflector::fromJson<vector<int64_t>>(expectedInt64s));
+    CPPUNIT_ASSERT_EQUAL(uint8s, JsonReflector::fromJson<vector<uint8_t>>("[0,1,255]"));
+    CPPUNIT_ASSERT_EQUAL(floats, JsonReflector::fromJson<vector<float>>("[0.5,-1.25]"));
+
+    // conversions and errors are supposed to be handled like in the generic path
+    const auto json = "[1,2.5,\"3\",4,null]"s;
+    JsonDeserializationErrors errors, genericErrors;
+    const auto ints = JsonReflector::fromJson<vector<int>>(json, &errors);
+    const auto genericInts = JsonReflector::fromJson<list<int>>(json, &genericErrors);
+    CPPUNIT_ASSERT_EQUAL((vector<int>{ 1, 2, 0, 4, 0 }), ints);
+    CPPUNIT_ASSERT_EQUAL(vector<int>(genericInts.begin(), genericInts.end()), ints);
+    CPPUNIT_ASSERT_EQUAL(2_st, errors.size());
+    CPPUNIT_ASSERT_EQUAL(genericErrors.size(), errors.size());
+    for (auto i = 0_st; i != errors.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(genericErrors[i].kind, errors[i].kind);
+        CPPUNIT_ASSERT_EQUAL(genericErrors[i].expectedType, errors[i].expectedType);
+        CPPUNIT_ASSERT_EQUAL(genericErrors[i].actualType, errors[i].actualType);
+        CPPUNIT_ASSERT_EQUAL(genericErrors[i].index, errors[i].index);
+    }
+    CPPUNIT_ASSERT_EQUAL(2_st, errors[0].index);
+    CPPUNIT_ASSERT_EQUAL(JsonType::String, errors[0].actualType);
+    CPPUNIT_ASSERT_EQUAL(4_st, errors[1].index);
+    CPPUNIT_ASSERT_EQUAL(JsonType::Null, errors[1].actualType);
+    CPPUNIT_ASSERT_EQUAL(JsonDeserializationError::noIndex, errors.currentIndex);
+}
+
+/*!
+ * \brief Tests formatting and parsing numbers via std::to_chars/std::from_chars.
+ */
+void JsonReflectorTests::testCharConvNumbers()
+{
+    // numbers are supposed to be parsed as the same types as RapidJSON would use
+    const auto json = "[1,-2,4294967296,-3000000000,18446744073709551615,0.1,-1.5e-300,2.0,1e300]"s;
+    Document doc(kArrayType), expectedDoc(kArrayType);
+    CPPUNIT_ASSERT(!parseJson<kParseDefaultFlags, JsonNumberBackend::CharConv>(doc, json.data(), json.size()).IsError());
+    CPPUNIT_ASSERT(!parseJson<kParseFullPrecisionFlag, JsonNumberBackend::RapidJson>(expectedDoc, json.data(), json.size()).IsError());
+    CPPUNIT_ASSERT(doc == expectedDoc);
+    CPPUNIT_ASSERT(doc[0].IsUint());
+    CPPUNIT_ASSERT(doc[1].IsInt());
+    CPPUNIT_ASSERT(doc[2].IsUint64() && !doc[2].IsUint());
+    CPPUNIT_ASSERT(doc[3].IsInt64() && !doc[3].IsInt());
+    CPPUNIT_ASSERT(doc[4].IsUint64());
+    CPPUNIT_ASSERT(doc[5].IsDouble());
+    CPPUNIT_ASSERT_EQUAL(0.1, doc[5].GetDouble());
+    CPPUNIT_ASSERT(doc[7].IsDouble());
+
+    // doubles are supposed to be written using the shortest representation which round-trips
+    StringBuffer buffer;
+    CharConvWriter<StringBuffer> writer(buffer);
+    doc.Accept(writer);
+    CPPUNIT_ASSERT_EQUAL("[1,-2,4294967296,-3000000000,18446744073709551615,0.1,-1.5e-300,2.0,1e+300]"s, string(buffer.GetString()));
+
+    // numbers out of range are supposed to lead to the same parse error as with RapidJSON's reader
+    const auto tooBig = "[1, -1e400]"s;
+    const auto charConvRes = parseJson<kParseDefaultFlags, JsonNumberBackend::CharConv>(doc, tooBig.data(), tooBig.size());
+    const auto rapidJsonRes = parseJson<kParseDefaultFlags, JsonNumberBackend::RapidJson>(expectedDoc, tooBig.data(), tooBig.size());
+    CPPUNIT_ASSERT_EQUAL(kParseErrorNumberTooBig, charConvRes.Code());
+    CPPUNIT_ASSERT_EQUAL(rapidJsonRes.Code(), charConvRes.Code());
+    CPPUNIT_ASSERT_EQUAL(rapidJsonRes.Offset(), charConvRes.Offset());
+
+    // numbers too close to zero are supposed to be rounded to zero like RapidJSON's reader does
+    const auto tooSmall = "[1e-400,-0.001e-400]"s;
+    CPPUNIT_ASSERT(!parseJson<kParseDefaultFlags, JsonNumberBackend::CharConv>(doc, tooSmall.data(), tooSmall.size()).IsError());
+    CPPUNIT_ASSERT_EQUAL(0.0, doc[0].GetDouble());
+    CPPUNIT_ASSERT_EQUAL(0.0, doc[1].GetDouble());
+
+    // the format specified for long double is supposed to be used when writing directly and when pushing
+    const auto numbers = vector<long double>{ 3.14159L, 1.0L };
+    CPPUNIT_ASSERT_EQUAL("[3.14,1.00]"s, string(JsonReflector::toJson(numbers).GetString()));
+    CPPUNIT_ASSERT_EQUAL("3.14"s, string(JsonReflector::toJson(3.14159L).GetString()));
+    CPPUNIT_ASSERT_EQUAL("[3.14,1.0]"s, string(JsonReflector::serializeJsonDocToString(JsonReflector::toJsonDocument(numbers)).GetString()));
+    CPPUNIT_ASSERT_EQUAL("3.14"s, string(JsonReflector::serializeJsonDocToString(JsonReflector::toJsonDocument(3.14159L)).GetString()));
+}
+
+/*!
+ * \brief Tests specifying how JSON is parsed and written via JsonPolicy.
+ */
+void JsonReflectorTests::testPolicies()
+{
+    using StopWhenDonePolicy = JsonPolicy<kParseStopWhenDoneFlag>;
+    using ValidatingPolicy = JsonPolicy<kParseValidateEncodingFlag, kWriteValidateEncodingFlag>;
+    using NanAndInfPolicy = JsonPolicy<kParseNanAndInfFlag, kWriteNanAndInfFlag>;
+    using CharConvPolicy = JsonPolicy<kParseDefaultFlags, kWriteDefaultFlags, JsonNumberBackend::CharConv>;
+
+    // trailing data is only accepted when parsing stops after the first value
+    CPPUNIT_ASSERT_THROW(JsonReflector::fromJson<int>("42 43"), RAPIDJSON_NAMESPACE::ParseResult);
+    CPPUNIT_ASSERT_EQUAL(42, (JsonReflector::fromJson<int, StopWhenDonePolicy>("42 43")));
+    NestingArray nestingArray;
+    nestingArray.name = "nesting";
+    const auto json = string(nestingArray.toJson().GetString()) + "\n{}";
+    CPPUNIT_ASSERT_EQUAL("nesting"s, NestingArray::fromJson<StopWhenDonePolicy>(json).name);
+    JsonSerializationContext context;
+    CPPUNIT_ASSERT_EQUAL("nesting"s, NestingArray::fromJson<StopWhenDonePolicy>(json, context).name);
+    auto mutableJson = json;
+    CPPUNIT_ASSERT_EQUAL("nesting"s, NestingArray::fromJsonInsitu<StopWhenDonePolicy>(mutableJson).name);
+    CPPUNIT_ASSERT_EQUAL("nesting"s, (JsonReflector::fromJsonSax<NestingArray, StopWhenDonePolicy>(json).name));
+
+    // the encoding is only validated if requested
+    const auto invalidUtf8 = "\"\xff\""s;
+    CPPUNIT_ASSERT_EQUAL("\xff"s, JsonReflector::fromJson<string>(invalidUtf8));
+    CPPUNIT_ASSERT_THROW((JsonReflector::fromJson<string, ValidatingPolicy>(invalidUtf8)), RAPIDJSON_NAMESPACE::ParseResult);
+
+    // NaN and infinity are only written and read if requested
+    CPPUNIT_ASSERT_EQUAL("NaN"s, string(JsonReflector::toJson<double, NanAndInfPolicy>(numeric_limits<double>::quiet_NaN()).GetString()));
+    CPPUNIT_ASSERT_EQUAL("-Infinity"s, string(JsonReflector::toJson<double, NanAndInfPolicy>(-numeric_limits<double>::infinity()).GetString()));
+    CPPUNIT_ASSERT_THROW(JsonReflector::fromJson<double>("Infinity"), RAPIDJSON_NAMESPACE::ParseResult);
+    CPPUNIT_ASSERT_EQUAL(numeric_limits<double>::infinity(), (JsonReflector::fromJson<double, NanAndInfPolicy>("Infinity")));
+
+    // the number backend is supposed to be taken into account when parsing and serializing documents
+    auto doc = JsonReflector::parseJsonDocFromString<CharConvPolicy>("[0.1,2.0]", 9);
+    CPPUNIT_ASSERT_EQUAL(0.1, doc[0].GetDouble());
+    CPPUNIT_ASSERT_EQUAL("[0.1,2.0]"s, string(JsonReflector::serializeJsonDocToString<CharConvPolicy>(doc).GetString()));
+}
+
+/*!
+ * \brief Tests whether FastStringWriter escapes strings exactly like RapidJSON's writer.
+ */
+void JsonReflectorTests::testWritingStrings()
+{
+    const auto writeStrings = [](auto &writer, const vector<string> &strings) {
+        writer.StartObject();
+        for (const auto &str : strings) {
+            writer.Key(str.data(), static_cast<SizeType>(str.size()));
+            writer.String(str.data(), static_cast<SizeType>(str.size()));
+        }
+        writer.EndObject();
+    };
+
+    // put each character at each position of strings of various lengths to cover the vectorized and the remaining part
+    auto strings = vector<string>{ string(), "plain ASCII log line without any special characters"s, "ÄÖÜ € 𝄞"s };
+    for (auto length = 1_st; length != 40; ++length) {
+        for (auto position = 0_st; position != length; ++position) {
+            for (auto c : { '\0', '\x01', '\b', '\t', '\n', '\f', '\r', '\x1F', ' ', '"', '/', '\\', '\x7F', '\x80', '\xFF' }) {
+                auto &str = strings.emplace_back(length, 'a');
+                str[position] = c;
+            }
+        }
+    }
+    StringBuffer expectedBuffer, buffer;
+    Writer<StringBuffer> expectedWriter(expectedBuffer);
+    FastStringWriter<Writer<StringBuffer>> writer(buffer);
+    writeStrings(expectedWriter, strings);
+    writeStrings(writer, strings);
+    CPPUNIT_ASSERT_EQUAL(string(expectedBuffer.GetString(), expectedBuffer.GetSize()), string(buffer.GetString(), buffer.GetSize()));
+
+    // writing to a sink or std::string is supposed to produce the same output
+    auto output = string();
+    JsonCallbackSink sink([&output](const char *chunk, size_t size) { output.append(chunk, size); }, 7);
+    FastStringWriter<Writer<JsonSink>> sinkWriter(sink);
+    writeStrings(sinkWriter, strings);
+    sink.flush();
+    CPPUNIT_ASSERT_EQUAL(string(expectedBuffer.GetString(), expectedBuffer.GetSize()), output);
+    JsonReflector::toJson(strings, output);
+    CPPUNIT_ASSERT_EQUAL(string(JsonReflector::toJson(strings).GetString()), output);
+}
+
+/*!
+ * \brief Tests writing members via precomputed keys (as emitted by the code generator).
+ */
+void JsonReflectorTests::testWritingMemberKeys()
+{
+    NestingArray nestingArray;
+    nestingArray.name = "nesting";
+    nestingArray.testObjects.emplace_back().number = 5;
+    CPPUNIT_ASSERT_EQUAL(0_st, string(JsonReflector::toJson(nestingArray).GetString()).find("{\"name\":\"nesting\",\"testObjects\":[{\"number\":5,"));
+
+    // keys are written verbatim by JsonWriter and as usual by RapidJSON's writer; both is supposed to produce the same output
+    static constexpr JsonMemberKey escapedKey{ "a\"b\\c\n", "\"a\\\"b\\\\c\\n\"" };
+    const auto writeObject = [&nestingArray](auto &writer) {
+        writer.StartObject();
+        JsonReflector::write(nestingArray.name, JsonMemberKeys<NestingArray>::name, writer);
+        JsonReflector::write(1, escapedKey, writer);
+        writer.EndObject(2);
+    };
+    StringBuffer expectedBuffer, buffer;
+    Writer<StringBuffer> expectedWriter(expectedBuffer);
+    JsonWriter<StringBuffer> writer(buffer);
+    writeObject(expectedWriter);
+    writeObject(writer);
+    CPPUNIT_ASSERT_EQUAL("{\"name\":\"nesting\",\"a\\\"b\\\\c\\n\":1}"s, string(expectedBuffer.GetString()));
+    CPPUNIT_ASSERT_EQUAL(string(expectedBuffer.GetString()), string(buffer.GetString()));
+
+    // the keys are referenced when pushing to a document
+    Document doc(kObjectType);
+    auto object = doc.GetObject();
+    JsonReflector::push(1, escapedKey, object, doc.GetAllocator());
+    CPPUNIT_ASSERT(doc.MemberBegin()->name.GetString() == escapedKey.name);
+    CPPUNIT_ASSERT_EQUAL(escapedKey.length, doc.MemberBegin()->name.GetStringLength());
+}
+
+void JsonReflectorTests::testEstimatingSize()
+{
+    // the estimation is exact except for one additional separator per value and the end of an array/object
+    const auto numbers = vector<int>{ 1, -23, 456, numeric_limits<int>::min() };
+    CPPUNIT_ASSERT_EQUAL("[1,-23,456,-2147483648]"s, string(JsonReflector::toJson(numbers).GetString()));
+    CPPUNIT_ASSERT_EQUAL(23_st + 1 + 1, JsonReflector::estimateJsonSize(numbers));
+    const auto strings = vector<string>{ "foo", "" };
+    CPPUNIT_ASSERT_EQUAL(10_st + 1 + 1, JsonReflector::estimateJsonSize(strings));
+
+    // floating point numbers are assumed to take their maximum size so the estimation is an upper bound here
+    NestingArray nestingArray;
+    nestingArray.name = "nesting";
+    nestingArray.testObjects.emplace_back().number2 = 3.5;
+    const auto json = JsonReflector::toJson(nestingArray);
+    CPPUNIT_ASSERT(JsonReflector::estimateJsonSize(nestingArray) >= json.GetSize());
+
+    // the estimated size is only reserved if enabled by the policy (and for the string overload if there is no capacity yet)
+    using ReservingPolicy = JsonPolicy<kParseDefaultFlags, kWriteDefaultFlags, defaultJsonNumberBackend, true>;
+    const auto reservedJson = JsonReflector::toJson<NestingArray, ReservingPolicy>(nestingArray);
+    CPPUNIT_ASSERT_EQUAL(string(json.GetString(), json.GetSize()), string(reservedJson.GetString(), reservedJson.GetSize()));
+    string output;
+    JsonReflector::toJson<NestingArray, ReservingPolicy>(nestingArray, output);
+    CPPUNIT_ASSERT_EQUAL(string(json.GetString(), json.GetSize()), output);
+    CPPUNIT_ASSERT(output.capacity() >= JsonReflector::estimateJsonSize(nestingArray));
+}